@@ -19,6 +19,8 @@
 #include "ExtentId.h"
 
 #include <boost/filesystem.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/shared_lock_guard.hpp>
 
 #include <youtils/Catchers.h>
 
@@ -33,6 +35,9 @@ namespace fs = boost::filesystem;
 #define LOCK()                                  \
     boost::lock_guard<decltype(lock_)> lg__(lock_)
 
+#define LOCK_SHARED()                           \
+    boost::shared_lock_guard<decltype(lock_)> slg__(lock_)
+
 Container::Container(const ContainerId& cid,
                      std::shared_ptr<ExtentCache>& cache,
                      std::shared_ptr<backend::BackendInterface>& bi)
@@ -113,6 +118,35 @@ Container::new_extent_(const ExtentId& eid)
     return ext;
 }
 
+void
+Container::upload_(const ExtentId& eid,
+                   std::shared_ptr<Extent> ext)
+{
+    if (cache_->write_back())
+    {
+        std::shared_ptr<be::BackendInterface> bi(bi_);
+        cache_->mark_dirty(eid,
+                           std::move(ext),
+                           [bi](const ExtentId& eid,
+                                const fs::path& p)
+                           {
+                               bi->write(p, eid.str(), OverwriteObject::T);
+                           });
+    }
+    else
+    {
+        bi_->write(ext->path, eid.str(), OverwriteObject::T);
+    }
+}
+
+void
+Container::remove_extent_(const ExtentId& eid)
+{
+    cache_->discard(eid);
+    cache_->erase(eid);
+    bi_->remove(eid.str());
+}
+
 std::shared_ptr<Extent>
 Container::find_or_create_extent_(const ExtentId& eid)
 {
@@ -133,7 +167,7 @@ Container::read(off_t off,
                 void* buf,
                 size_t bufsize)
 {
-    LOCK();
+    LOCK_SHARED();
 
     LOG_TRACE(id << ": off " << off << ", size " << bufsize);
 
@@ -200,7 +234,7 @@ Container::write(off_t off,
                                      EIO);
             }
 
-            bi_->write(ext->path, eid.str(), OverwriteObject::T);
+            upload_(eid, ext);
         }
         CATCH_STD_ALL_EWHAT({
                 LOG_ERROR("Failed to write to extent " << eid << ": " << EWHAT);
@@ -251,8 +285,7 @@ Container::resize(uint64_t size)
         if (extent_exists_(i))
         {
             ExtentId eid(id, i);
-            cache_->erase(eid);
-            bi_->remove(eid.str());
+            remove_extent_(eid);
             extents_.resize(i);
         }
 
@@ -281,7 +314,7 @@ Container::resize(uint64_t size)
         try
         {
             ext->resize(eoff);
-            bi_->write(ext->path, eid.str(), OverwriteObject::T);
+            upload_(eid, ext);
             extent_exists_(idx, true);
         }
         CATCH_STD_ALL_EWHAT({
@@ -304,6 +337,19 @@ Container::resize(uint64_t size)
 void
 Container::erase_extents_(bool from_backend)
 {
+    if (from_backend)
+    {
+        for (uint32_t i = 0; i < extents_.size(); ++i)
+        {
+            cache_->discard(ExtentId(id, i));
+        }
+    }
+    else
+    {
+        // dirty extents are pinned in the cache and would be lost otherwise
+        cache_->flush(id);
+    }
+
     for (uint32_t i = 0; i < extents_.size(); ++i)
     {
         if (extent_exists_(i))
@@ -354,6 +400,13 @@ Container::drop_from_cache()
     erase_extents_(false);
 }
 
+void
+Container::sync()
+{
+    LOG_TRACE(id);
+    cache_->flush(id);
+}
+
 void
 Container::restart()
 {
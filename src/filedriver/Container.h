@@ -18,7 +18,7 @@
 
 #include <vector>
 
-#include <boost/thread/mutex.hpp>
+#include <boost/thread/shared_mutex.hpp>
 
 #include <youtils/Logging.h>
 #include <youtils/StrongTypedString.h>
@@ -70,6 +70,10 @@ public:
     void
     drop_from_cache();
 
+    // Uploads the dirty extents (write back mode)
+    void
+    sync();
+
     uint64_t
     size() const
     {
@@ -81,7 +85,8 @@ public:
 private:
     DECLARE_LOGGER("FileDriverContainer");
 
-    mutable boost::mutex lock_;
+    // reads of (different) extents go in parallel, everything else is exclusive
+    mutable boost::shared_mutex lock_;
     std::shared_ptr<ExtentCache> cache_;
     std::shared_ptr<backend::BackendInterface> bi_;
 
@@ -106,6 +111,13 @@ private:
 
     std::shared_ptr<Extent>
     find_or_create_extent_(const ExtentId& eid);
+
+    void
+    upload_(const ExtentId& eid,
+            std::shared_ptr<Extent> ext);
+
+    void
+    remove_extent_(const ExtentId& eid);
 };
 
 typedef std::shared_ptr<Container> ContainerPtr;
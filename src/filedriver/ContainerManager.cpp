@@ -40,6 +40,7 @@ ContainerManager::ContainerManager(be::BackendConnectionManagerPtr cm,
     , fd_cache_path(pt)
     , fd_namespace(pt)
     , fd_extent_cache_capacity(pt)
+    , fd_extent_write_back_interval_ms(pt)
     , bi_(cm->newBackendInterface(be::Namespace(fd_namespace.value())))
 {
     if (not bi_->namespaceExists())
@@ -48,8 +49,16 @@ ContainerManager::ContainerManager(be::BackendConnectionManagerPtr cm,
         bi_->createNamespace();
     }
 
+    boost::optional<boost::chrono::milliseconds> write_back_interval;
+    if (fd_extent_write_back_interval_ms.value() != 0)
+    {
+        write_back_interval =
+            boost::chrono::milliseconds(fd_extent_write_back_interval_ms.value());
+    }
+
     extent_cache_ = std::make_shared<ExtentCache>(fd_cache_path.value(),
-                                                  fd_extent_cache_capacity.value());
+                                                  fd_extent_cache_capacity.value(),
+                                                  write_back_interval);
 
     LOG_INFO("Up and running, namespace " << fd_namespace.value());
 }
@@ -160,6 +169,9 @@ void
 ContainerManager::sync(const ContainerId& cid)
 {
     LOG_TRACE(cid);
+
+    ContainerPtr c(find_throw_(cid));
+    c->sync();
 }
 
 void
@@ -276,6 +288,8 @@ ContainerManager::update(const bpt::ptree& pt,
         extent_cache_->capacity(fd_extent_cache_capacity.value());
     }
 
+    U(fd_extent_write_back_interval_ms);
+
 #undef U
 }
 
@@ -289,6 +303,7 @@ ContainerManager::persist(bpt::ptree& pt,
     P(fd_cache_path);
     P(fd_namespace);
     P(fd_extent_cache_capacity);
+    P(fd_extent_write_back_interval_ms);
 
 #undef P
 }
@@ -121,6 +121,7 @@ private:
     DECLARE_PARAMETER(fd_cache_path);
     DECLARE_PARAMETER(fd_namespace);
     DECLARE_PARAMETER(fd_extent_cache_capacity);
+    DECLARE_PARAMETER(fd_extent_write_back_interval_ms);
 
     std::shared_ptr<backend::BackendInterface> bi_;
     std::shared_ptr<ExtentCache> extent_cache_;
@@ -15,13 +15,28 @@
 
 #include "ExtentCache.h"
 
+#include <exception>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+#include <youtils/Catchers.h>
+
 namespace filedriver
 {
 
 namespace fs = boost::filesystem;
 
+#define LOCK_DIRTY()                                    \
+    boost::unique_lock<decltype(dirty_lock_)> udl__(dirty_lock_)
+
+#define LOCK_FLUSH()                                    \
+    boost::lock_guard<decltype(flush_lock_)> lfg__(flush_lock_)
+
 ExtentCache::ExtentCache(const boost::filesystem::path& path,
-                         uint32_t capacity)
+                         uint32_t capacity,
+                         const boost::optional<boost::chrono::milliseconds>& write_back_interval)
     : path_(path)
     , cache_("FileDriverExtentCache",
              capacity,
@@ -30,6 +45,9 @@ ExtentCache::ExtentCache(const boost::filesystem::path& path,
              {
                  evict_extent_from_cache_(eid);
              })
+    , write_back_interval_(write_back_interval)
+    , generation_(0)
+    , stop_(false)
 {
     if (not fs::exists(path_))
     {
@@ -55,6 +73,34 @@ ExtentCache::ExtentCache(const boost::filesystem::path& path,
         LOG_WARN("Leftover entry " << *it << " in extent cache - removing it");
         fs::remove_all(*it);
     }
+
+    if (write_back())
+    {
+        LOG_INFO("write back mode, interval " << *write_back_interval_);
+        flusher_ = boost::thread(boost::bind(&ExtentCache::run_flusher_,
+                                             this));
+    }
+}
+
+ExtentCache::~ExtentCache()
+{
+    if (flusher_.joinable())
+    {
+        {
+            LOCK_DIRTY();
+            stop_ = true;
+        }
+
+        dirty_cond_.notify_one();
+        flusher_.join();
+    }
+
+    try
+    {
+        flush();
+    }
+    CATCH_STD_ALL_LOG_IGNORE("Failed to flush dirty extents - " <<
+                             dirty_extents() << " extents not uploaded");
 }
 
 fs::path
@@ -82,4 +128,156 @@ ExtentCache::find(const ExtentId& eid,
                        });
 }
 
+void
+ExtentCache::mark_dirty(const ExtentId& eid,
+                        std::shared_ptr<Extent> ext,
+                        UploadFun fn)
+{
+    VERIFY(write_back());
+    VERIFY(ext != nullptr);
+
+    bool full = false;
+
+    {
+        LOCK_DIRTY();
+        DirtyExtent& d = dirty_[eid];
+        d.extent = std::move(ext);
+        d.upload = std::move(fn);
+        d.generation = ++generation_;
+
+        // dirty extents are pinned - don't let them take over the whole cache
+        full = dirty_.size() > std::max<size_t>(1, cache_.capacity() / 2);
+    }
+
+    if (full)
+    {
+        LOG_INFO("too many dirty extents - flushing them");
+        // the extent at hand is safe in the cache, so don't fail the caller
+        try
+        {
+            flush();
+        }
+        CATCH_STD_ALL_LOG_IGNORE("Failed to flush dirty extents");
+    }
+}
+
+void
+ExtentCache::discard(const ExtentId& eid)
+{
+    LOCK_FLUSH();
+    LOCK_DIRTY();
+
+    dirty_.erase(eid);
+}
+
+size_t
+ExtentCache::dirty_extents() const
+{
+    LOCK_DIRTY();
+    return dirty_.size();
+}
+
+void
+ExtentCache::flush(const ContainerId& cid)
+{
+    flush_([&](const ExtentId& eid)
+           {
+               return eid.container_id == cid;
+           });
+}
+
+void
+ExtentCache::flush()
+{
+    flush_([](const ExtentId&)
+           {
+               return true;
+           });
+}
+
+void
+ExtentCache::flush_(const std::function<bool(const ExtentId&)>& pred)
+{
+    LOCK_FLUSH();
+
+    std::vector<std::pair<ExtentId, DirtyExtent>> todo;
+
+    {
+        LOCK_DIRTY();
+        for (const auto& p : dirty_)
+        {
+            if (pred(p.first))
+            {
+                todo.emplace_back(p);
+            }
+        }
+    }
+
+    std::exception_ptr eptr;
+
+    for (auto& p : todo)
+    {
+        const ExtentId& eid = p.first;
+
+        try
+        {
+            LOG_TRACE("uploading " << eid);
+            p.second.upload(eid,
+                            p.second.extent->path);
+
+            LOCK_DIRTY();
+            auto it = dirty_.find(eid);
+            // written to again in the meantime? -> leave it for the next round
+            if (it != dirty_.end() and
+                it->second.generation == p.second.generation)
+            {
+                dirty_.erase(it);
+            }
+        }
+        CATCH_STD_ALL_EWHAT({
+                LOG_ERROR("Failed to upload extent " << eid << ": " << EWHAT);
+                if (not eptr)
+                {
+                    eptr = std::current_exception();
+                }
+            });
+    }
+
+    if (eptr)
+    {
+        std::rethrow_exception(eptr);
+    }
+}
+
+void
+ExtentCache::run_flusher_()
+{
+    LOG_INFO("flusher starting");
+
+    while (true)
+    {
+        {
+            LOCK_DIRTY();
+            dirty_cond_.wait_for(udl__,
+                                 *write_back_interval_,
+                                 [&]
+                                 {
+                                     return stop_;
+                                 });
+            if (stop_)
+            {
+                break;
+            }
+        }
+
+        try
+        {
+            flush();
+        }
+        CATCH_STD_ALL_LOG_IGNORE("Failed to flush dirty extents - retrying later");
+    }
+
+    LOG_INFO("flusher exiting");
+}
+
 }
@@ -19,8 +19,16 @@
 #include "Extent.h"
 #include "ExtentId.h"
 
+#include <functional>
+#include <map>
+
 #include <boost/bimap/set_of.hpp>
+#include <boost/chrono.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
 
 #include <youtils/Logging.h>
 #include <youtils/LRUCache.h>
@@ -28,15 +36,22 @@
 namespace filedriver
 {
 
+// With a write back interval the cache also keeps track of dirty extents: instead
+// of uploading an extent after each write the caller marks it dirty and a
+// background thread uploads it (once, no matter how often it was written to in
+// the meantime) every interval. Dirty extents are pinned in the cache until
+// they're uploaded; flush() forces the upload of a container's or all dirty
+// extents.
 class ExtentCache
 {
     typedef youtils::LRUCache<ExtentId, Extent, boost::bimaps::set_of> Cache;
 
 public:
     ExtentCache(const boost::filesystem::path& path,
-                uint32_t capacity);
+                uint32_t capacity,
+                const boost::optional<boost::chrono::milliseconds>& write_back_interval = boost::none);
 
-    ~ExtentCache() = default;
+    ~ExtentCache();
 
     ExtentCache(const ExtentCache&) = delete;
 
@@ -67,12 +82,72 @@ public:
         return cache_.erase(eid);
     }
 
+    bool
+    write_back() const
+    {
+        return write_back_interval_ != boost::none;
+    }
+
+    typedef std::function<void(const ExtentId&,
+                               const boost::filesystem::path&)> UploadFun;
+
+    // Write back mode only. Marking an already dirty extent dirty again
+    // replaces the upload function and makes sure it's uploaded (again) by
+    // the next flush.
+    void
+    mark_dirty(const ExtentId& eid,
+               std::shared_ptr<Extent> ext,
+               UploadFun fn);
+
+    // Forget about a dirty extent without uploading it, e.g. as it's about to
+    // be removed.
+    void
+    discard(const ExtentId& eid);
+
+    // Upload the container's dirty extents. Throws the first upload error
+    // after attempting all of them; extents that failed remain dirty.
+    void
+    flush(const ContainerId& cid);
+
+    void
+    flush();
+
+    size_t
+    dirty_extents() const;
+
 private:
     DECLARE_LOGGER("FileDriverExtentCache");
 
     const boost::filesystem::path path_;
     Cache cache_;
 
+    const boost::optional<boost::chrono::milliseconds> write_back_interval_;
+
+    struct DirtyExtent
+    {
+        std::shared_ptr<Extent> extent;
+        UploadFun upload;
+        uint64_t generation;
+    };
+
+    // serializes flushes and discards, i.e. nothing is discarded while being uploaded
+    boost::mutex flush_lock_;
+
+    // protects dirty_, generation_ and stop_
+    mutable boost::mutex dirty_lock_;
+    boost::condition_variable dirty_cond_;
+    std::map<ExtentId, DirtyExtent> dirty_;
+    uint64_t generation_;
+    bool stop_;
+
+    boost::thread flusher_;
+
+    void
+    run_flusher_();
+
+    void
+    flush_(const std::function<bool(const ExtentId&)>& pred);
+
     boost::filesystem::path
     make_path_(const Cache::Key& eid);
 
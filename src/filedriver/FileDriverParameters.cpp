@@ -38,4 +38,11 @@ DEFINE_INITIALIZED_PARAM_WITH_DEFAULT(fd_extent_cache_capacity,
                                       "number of extents the extent cache can hold",
                                       ShowDocumentation::T,
                                       1024);
+
+DEFINE_INITIALIZED_PARAM_WITH_DEFAULT(fd_extent_write_back_interval_ms,
+                                      file_driver_component_name,
+                                      "fd_extent_write_back_interval_ms",
+                                      "interval (milliseconds) between uploads of modified extents to the backend; 0 uploads them on each write",
+                                      ShowDocumentation::T,
+                                      0);
 }
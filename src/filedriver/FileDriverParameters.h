@@ -28,6 +28,7 @@ extern const char file_driver_component_name[];
 DECLARE_INITIALIZED_PARAM(fd_cache_path, std::string);
 DECLARE_INITIALIZED_PARAM(fd_namespace, std::string);
 DECLARE_INITIALIZED_PARAM_WITH_DEFAULT(fd_extent_cache_capacity, uint32_t);
+DECLARE_INITIALIZED_PARAM_WITH_DEFAULT(fd_extent_write_back_interval_ms, uint32_t);
 
 }
 
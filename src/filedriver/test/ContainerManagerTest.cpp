@@ -345,4 +345,62 @@ TEST_F(ContainerManagerTest, resize_container)
     check(0);
 }
 
+TEST_F(ContainerManagerTest, write_back)
+{
+    const be::Namespace ns;
+    bpt::ptree pt;
+    make_config(pt, ns);
+    // long enough for the flusher not to kick in during the test
+    ip::PARAMETER_TYPE(fd_extent_write_back_interval_ms)(3600 * 1000).persist(pt);
+
+    const fd::ContainerId cid("some-container");
+    const fd::ExtentId eid(cid, 0);
+    const std::string pattern1("some data");
+    const std::string pattern2("some other data");
+
+    auto bi(backend_interface(ns));
+
+    {
+        fd::ContainerManager mgr(connection_manager(),
+                                 pt);
+        mgr.create(cid);
+
+        EXPECT_EQ(pattern1.size(),
+                  mgr.write(cid, 0, pattern1.data(), pattern1.size()));
+        EXPECT_FALSE(bi->objectExists(eid.str()));
+
+        std::vector<char> rbuf(pattern1.size());
+        EXPECT_EQ(pattern1.size(), mgr.read(cid, 0, rbuf.data(), rbuf.size()));
+        EXPECT_EQ(pattern1, std::string(rbuf.data(), rbuf.size()));
+
+        mgr.sync(cid);
+        EXPECT_TRUE(bi->objectExists(eid.str()));
+        EXPECT_EQ(pattern1.size(), bi->getSize(eid.str()));
+
+        EXPECT_EQ(pattern2.size(),
+                  mgr.write(cid, 0, pattern2.data(), pattern2.size()));
+        EXPECT_EQ(pattern1.size(), bi->getSize(eid.str()));
+    }
+
+    // the dirty extent is uploaded on shutdown
+    EXPECT_EQ(pattern2.size(), bi->getSize(eid.str()));
+
+    fd::ContainerManager mgr(connection_manager(),
+                             pt);
+    mgr.restart(cid);
+
+    std::vector<char> rbuf(pattern2.size());
+    EXPECT_EQ(pattern2.size(), mgr.read(cid, 0, rbuf.data(), rbuf.size()));
+    EXPECT_EQ(pattern2, std::string(rbuf.data(), rbuf.size()));
+
+    // dirty extents of an unlinked container are not uploaded
+    const fd::ContainerId cid2("some-other-container");
+    mgr.create(cid2);
+    EXPECT_EQ(pattern1.size(),
+              mgr.write(cid2, 0, pattern1.data(), pattern1.size()));
+    mgr.unlink(cid2);
+
+    EXPECT_FALSE(bi->objectExists(fd::ExtentId(cid2, 0).str()));
+}
+
 }
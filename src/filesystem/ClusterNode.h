@@ -74,6 +74,11 @@ public:
     resize(const Object& obj,
            uint64_t newsize) = 0;
 
+    virtual void
+    discard(const Object& obj,
+            uint64_t size,
+            uint64_t off) = 0;
+
     virtual void
     unlink(const Object& obj) = 0;
 
@@ -31,12 +31,15 @@
 #include <dirent.h>
 #include <unistd.h>
 
+#include <algorithm>
+
 #include <boost/filesystem/fstream.hpp>
 #include <boost/serialization/shared_ptr.hpp>
 
 #include <youtils/Assert.h>
 #include <youtils/Logging.h>
 #include <youtils/ScopeExit.h>
+#include <youtils/WorkerPool.h>
 
 #include <volumedriver/MDSNodeConfig.h>
 #include <volumedriver/MetaDataBackendConfig.h>
@@ -183,7 +186,9 @@ FileSystem::FileSystem(const bpt::ptree& pt,
     DECLARE_PARAMETER(fs_max_open_files)(pt);
     setlimit(RLIMIT_NOFILE, fs_max_open_files.value());
 
-    restart_(restart_volumes);
+    DECLARE_PARAMETER(fs_restart_threads)(pt);
+    restart_(restart_volumes,
+             fs_restart_threads.value());
 
     InstantiateXMLRPCS<xmlrpcs>::doit(xmlrpc_svc_, *this);
     xmlrpc_svc_.start();
@@ -395,8 +400,11 @@ FileSystem::is_volume_path_(const FrontendPath& p) const
 }
 
 void
-FileSystem::restart_(const RestartVolumes restart_volumes)
+FileSystem::restart_(const RestartVolumes restart_volumes,
+                     const size_t num_threads)
 {
+    std::vector<std::pair<FrontendPath, ObjectId>> objects;
+
     auto fun([&](const FrontendPath& p, const DirectoryEntryPtr dentry)
              {
                  const ObjectId& id = dentry->object_id();
@@ -408,20 +416,41 @@ FileSystem::restart_(const RestartVolumes restart_volumes)
                      }
                      else
                      {
-                         LOG_TRACE(p << ": trying to restart " << id);
-                         try
-                         {
-                             router_.maybe_restart(id,
-                                                   ForceRestart::F);
-                         }
-                         CATCH_STD_ALL_LOG_IGNORE(p << ": failed to restart volume " <<
-                                                  id);
+                         objects.emplace_back(p, id);
                      }
                  }
              });
 
     mdstore_.walk(FrontendPath("/"),
                   std::move(fun));
+
+    // The restarts (and the DTL replays they include) of different volumes are
+    // independent of each other, so they're spread over a few threads.
+    const size_t nthreads = std::min(std::max<size_t>(num_threads, 1),
+                                     std::max<size_t>(objects.size(), 1));
+
+    LOG_INFO("restarting " << objects.size() << " objects using " <<
+             nthreads << " threads");
+
+    youtils::WorkerPool pool("FileSystemRestartPool",
+                             nthreads - 1);
+
+    pool.for_each_index(objects.size(),
+                        nthreads,
+                        [&](size_t i)
+                        {
+                            const FrontendPath& p = objects[i].first;
+                            const ObjectId& id = objects[i].second;
+
+                            LOG_TRACE(p << ": trying to restart " << id);
+                            try
+                            {
+                                router_.maybe_restart(id,
+                                                      ForceRestart::F);
+                            }
+                            CATCH_STD_ALL_LOG_IGNORE(p << ": failed to restart volume " <<
+                                                     id);
+                        });
 }
 
 void
@@ -1311,6 +1340,50 @@ FileSystem::write(const FrontendPath& path,
           sync);
 }
 
+void
+FileSystem::discard(Handle& h,
+                    uint64_t size,
+                    uint64_t off)
+{
+    LOG_TRACE("size " << size << ", off " << off <<
+              ", handle " << &h << ", path " << h.path());
+
+    if (not fs_nullio.value())
+    {
+        const ObjectId& id(h.dentry()->object_id());
+        const uint64_t osize = router_.get_size(id);
+
+        if (off >= osize)
+        {
+            return;
+        }
+
+        router_.discard(id,
+                        std::min(size,
+                                 osize - off),
+                        off);
+
+        if (not is_volume(h.dentry()))
+        {
+            maybe_publish_file_event_(FileSystemCall::Write,
+                                      &FileSystemEvents::file_write,
+                                      h.path());
+        }
+    }
+}
+
+void
+FileSystem::discard(const FrontendPath& path,
+                    Handle& h,
+                    uint64_t size,
+                    uint64_t off)
+{
+    LOG_TRACE(path << ": size " << size << ", off " << off);
+    discard(h,
+            size,
+            off);
+}
+
 void
 FileSystem::fsync(Handle& h,
                   bool datasync,
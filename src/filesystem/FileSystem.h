@@ -172,6 +172,19 @@ public:
           Handle&,
           bool datasync);
 
+    // Discards (unmaps) the range; reads return zeroes afterwards. The part
+    // beyond the end of the object is ignored.
+    void
+    discard(Handle&,
+            uint64_t size,
+            uint64_t off);
+
+    void
+    discard(const FrontendPath&,
+            Handle&,
+            uint64_t size,
+            uint64_t off);
+
     void
     fsync(Handle&,
           bool datasync,
@@ -621,7 +634,8 @@ private:
                                const FrontendPath& to);
 
     void
-    restart_(const RestartVolumes);
+    restart_(const RestartVolumes,
+             const size_t num_threads);
 
     void
     create_volume_(const FrontendPath&,
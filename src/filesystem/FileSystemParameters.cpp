@@ -283,6 +283,13 @@ DEFINE_INITIALIZED_PARAM_WITH_DEFAULT(fs_max_open_files,
                                       ShowDocumentation::T,
                                       65536);
 
+DEFINE_INITIALIZED_PARAM_WITH_DEFAULT(fs_restart_threads,
+                                      filesystem_component_name,
+                                      "fs_restart_threads",
+                                      "Number of volumes that are restarted (incl. DTL replay) in parallel on startup",
+                                      ShowDocumentation::T,
+                                      4);
+
 DEFINE_INITIALIZED_PARAM_WITH_DEFAULT(fs_internal_suffix,
                                       filesystem_component_name,
                                       "fs_internal_suffix",
@@ -101,6 +101,7 @@ DECLARE_RESETTABLE_INITIALIZED_PARAM_WITH_DEFAULT(fs_ignore_sync,
                                                   bool);
 
 DECLARE_INITIALIZED_PARAM_WITH_DEFAULT(fs_max_open_files, uint32_t);
+DECLARE_INITIALIZED_PARAM_WITH_DEFAULT(fs_restart_threads, uint32_t);
 DECLARE_INITIALIZED_PARAM(fs_virtual_disk_format, std::string);
 
 DECLARE_INITIALIZED_PARAM_WITH_DEFAULT(fs_raw_disk_suffix,
@@ -19,6 +19,7 @@
 #include "ShmOrbInterface.h"
 
 #include <fuse3/fuse_lowlevel.h>
+#include <linux/falloc.h>
 
 #include <boost/property_tree/ptree.hpp>
 
@@ -187,6 +188,7 @@ FuseInterface::init_ops_(fuse_operations& ops) const
     INSTALL_CB(statfs);
     INSTALL_CB(release);
     INSTALL_CB(fsync);
+    INSTALL_CB(fallocate);
     INSTALL_CB(mknod);
     INSTALL_CB(opendir);
     INSTALL_CB(releasedir);
@@ -692,6 +694,35 @@ FuseInterface::fsync(const char* /* path */,
                                        datasync);
 }
 
+int
+FuseInterface::fallocate(const char* /* path */,
+                         int mode,
+                         off_t off,
+                         off_t len,
+                         fuse_file_info* fi)
+{
+    if (mode != (FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE))
+    {
+        return -EOPNOTSUPP;
+    }
+
+    if (off < 0 or len <= 0)
+    {
+        return -EINVAL;
+    }
+
+    Handle* h = get_handle(*fi);
+    VERIFY(h);
+
+    return route_to_fs_instance_<Handle&,
+                                 uint64_t,
+                                 uint64_t>(&FileSystem::discard,
+                                           h->path(),
+                                           *h,
+                                           len,
+                                           off);
+}
+
 int
 FuseInterface::statfs(const char* path,
                       struct statvfs* stbuf)
@@ -141,6 +141,15 @@ public:
           int datasync,
           fuse_file_info* fi);
 
+    // Only punching holes (FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE) is
+    // supported, which discards the range.
+    static int
+    fallocate(const char* path,
+              int mode,
+              off_t off,
+              off_t len,
+              fuse_file_info* fi);
+
     static int
     utimens(const char* path,
             const struct timespec tv[2]);
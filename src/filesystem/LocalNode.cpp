@@ -877,6 +877,113 @@ LocalNode::resize_(vd::WeakVolumePtr vol,
                 clusters);
 }
 
+void
+LocalNode::discard(const Object& obj,
+                   uint64_t size,
+                   uint64_t off)
+{
+    LOG_TRACE(obj.id << ": size " << size << ", off " << off);
+
+    RWLockPtr l(get_lock_(obj.id));
+
+    if (is_file(obj))
+    {
+        // The filedriver has no notion of holes - zero the range instead.
+        fungi::ScopedReadLock rg(*l);
+
+        const std::vector<uint8_t> zeroes(std::min<uint64_t>(size,
+                                                             1ULL << 20),
+                                          0);
+        uint64_t done = 0;
+        while (done < size)
+        {
+            const size_t len = std::min<uint64_t>(size - done,
+                                                  zeroes.size());
+            const size_t res =
+                convert_fdriver_exceptions_<size_t,
+                                            off_t,
+                                            const void*,
+                                            size_t>(&fd::ContainerManager::write,
+                                                    obj,
+                                                    off + done,
+                                                    zeroes.data(),
+                                                    len);
+            VERIFY(res == len);
+            done += len;
+        }
+    }
+    else if (is_unaligned(size,
+                          off))
+    {
+        // the partially covered clusters are zeroed, cf. write()
+        fungi::ScopedWriteLock wg(*l);
+        with_volume_pointer_(&LocalNode::discard_,
+                             obj.id,
+                             size,
+                             off);
+    }
+    else
+    {
+        fungi::ScopedReadLock rg(*l);
+        with_volume_pointer_(&LocalNode::discard_,
+                             obj.id,
+                             size,
+                             off);
+    }
+}
+
+void
+LocalNode::discard_(vd::WeakVolumePtr vol,
+                    uint64_t size,
+                    uint64_t off)
+{
+    const uint64_t lbasize = api::GetLbaSize(vol);
+    const uint64_t end = off + size;
+    const uint64_t lba_start = (off + lbasize - 1) / lbasize * lbasize;
+    const uint64_t lba_end = end / lbasize * lbasize;
+
+    // Bits of LBAs at the edges are zeroed through the write path, which
+    // already knows how to deal with those.
+    auto zero([&](uint64_t from,
+                  uint64_t to)
+              {
+                  if (from < to)
+                  {
+                      const std::vector<uint8_t> zeroes(to - from, 0);
+                      vd::DtlInSync dtl_in_sync = vd::DtlInSync::F;
+                      write_(vol,
+                             zeroes.data(),
+                             zeroes.size(),
+                             from,
+                             dtl_in_sync);
+                  }
+              });
+
+    if (lba_start >= lba_end)
+    {
+        zero(off, end);
+        return;
+    }
+
+    zero(off, lba_start);
+    zero(lba_end, end);
+
+    using Discarder = void (*)(vd::WeakVolumePtr,
+                               uint64_t,
+                               uint64_t);
+
+    uint64_t lba = lba_start / lbasize;
+    uint64_t len = lba_end - lba_start;
+
+    LOG_TRACE("discarding, off " << lba_start << " (LBA " << lba <<
+              "), size " << len);
+
+    maybe_retry_<void>(static_cast<Discarder>(&api::Discard),
+                       vol,
+                       lba,
+                       len);
+}
+
 namespace
 {
 
@@ -120,6 +120,11 @@ public:
     resize(const Object& obj,
            uint64_t newsize) override final;
 
+    virtual void
+    discard(const Object& obj,
+            uint64_t size,
+            uint64_t off) override final;
+
     virtual void
     unlink(const Object& obj) override final;
 
@@ -407,6 +412,11 @@ private:
     resize_(volumedriver::WeakVolumePtr vol,
             uint64_t newsize);
 
+    void
+    discard_(volumedriver::WeakVolumePtr vol,
+             uint64_t size,
+             uint64_t off);
+
     void
     destroy_(volumedriver::WeakVolumePtr,
              volumedriver::DeleteLocalData,
@@ -116,6 +116,23 @@ MessageUtils::create_resize_request(const vfs::Object& obj,
     return msg;
 }
 
+DiscardRequest
+MessageUtils::create_discard_request(const vfs::Object& obj,
+                                     uint64_t size,
+                                     uint64_t off)
+{
+    DiscardRequest msg;
+    msg.set_object_id(obj.id.str());
+    msg.set_object_type(static_cast<uint32_t>(obj.type));
+
+    msg.set_size(size);
+    msg.set_offset(off);
+
+    msg.CheckInitialized();
+
+    return msg;
+}
+
 GetSizeRequest
 MessageUtils::create_get_size_request(const vfs::Object& obj)
 {
@@ -83,6 +83,11 @@ struct MessageUtils
     create_resize_request(const volumedriverfs::Object&,
                           uint64_t newsize);
 
+    static DiscardRequest
+    create_discard_request(const volumedriverfs::Object&,
+                           uint64_t size,
+                           uint64_t off);
+
     static DeleteRequest
     create_delete_request(const volumedriverfs::Object&);
 
@@ -151,6 +151,8 @@ enum class NetworkXioMsgOpcode
     GetCloneNamespaceMapRsp,
     GetPageReq,
     GetPageRsp,
+    DiscardReq,
+    DiscardRsp,
 };
 
 #endif //__NETWORK_XIO_COMMON_H_
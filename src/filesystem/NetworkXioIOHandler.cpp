@@ -381,6 +381,44 @@ NetworkXioIOHandler::handle_flush(NetworkXioRequest *req)
     pack_msg(req);
 }
 
+void
+NetworkXioIOHandler::handle_discard(NetworkXioRequest *req,
+                                    size_t size,
+                                    uint64_t offset)
+{
+    req->op = NetworkXioMsgOpcode::DiscardRsp;
+    if (not handle_)
+    {
+        req->retval = -1;
+        req->errval = EIO;
+        pack_msg(req);
+        return;
+    }
+
+    req->size = size;
+    req->offset = offset;
+    try
+    {
+        fs_.discard(*handle_,
+                    req->size,
+                    req->offset);
+        req->retval = 0;
+        req->errval = 0;
+    }
+    catch (const vd::AccessBeyondEndOfVolumeException& e)
+    {
+       LOG_ERROR("discard I/O error: " << e.what());
+       req->retval = -1;
+       req->errval = EFBIG;
+    }
+    CATCH_STD_ALL_EWHAT({
+       LOG_ERROR("discard I/O error: " << EWHAT);
+       req->retval = -1;
+       req->errval = EIO;
+    });
+    pack_msg(req);
+}
+
 void
 NetworkXioIOHandler::handle_create_volume(NetworkXioRequest *req,
                                           const std::string& volume_name,
@@ -1313,6 +1351,13 @@ NetworkXioIOHandler::process_request(NetworkXioRequest *req)
         handle_flush(req);
         break;
     }
+    case NetworkXioMsgOpcode::DiscardReq:
+    {
+        handle_discard(req,
+                       i_msg.size(),
+                       i_msg.offset());
+        break;
+    }
     default:
         prepare_ctrl_request(req);
         return;
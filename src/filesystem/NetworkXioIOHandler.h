@@ -93,6 +93,10 @@ private:
 
     void handle_flush(NetworkXioRequest *req);
 
+    void handle_discard(NetworkXioRequest *req,
+                        size_t size,
+                        uint64_t offset);
+
     void handle_create_volume(NetworkXioRequest *req,
                               const std::string& volume_name,
                               size_t size);
@@ -430,6 +430,12 @@ ObjectRouter::redirected_work_(ZWorkerPool::MessageParts parts_in)
                 handle_resize_(get_req<vfsprotocol::ResizeRequest>(parts_in));
                 break;
             }
+        case vfsprotocol::RequestType::Discard:
+            {
+                CHECK(parts_in.size() == 3);
+                handle_discard_(get_req<vfsprotocol::DiscardRequest>(parts_in));
+                break;
+            }
         case vfsprotocol::RequestType::Delete:
             {
                 CHECK(parts_in.size() == 3);
@@ -1374,6 +1380,36 @@ ObjectRouter::handle_resize_(const vfsprotocol::ResizeRequest& req)
     local_node_()->resize(obj, size);
 }
 
+void
+ObjectRouter::discard(const ObjectId& id,
+                      uint64_t size,
+                      uint64_t off)
+{
+    LOG_TRACE(id << ": size " << size << ", off " << off);
+
+    FastPathCookie cookie;
+
+    route_(&ClusterNode::discard,
+           AttemptTheft::T,
+           id,
+           cookie,
+           size,
+           off);
+}
+
+void
+ObjectRouter::handle_discard_(const vfsprotocol::DiscardRequest& req)
+{
+    const Object obj(obj_from_msg(req));
+    const uint64_t size = req.size();
+    const uint64_t off = req.offset();
+
+    LOG_TRACE(obj << ": size " << size << ", off " << off);
+    local_node_()->discard(obj,
+                           size,
+                           off);
+}
+
 void
 ObjectRouter::unlink(const ObjectId& id)
 {
@@ -58,6 +58,7 @@ class WriteRequest;
 class SyncRequest;
 class GetSizeRequest;
 class ResizeRequest;
+class DiscardRequest;
 class DeleteRequest;
 class TransferRequest;
 class GetClusterMultiplierRequest;
@@ -210,6 +211,11 @@ public:
     resize(const ObjectId& id,
            uint64_t newsize);
 
+    void
+    discard(const ObjectId& id,
+            uint64_t size,
+            uint64_t off);
+
     void
     unlink(const ObjectId& id);
 
@@ -598,6 +604,9 @@ private:
     void
     handle_resize_(const vfsprotocol::ResizeRequest&);
 
+    void
+    handle_discard_(const vfsprotocol::DiscardRequest&);
+
     void
     handle_delete_volume_(const vfsprotocol::DeleteRequest&);
 
@@ -695,6 +695,21 @@ RemoteNode::resize(const Object& obj,
             vrouter_.redirect_timeout());
 }
 
+void
+RemoteNode::discard(const Object& obj,
+                    uint64_t size,
+                    uint64_t off)
+{
+    LOG_TRACE(node_id() << ": obj " << obj.id << ", size " << size << ", off " << off);
+
+    const auto req(vfsprotocol::MessageUtils::create_discard_request(obj,
+                                                                     size,
+                                                                     off));
+
+    handle_(req,
+            vrouter_.redirect_timeout());
+}
+
 void
 RemoteNode::unlink(const Object& obj)
 {
@@ -92,6 +92,11 @@ public:
     resize(const Object&,
            uint64_t newsize) override final;
 
+    virtual void
+    discard(const Object&,
+            uint64_t size,
+            uint64_t off) override final;
+
     virtual void
     unlink(const Object&) override final;
 
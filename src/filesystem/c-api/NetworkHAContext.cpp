@@ -268,6 +268,9 @@ NetworkHAContext::resend_inflight_requests()
         case RequestOp::AsyncFlush:
             ctx->send_flush_request(request);
             break;
+        case RequestOp::Discard:
+            ctx->send_discard_request(request);
+            break;
         default:
             LIBLOGID_ERROR("unknown inflight request, op:"
                            << static_cast<int>(request->_op));
@@ -695,6 +698,13 @@ NetworkHAContext::send_flush_request(ovs_aio_request* request)
                    request);
 }
 
+int
+NetworkHAContext::send_discard_request(ovs_aio_request* request)
+{
+    return wrap_io(&NetworkXioContext::send_discard_request,
+                   request);
+}
+
 int
 NetworkHAContext::stat_volume(struct stat *st)
 {
@@ -123,6 +123,9 @@ public:
     int
     send_flush_request(ovs_aio_request*) override final;
 
+    int
+    send_discard_request(ovs_aio_request*) override final;
+
     int
     stat_volume(struct stat *st) override final;
 
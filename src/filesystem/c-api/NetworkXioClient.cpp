@@ -720,6 +720,23 @@ NetworkXioClient::xio_send_flush_request(ovs_aio_request *request)
     xstop_loop();
 }
 
+void
+NetworkXioClient::xio_send_discard_request(const uint64_t size_in_bytes,
+                                           const uint64_t offset_in_bytes,
+                                           ovs_aio_request *request)
+{
+    xio_msg_s *xmsg = new xio_msg_s;
+    xmsg->set_opaque(request);
+    xmsg->msg.opcode(NetworkXioMsgOpcode::DiscardReq);
+    xmsg->msg.opaque((uintptr_t)xmsg);
+    xmsg->msg.size(size_in_bytes);
+    xmsg->msg.offset(offset_in_bytes);
+
+    xio_msg_prepare(xmsg);
+    push_request(xmsg);
+    xstop_loop();
+}
+
 void
 NetworkXioClient::xio_send_close_request(ovs_aio_request *request)
 {
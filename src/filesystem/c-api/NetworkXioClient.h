@@ -124,6 +124,11 @@ public:
     void
     xio_send_flush_request(ovs_aio_request *request);
 
+    void
+    xio_send_discard_request(const uint64_t size_in_bytes,
+                             const uint64_t offset_in_bytes,
+                             ovs_aio_request *request);
+
     void
     xio_get_volume_uri(const char* volume_name,
                        std::string& volume_uri,
@@ -456,6 +461,7 @@ private:
             case RequestOp::Write:
             case RequestOp::Flush:
             case RequestOp::AsyncFlush:
+            case RequestOp::Discard:
                 ha_ctx_.insert_seen_request(id);
                 break;
             default:
@@ -718,6 +718,28 @@ NetworkXioContext::send_flush_request(ovs_aio_request *request)
     return r;
 }
 
+int
+NetworkXioContext::send_discard_request(ovs_aio_request *request)
+{
+    int r = 0;
+    ovs_aiocb *ovs_aiocbp = request->ovs_aiocbp;
+    try
+    {
+        net_client_->xio_send_discard_request(ovs_aiocbp->aio_nbytes,
+                                              ovs_aiocbp->aio_offset,
+                                              request);
+    }
+    catch (const std::bad_alloc&)
+    {
+        errno = ENOMEM; r = -1;
+    }
+    catch (...)
+    {
+        errno = EIO; r = -1;
+    }
+    return r;
+}
+
 int
 NetworkXioContext::stat_volume(struct stat *st)
 {
@@ -318,6 +318,14 @@ ShmContext::send_flush_request(ovs_aio_request* request)
                                                      request);
 }
 
+int
+ShmContext::send_discard_request(ovs_aio_request* /* request */)
+{
+    // not supported by the shared memory server
+    errno = EOPNOTSUPP;
+    return -1;
+}
+
 int
 ShmContext::stat_volume(struct stat *st)
 {
@@ -97,6 +97,9 @@ struct ShmContext : public ovs_context_t
     int
     send_flush_request(ovs_aio_request*) override final;
 
+    int
+    send_discard_request(ovs_aio_request*) override final;
+
     int
     stat_volume(struct stat *st) override final;
 
@@ -37,6 +37,7 @@ enum class RequestOp
     GetClusterMultiplier,
     GetPage,
     GetCloneNamespaceMap,
+    Discard,
 };
 
 enum class TransportType
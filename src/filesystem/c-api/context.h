@@ -71,6 +71,8 @@ public:
 
     virtual int send_flush_request(ovs_aio_request*) = 0;
 
+    virtual int send_discard_request(ovs_aio_request*) = 0;
+
     virtual int stat_volume(struct stat *st) = 0;
 
     virtual ovs_buffer* allocate(size_t size) = 0;
@@ -726,6 +726,7 @@ _ovs_submit_aio_request(ovs_ctx_t *ctx,
     case RequestOp::Write:
     case RequestOp::Flush:
     case RequestOp::AsyncFlush:
+    case RequestOp::Discard:
     {
         if (accmode == O_RDONLY)
         {
@@ -784,6 +785,11 @@ _ovs_submit_aio_request(ovs_ctx_t *ctx,
         r = ctx->send_flush_request(request);
     }
         break;
+    case RequestOp::Discard:
+    {
+        r = ctx->send_discard_request(request);
+    }
+        break;
     default:
         errno = EINVAL; r = -1;
         break;
@@ -823,6 +829,16 @@ ovs_aio_write(ovs_ctx_t *ctx,
                                    RequestOp::Write);
 }
 
+int
+ovs_aio_discard(ovs_ctx_t *ctx,
+                struct ovs_aiocb *ovs_aiocbp)
+{
+    return _ovs_submit_aio_request(ctx,
+                                   ovs_aiocbp,
+                                   nullptr,
+                                   RequestOp::Discard);
+}
+
 int
 ovs_aio_error(ovs_ctx_t *ctx,
               struct ovs_aiocb *ovs_aiocbp)
@@ -1229,6 +1245,17 @@ ovs_aio_writecb(ovs_ctx_t *ctx,
                                    RequestOp::Write);
 }
 
+int
+ovs_aio_discardcb(ovs_ctx_t *ctx,
+                  struct ovs_aiocb *ovs_aiocbp,
+                  ovs_completion_t *completion)
+{
+    return _ovs_submit_aio_request(ctx,
+                                   ovs_aiocbp,
+                                   completion,
+                                   RequestOp::Discard);
+}
+
 int
 ovs_aio_flushcb(ovs_ctx_t *ctx,
                 ovs_completion_t *completion)
@@ -407,6 +407,17 @@ int
 ovs_aio_write(ovs_ctx_t *ctx,
               struct ovs_aiocb *ovs_aiocbp);
 
+/*
+ * Asynchronous discard of a range of a volume
+ * param ctx: Open vStorage context
+ * param ovs_aiocb: Pointer to an AIO Control Block structure, aio_buf is
+ *                  not used
+ * return: 0 on success, -1 on fail
+ */
+int
+ovs_aio_discard(ovs_ctx_t *ctx,
+                struct ovs_aiocb *ovs_aiocbp);
+
 /*
  * Asynchronous read from a volume with completion
  * param ctx: Open vStorage context
@@ -431,6 +442,19 @@ ovs_aio_writecb(ovs_ctx_t *ctx,
                 struct ovs_aiocb *ovs_aiocbp,
                 ovs_completion_t *completion);
 
+/*
+ * Asynchronous discard of a range of a volume with completion
+ * param ctx: Open vStorage context
+ * param ovs_aiocb: Pointer to an AIO Control Block structure, aio_buf is
+ *                  not used
+ * param completion: Pointer to a completion structure
+ * return: 0 on success, -1 on fail
+ */
+int
+ovs_aio_discardcb(ovs_ctx_t *ctx,
+                  struct ovs_aiocb *ovs_aiocbp,
+                  ovs_completion_t *completion);
+
 /*
  * Asynchronously syncronize a volume's in-core state with that on disk with
  * completion
@@ -124,6 +124,25 @@ api::Write(WriteOnlyVolume* vol,
                buflen);
 }
 
+void
+api::Discard(WeakVolumePtr vol,
+             const uint64_t lba,
+             const uint64_t len)
+{
+    SharedVolumePtr(vol)->discard(lba,
+                                  len);
+}
+
+void
+api::Discard(WriteOnlyVolume* vol,
+             uint64_t lba,
+             uint64_t len)
+{
+    VERIFY(vol);
+    vol->discard(lba,
+                 len);
+}
+
 vd::DtlInSync
 api::Sync(vd::WeakVolumePtr vol)
 {
@@ -126,6 +126,16 @@ public:
          uint8_t *buf,
          const uint64_t buflen);
 
+    static void
+    Discard(volumedriver::WeakVolumePtr vol,
+            const uint64_t lba,
+            const uint64_t len);
+
+    static void
+    Discard(volumedriver::WriteOnlyVolume* vol,
+            const uint64_t lba,
+            const uint64_t len);
+
     static volumedriver::DtlInSync
     Sync(volumedriver::WeakVolumePtr);
 
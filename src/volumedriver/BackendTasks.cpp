@@ -15,10 +15,12 @@
 
 #include "BackendTasks.h"
 #include "CachedSCO.h"
+#include "CompressedTLog.h"
 #include "DataStoreCallBack.h"
 #include "OwnerTag.h"
 #include "SnapshotManagement.h"
 #include "TransientException.h"
+#include "VolManager.h"
 #include "Volume.h"
 #include "VolumeDriverError.h"
 
@@ -162,12 +164,37 @@ WriteTLog::run(int /*threadid*/)
 
     try
     {
-        volume_->getBackendInterface()->write(tlogpath_.string(),
-                                              boost::lexical_cast<std::string>(tlogid_),
-                                              OverwriteObject::T,
-                                              &checksum_,
-                                              volume_->backend_write_condition(),
-                                              fail_fast_request_params);
+        auto write([&](const fs::path& p,
+                       const CheckSum& cs)
+                   {
+                       volume_->getBackendInterface()->write(p,
+                                                             boost::lexical_cast<std::string>(tlogid_),
+                                                             OverwriteObject::T,
+                                                             &cs,
+                                                             volume_->backend_write_condition(),
+                                                             fail_fast_request_params);
+                   });
+
+        // the existence check retains the "gone, probably snapshot restore"
+        // handling below
+        if (VolManager::get()->compress_tlogs_on_backend.value() and
+            fs::exists(tlogpath_))
+        {
+            const fs::path tmp(FileUtils::create_temp_file(tlogpath_.parent_path(),
+                                                           tlogpath_.filename().string() +
+                                                           "_compressed"));
+            ALWAYS_CLEANUP_FILE(tmp);
+
+            write(tmp,
+                  CompressedTLog::compress(tlogpath_,
+                                           tmp));
+        }
+        else
+        {
+            write(tlogpath_,
+                  checksum_);
+        }
+
         volume_->tlogWrittenToBackendCallback(tlogid_,
                                               sconame_);
     }
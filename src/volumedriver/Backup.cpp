@@ -14,6 +14,11 @@
 // but WITHOUT ANY WARRANTY of any kind.
 
 #include "Backup.h"
+#include "BackupSCOReadCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <list>
 
 #include <boost/dynamic_bitset.hpp>
 #include <boost/property_tree/info_parser.hpp>
@@ -35,6 +40,8 @@
 #include <volumedriver/VolumeThreadPool.h>
 #include <volumedriver/WriteOnlyVolume.h>
 #include <youtils/Catchers.h>
+#include <youtils/FileDescriptor.h>
+#include <youtils/ScopeExit.h>
 
 namespace volumedriver_backup
 {
@@ -45,6 +52,46 @@ using namespace volumedriver;
 class RetryCreateVolume
 {};
 
+namespace
+{
+
+DECLARE_LOGGER("BackupUtils");
+
+using SCOData = BackupSCOReadCache::Data;
+
+// the BackendInterface is not shared with the replay thread
+BackupSCOReadCache::ReadFun
+sco_reader(const BackupSCOReadCache::Key& key,
+           const BackendInterfacePtr& bi,
+           FilePool& file_pool)
+{
+    return [b = std::shared_ptr<BackendInterface>(bi->clone()),
+            name = key.second.str(),
+            &file_pool]() -> SCOData
+    {
+        const fs::path p(file_pool.tempFile("sco"));
+        auto on_exit(yt::make_scope_exit([&]
+                                         {
+                                             youtils::FileUtils::removeFileNoThrow(p);
+                                         }));
+
+        b->read(p,
+                name,
+                InsistOnLatestVersion::F);
+
+        youtils::FileDescriptor sio(p,
+                                    youtils::FDMode::Read);
+        auto data(std::make_shared<std::vector<byte>>(fs::file_size(p)));
+        const size_t res = sio.pread(data->data(),
+                                     data->size(),
+                                     0);
+        VERIFY(res == data->size());
+        return data;
+    };
+}
+
+}
+
 const uint64_t
 Backup::report_times_default_ = 120;
 
@@ -62,6 +109,9 @@ Backup::Backup(const boost::property_tree::ptree& config_ptree)
      , grace_period_(youtils::GracePeriod(boost::posix_time::seconds(configuration_ptree_.get<uint64_t>("grace_period_in_seconds",
                                                                                                         30))))
      , total_size_(0)
+     , sco_read_ahead_(configuration_ptree_.get<size_t>("sco_read_ahead", 4))
+     , sco_cache_size_(configuration_ptree_.get<size_t>("sco_cache_size", 8))
+     , max_write_size_(yt::DimensionedValue(configuration_ptree_.get<std::string>("max_write_size", "1MiB")).getBytes())
 {
     LOG_INFO("Report threshold is " << report_threshold);
     LOG_INFO("grace_period_in_seconds is " << static_cast<boost::posix_time::time_duration>(grace_period_));
@@ -679,12 +729,14 @@ Backup::replay_tlogs_on_target()
     const uint64_t cluster_size = source_volume_config->lba_size_ * source_volume_config->cluster_mult_;
 
     FileUtils::checkDirectoryEmptyOrNonExistant(tlogDir);
-    const fs::path the_sco = file_pool->newFile("the_sco");
-    // Y42
-    const unsigned MAX_SCO_SIZE = 3 * source_volume_config->sco_mult_
-        * source_volume_config->cluster_mult_ * source_volume_config->lba_size_;
-    std::vector<byte> buf(MAX_SCO_SIZE);
 
+    const uint64_t cluster_mult = source_volume_config->cluster_mult_;
+    const size_t max_write_clusters =
+        std::max<uint64_t>(1, max_write_size_ / cluster_size);
+
+    BackupSCOReadCache sco_cache(std::max<size_t>(sco_cache_size_,
+                                                  sco_read_ahead_ + 1));
+    std::vector<byte> write_buf(max_write_clusters * cluster_size);
 
     //    VERIFY(source_snapshot_persistor);
     // const uint64_t total_size(source_snapshot_persistor->getBackendSize(end_snapshot_name,
@@ -695,7 +747,54 @@ Backup::replay_tlogs_on_target()
     status_.start(target_volume_.get(),
                   total_size_);
 
-    LOG_INFO("Replaying the source tlogs on the target volume");
+    LOG_INFO("Replaying the source tlogs on the target volume, reading " <<
+             sco_read_ahead_ << " SCOs ahead, caching " << sco_cache_size_ <<
+             " SCOs, writes of up to " << max_write_clusters << " clusters");
+
+    uint64_t usleep_micro_sec = 100000;
+    const uint64_t ten_seconds = 10000000;
+
+    auto write([&](ClusterAddress ca,
+                   const byte* buf,
+                   size_t size)
+               {
+                   boost::this_thread::interruption_point();
+                   bool finished = false;
+                   while(not finished)
+                   {
+                       try
+                       {
+                           api::Write(target_volume_.get(),
+                                      ca * cluster_mult,
+                                      buf,
+                                      size);
+                           finished = true;
+                       }
+                       catch(TransientException& e)
+                       {
+                           LOG_INFO("Caught a transient exception while writing, sleeping for "
+                                    << usleep_micro_sec << " microseconds");
+                           usleep(usleep_micro_sec);
+                           if(usleep_micro_sec < ten_seconds)
+                           {
+                               usleep_micro_sec = std::min(usleep_micro_sec * 2, ten_seconds);
+                           }
+                       }
+                   }
+               });
+
+    auto discard([&](ClusterAddress ca,
+                     size_t num_clusters)
+                 {
+                     boost::this_thread::interruption_point();
+                     api::Discard(target_volume_.get(),
+                                  ca * cluster_mult,
+                                  num_clusters * cluster_size);
+                 });
+
+    using KeptEntry = std::pair<ClusterAddress, ClusterLocation>;
+    std::vector<KeptEntry> kept;
+    std::vector<ClusterAddress> discarded;
 
     // This has to change... there is no guarantee that the clonetlogs are filled up correctly
     // other than most of our code does is... should be a map
@@ -706,8 +805,7 @@ Backup::replay_tlogs_on_target()
         LOG_INFO("Working on Clone " << (int)(i->first));
 
         VERIFY(i->first < nsid.size());
-        uint64_t usleep_micro_sec = 100000;
-        const uint64_t ten_seconds = 10000000;
+        const BackendInterfacePtr& bi = nsid.get(i->first);
 
         for(OrderedTLogIds::const_reverse_iterator tlog_it = i->second.rbegin();
             tlog_it != i->second.rend();
@@ -716,18 +814,18 @@ Backup::replay_tlogs_on_target()
             LOG_INFO("Working on TLog " << *tlog_it);
             status_.current_tlog(*tlog_it);
 
+            // (1) Figure out which of the TLog's entries are still to be
+            // written - only the newest one for each cluster address.
             std::unique_ptr<TLogReaderInterface>
                 tlog_reader(new volumedriver::BackwardTLogReader(tlogDir,
                                                                  boost::lexical_cast<std::string>(*tlog_it),
-                                                                 nsid.get(i->first)->clone()));
-
-            SCO current_sco;
-            uint64_t current_sco_size = 0;
+                                                                 bi->clone()));
+            kept.clear();
+            discarded.clear();
 
             const Entry* entry = 0;
-            while((entry = tlog_reader->nextLocation()))
+            while((entry = tlog_reader->nextLocationOrDiscard()))
             {
-
                 boost::this_thread::interruption_point();
                 // Y42 do we do CRC checking here?
                 if(entry->isLocation())
@@ -739,54 +837,130 @@ Backup::replay_tlogs_on_target()
                     if(not cluster_bitset.test(cluster_address))
                     {
                         status_.add_kept();
+                        kept.emplace_back(cluster_address,
+                                          entry->clusterLocation());
+                        cluster_bitset[cluster_address] = 1;
+                    }
+                }
+                else if (entry->isDiscard())
+                {
+                    // older writes to it are dead, the target needs to forget
+                    // about them as well
+                    const ClusterAddress cluster_address = entry->clusterAddress();
+                    VERIFY(cluster_address < bitset_size);
+                    if(not cluster_bitset.test(cluster_address))
+                    {
+                        discarded.push_back(cluster_address);
+                        cluster_bitset[cluster_address] = 1;
+                    }
+                }
+            }
 
-                        const ClusterLocation cluster_location(entry->clusterLocation());
-                        const SCO looking_at_sco(cluster_location.sco());
-
-                        if(looking_at_sco != current_sco)
-                        {
-                            nsid.get(i->first)->read(the_sco,
-                                                     looking_at_sco.str(),
-                                                     InsistOnLatestVersion::F);
-                            ALWAYS_CLEANUP_FILE(the_sco);
-
-                            current_sco_size = fs::file_size(the_sco);
-                            VERIFY(current_sco_size <= buf.size());
-                            youtils::FileDescriptor sio(the_sco, youtils::FDMode::Read);
-                            const ssize_t res = sio.read(&buf[0], current_sco_size);
-                            VERIFY(res == static_cast<ssize_t>(current_sco_size));
-                            current_sco = looking_at_sco;
-                        }
-
-                        VERIFY((cluster_location.offset() + 1) * cluster_size <= current_sco_size);
-                        boost::this_thread::interruption_point();
-                        bool finished = false;
-                        while(not finished)
-                        {
-                            try
-                            {
-                                api::Write(target_volume_.get(),
-                                           cluster_address << 3,
-                                           &buf[0] + (cluster_location.offset() * cluster_size),
-                                           cluster_size);
-                                finished = true;
-                            }
-                            catch(TransientException& e)
-                            {
-                                LOG_INFO("Caught a transient exception while writing, sleeping for "
-                                         << usleep_micro_sec << " microseconds");
-                                usleep(usleep_micro_sec);
-                                if(usleep_micro_sec < ten_seconds)
-                                {
-                                    usleep_micro_sec = std::min(usleep_micro_sec * 2, ten_seconds);
-                                }
-                            }
-                        }
+            tlog_reader.reset();
+
+            // (2) The kept entries all have different cluster addresses, so the
+            // order they're written in does not matter: go through them SCO by
+            // SCO - each one is only read once and the next ones are read while
+            // writing out the current one - and by cluster address within a SCO
+            // so adjacent clusters can be written at once.
+            std::sort(kept.begin(),
+                      kept.end(),
+                      [](const KeptEntry& a,
+                         const KeptEntry& b)
+                      {
+                          const SCO sa(a.second.sco());
+                          const SCO sb(b.second.sco());
+                          return sa < sb or (sa == sb and a.first < b.first);
+                      });
+
+            std::vector<size_t> sco_starts;
+            for (size_t k = 0; k < kept.size(); ++k)
+            {
+                if (k == 0 or kept[k].second.sco() != kept[k - 1].second.sco())
+                {
+                    sco_starts.push_back(k);
+                }
+            }
+            sco_starts.push_back(kept.size());
 
-                        cluster_bitset[cluster_address] = 1;
+            const size_t num_scos = sco_starts.size() - 1;
+
+            auto key([&](size_t j) -> BackupSCOReadCache::Key
+                     {
+                         return BackupSCOReadCache::Key(i->first,
+                                                        kept[sco_starts[j]].second.sco());
+                     });
+
+            for (size_t j = 0; j < std::min(sco_read_ahead_, num_scos); ++j)
+            {
+                sco_cache.prefetch(key(j),
+                                   sco_reader(key(j),
+                                              bi,
+                                              *file_pool));
+            }
+
+            for (size_t j = 0; j < num_scos; ++j)
+            {
+                if (j + sco_read_ahead_ < num_scos)
+                {
+                    sco_cache.prefetch(key(j + sco_read_ahead_),
+                                       sco_reader(key(j + sco_read_ahead_),
+                                                  bi,
+                                                  *file_pool));
+                }
+
+                boost::this_thread::interruption_point();
+                const SCOData sco_data(sco_cache.get(key(j),
+                                                     sco_reader(key(j),
+                                                                bi,
+                                                                *file_pool)));
+
+                for (size_t k = sco_starts[j]; k < sco_starts[j + 1]; )
+                {
+                    const ClusterAddress start_ca = kept[k].first;
+                    size_t num_clusters = 0;
+
+                    do
+                    {
+                        const ClusterLocation& loc = kept[k].second;
+                        VERIFY((loc.offset() + 1) * cluster_size <= sco_data->size());
+                        memcpy(write_buf.data() + num_clusters * cluster_size,
+                               sco_data->data() + loc.offset() * cluster_size,
+                               cluster_size);
+                        ++num_clusters;
+                        ++k;
                     }
+                    while (k < sco_starts[j + 1] and
+                           num_clusters < max_write_clusters and
+                           kept[k].first == start_ca + num_clusters);
+
+                    write(start_ca,
+                          write_buf.data(),
+                          num_clusters * cluster_size);
                 }
             }
+
+            // (3) Discards - again distinct cluster addresses, so they can be
+            // issued after the writes and in ranges.
+            std::sort(discarded.begin(),
+                      discarded.end());
+
+            for (size_t k = 0; k < discarded.size(); )
+            {
+                const ClusterAddress start_ca = discarded[k];
+                size_t num_clusters = 0;
+
+                do
+                {
+                    ++num_clusters;
+                    ++k;
+                }
+                while (k < discarded.size() and
+                       discarded[k] == start_ca + num_clusters);
+
+                discard(start_ca,
+                        num_clusters);
+            }
         }
     }
 
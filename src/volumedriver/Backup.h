@@ -156,6 +156,14 @@ public:
     const youtils::GracePeriod grace_period_;
     uint64_t total_size_;
 
+private:
+    // SCOs read from the source ahead of the one being replayed
+    const size_t sco_read_ahead_;
+    // SCOs kept in memory (including the ones being read)
+    const size_t sco_cache_size_;
+    // adjacent clusters are coalesced into target writes of up to this size
+    const uint64_t max_write_size_;
+
 };
 
 }
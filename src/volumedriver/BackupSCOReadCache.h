@@ -0,0 +1,168 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+#ifndef VOLUMEDRIVER_BACKUP_SCO_READ_CACHE_H_
+#define VOLUMEDRIVER_BACKUP_SCO_READ_CACHE_H_
+
+#include "SCO.h"
+#include "Types.h"
+
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include <youtils/Assert.h>
+#include <youtils/Logging.h>
+
+namespace volumedriver_backup
+{
+
+// SCOs read from the source for the replay, by clone and SCO. Reads are started
+// ahead of the replay (`prefetch') and run asynchronously. At most `capacity'
+// SCOs (read or still being read) are kept. SCOs the replay already got are
+// dropped first (least recently gotten first) so they cannot push out the ones
+// read ahead; only if there are none the oldest read is dropped. Prefetching a
+// SCO that was already gotten protects it again.
+class BackupSCOReadCache
+{
+public:
+    using Key = std::pair<volumedriver::SCOCloneID, volumedriver::SCO>;
+    using Data = std::shared_ptr<const std::vector<byte>>;
+    // Only invoked on a miss, on a thread of its own.
+    using ReadFun = std::function<Data()>;
+
+    explicit BackupSCOReadCache(size_t capacity)
+        : capacity_(capacity)
+    {
+        VERIFY(capacity_ > 0);
+    }
+
+    // Dropping an entry waits for its read to finish, which is exactly what we
+    // want on destruction too since the reads might use resources of the caller.
+    ~BackupSCOReadCache() = default;
+
+    BackupSCOReadCache(const BackupSCOReadCache&) = delete;
+
+    BackupSCOReadCache&
+    operator=(const BackupSCOReadCache&) = delete;
+
+    void
+    prefetch(const Key& key,
+             ReadFun fun)
+    {
+        find_or_read_(key,
+                      std::move(fun));
+    }
+
+    Data
+    get(const Key& key,
+        ReadFun fun)
+    {
+        auto it(find_or_read_(key,
+                              std::move(fun)));
+        it->consumed = true;
+        // keep the consumed ones in the order they were gotten in
+        entries_.splice(entries_.end(),
+                        entries_,
+                        it);
+        return it->data.get();
+    }
+
+    size_t
+    size() const
+    {
+        return entries_.size();
+    }
+
+private:
+    DECLARE_LOGGER("BackupSCOReadCache");
+
+    struct Entry
+    {
+        Entry(const Key& k,
+              std::shared_future<Data> d)
+            : key(k)
+            , data(std::move(d))
+            , consumed(false)
+        {}
+
+        Key key;
+        std::shared_future<Data> data;
+        bool consumed;
+    };
+
+    const size_t capacity_;
+
+    // oldest first
+    std::list<Entry> entries_;
+
+    void
+    evict_()
+    {
+        for (auto it = entries_.begin(); it != entries_.end(); ++it)
+        {
+            if (it->consumed)
+            {
+                entries_.erase(it);
+                return;
+            }
+        }
+
+        entries_.pop_front();
+    }
+
+    std::list<Entry>::iterator
+    find_or_read_(const Key& key,
+                  ReadFun fun)
+    {
+        for (auto it = entries_.begin(); it != entries_.end(); ++it)
+        {
+            if (it->key == key)
+            {
+                if (it->consumed)
+                {
+                    it->consumed = false;
+                    entries_.splice(entries_.end(),
+                                    entries_,
+                                    it);
+                }
+                return it;
+            }
+        }
+
+        while (entries_.size() >= capacity_)
+        {
+            evict_();
+        }
+
+        LOG_INFO("Reading SCO " << key.second << " of clone " <<
+                 static_cast<int>(key.first));
+
+        entries_.emplace_back(key,
+                              std::async(std::launch::async,
+                                         std::move(fun)).share());
+        return std::prev(entries_.end());
+    }
+};
+
+}
+
+#endif // !VOLUMEDRIVER_BACKUP_SCO_READ_CACHE_H_
+
+// Local Variables: **
+// mode: c++ **
+// End: **
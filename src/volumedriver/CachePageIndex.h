@@ -0,0 +1,206 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+#ifndef CACHE_PAGE_INDEX_H_
+#define CACHE_PAGE_INDEX_H_
+
+#include "Types.h"
+
+#include <limits>
+#include <vector>
+
+#include <youtils/Assert.h>
+
+namespace volumedriver
+{
+
+// Flat open addressing (linear probing) hash table mapping the PageAddresses of
+// the pages resident in a CachedMetaDataStore to their slot in its page array.
+// The number of buckets is a power of two of at least twice the capacity, keeping
+// the load factor <= 0.5 and hence probe sequences short. Removal uses backward
+// shift deletion so there are no tombstones to take care of.
+// Not thread safe - locking is up to the user.
+class CachePageIndex
+{
+public:
+    using Slot = uint32_t;
+
+    static constexpr Slot npos = std::numeric_limits<Slot>::max();
+
+    explicit CachePageIndex(size_t capacity = 0)
+    {
+        reset(capacity);
+    }
+
+    ~CachePageIndex() = default;
+
+    CachePageIndex(const CachePageIndex&) = delete;
+
+    CachePageIndex&
+    operator=(const CachePageIndex&) = delete;
+
+    void
+    reset(size_t capacity)
+    {
+        VERIFY(capacity < npos);
+
+        size_t n = 1;
+        shift_ = 64;
+
+        while (n < 2 * capacity)
+        {
+            n <<= 1;
+            --shift_;
+        }
+
+        buckets_.clear();
+        buckets_.resize(n);
+        buckets_.shrink_to_fit();
+        mask_ = n - 1;
+        size_ = 0;
+    }
+
+    void
+    clear()
+    {
+        for (auto& b : buckets_)
+        {
+            b.slot = npos;
+        }
+
+        size_ = 0;
+    }
+
+    Slot
+    find(const PageAddress pa) const
+    {
+        for (size_t i = bucket_(pa); true; i = (i + 1) & mask_)
+        {
+            const Bucket& b = buckets_[i];
+            if (b.slot == npos or b.pa == pa)
+            {
+                return b.slot;
+            }
+        }
+    }
+
+    void
+    insert(const PageAddress pa,
+           const Slot slot)
+    {
+        ASSERT(slot != npos);
+        VERIFY(2 * (size_ + 1) <= buckets_.size());
+
+        for (size_t i = bucket_(pa); true; i = (i + 1) & mask_)
+        {
+            Bucket& b = buckets_[i];
+            if (b.slot == npos)
+            {
+                b.pa = pa;
+                b.slot = slot;
+                ++size_;
+                return;
+            }
+
+            VERIFY(b.pa != pa);
+        }
+    }
+
+    bool
+    erase(const PageAddress pa)
+    {
+        size_t i = bucket_(pa);
+
+        while (true)
+        {
+            if (buckets_[i].slot == npos)
+            {
+                return false;
+            }
+            else if (buckets_[i].pa == pa)
+            {
+                break;
+            }
+
+            i = (i + 1) & mask_;
+        }
+
+        // Backward shift: move subsequent entries of the cluster that are not
+        // at their home bucket into the hole.
+        size_t j = i;
+        while (true)
+        {
+            buckets_[i].slot = npos;
+
+            while (true)
+            {
+                j = (j + 1) & mask_;
+                if (buckets_[j].slot == npos)
+                {
+                    --size_;
+                    return true;
+                }
+
+                const size_t k = bucket_(buckets_[j].pa);
+                // is k cyclically in (i, j]? If so the entry has to stay.
+                if (i <= j ? (i < k and k <= j) : (i < k or k <= j))
+                {
+                    continue;
+                }
+
+                break;
+            }
+
+            buckets_[i] = buckets_[j];
+            i = j;
+        }
+    }
+
+    size_t
+    size() const
+    {
+        return size_;
+    }
+
+private:
+    struct Bucket
+    {
+        PageAddress pa = 0;
+        Slot slot = npos;
+    };
+
+    std::vector<Bucket> buckets_;
+    size_t mask_;
+    unsigned shift_;
+    size_t size_;
+
+    // Fibonacci hashing - PageAddresses of a volume are mostly dense, the
+    // multiplication spreads them over the upper bits.
+    size_t
+    bucket_(const PageAddress pa) const
+    {
+        return shift_ == 64 ?
+            0 :
+            (pa * 0x9E3779B97F4A7C15ULL) >> shift_;
+    }
+};
+
+}
+
+#endif // !CACHE_PAGE_INDEX_H_
+
+// Local Variables: **
+// mode: c++ **
+// End: **
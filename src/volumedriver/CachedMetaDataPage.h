@@ -20,21 +20,13 @@
 #include "Types.h"
 
 #include <boost/thread/mutex.hpp>
-#include <boost/intrusive/set.hpp>
-#include <boost/intrusive/list.hpp>
 
 namespace volumedriver
 {
-namespace bi = boost::intrusive;
-
-typedef bi::list_base_hook<bi::link_mode<bi::auto_unlink> > list_base_hook;
-typedef bi::set_base_hook<bi::link_mode<bi::auto_unlink> > set_base_hook;
 
 // Uses malloc/free for the data_ member as it interfaces with C libs
 // (tokyocabinet, crakoon)
 class CachePage
-    : public list_base_hook
-    , public set_base_hook
 {
 public:
     explicit CachePage(const PageAddress& pa,
@@ -93,30 +85,6 @@ public:
 
     ~CachePage() = default;
 
-    inline void
-    unlink_from_list()
-    {
-        list_base_hook::unlink();
-    }
-
-    inline void
-    unlink_from_set()
-    {
-        set_base_hook::unlink();
-    }
-
-    inline bool
-    is_in_list() const
-    {
-        return list_base_hook::is_linked();
-    }
-
-    inline bool
-    is_in_set() const
-    {
-        return set_base_hook::is_linked();
-    }
-
     bool
     operator>(const CachePage& rhs) const
     {
@@ -16,6 +16,7 @@
 #include "CachedMetaDataStore.h"
 #include "ClusterLocationAndHash.h"
 #include "CombinedTLogReader.h"
+#include "ExternalPageSortingGenerator.h"
 #include "PageSortingGenerator.h"
 #include "RelocationReaderFactory.h"
 #include "TLog.h"
@@ -23,6 +24,9 @@
 #include "VolManager.h"
 #include "VolumeConfig.h"
 
+#include <algorithm>
+#include <limits>
+
 #include <boost/foreach.hpp>
 #include <boost/scope_exit.hpp>
 
@@ -66,12 +70,15 @@ namespace yt = youtils;
     ASSERT(not backend_lock_.try_lock());
 
 uint64_t CachedMetaDataStore::replayClustersCached = 8000000;
+uint64_t CachedMetaDataStore::bulkLoadRunEntries = 4000000;
 
 CachedMetaDataStore::CachedMetaDataStore(const MetaDataBackendInterfacePtr& backend,
                                          const std::string& id,
                                          uint64_t capacity)
     : backend_(backend)
     , page_data_(capacity * CachePage::capacity())
+    , clock_hand_(0)
+    , next_sequential_miss_(std::numeric_limits<PageAddress>::max())
     , num_pages_(0)
     , cache_hits_(0)
     , cache_misses_(0)
@@ -107,6 +114,16 @@ CachedMetaDataStore::init_pages_(size_t capacity)
         pages_.emplace_back(i, &page_data_[i * CachePage::capacity()]);
     }
 
+    page_index_.reset(capacity);
+    referenced_.reset(new std::atomic<bool>[capacity]);
+
+    for (uint64_t i = 0; i < capacity; ++i)
+    {
+        referenced_[i] = false;
+    }
+
+    clock_hand_ = 0;
+
     LOG_INFO(id_ <<
              ": page capacity (entries): " << CachePage::capacity() <<
              ", max cached pages: " << pages_.size());
@@ -123,10 +140,10 @@ CachedMetaDataStore::readCluster(const ClusterAddress caddr,
         //        ASSERT(not corks_.empty());
         BOOST_REVERSE_FOREACH(const cork_t& crk, corks_)
         {
-            ca_loc_map_type::const_iterator it = crk.second->find(caddr);
-            if(it != crk.second->end())
+            const ClusterLocationAndHash* clh = crk.second->find(caddr);
+            if (clh)
             {
-                loc = it->second;
+                loc = *clh;
                 cache_hits_++;
                 LOG_TRACE(id_ << ": ca " << caddr << " -> loc: " << loc);
                 return;
@@ -134,7 +151,10 @@ CachedMetaDataStore::readCluster(const ClusterAddress caddr,
         }
     }
 
-    get_cluster_location_(caddr, loc, false);
+    if (not try_read_cached_cluster_location_(caddr, loc))
+    {
+        get_cluster_location_(caddr, loc, false);
+    }
 
     if (ClusterLocationAndHash::use_hash() and loc.clusterLocation.isNull())
     {
@@ -150,6 +170,121 @@ CachedMetaDataStore::readCluster(const ClusterAddress caddr,
     LOG_TRACE(id_ << ": ca " << caddr << " -> loc: " << loc);
 }
 
+void
+CachedMetaDataStore::readClusters(const ClusterAddress start,
+                                  const size_t count,
+                                  ClusterLocationAndHash* locs)
+{
+    LOG_TRACE(id_ << ": ca " << start << ", count " << count);
+
+    std::vector<bool> corked(count, false);
+
+    {
+        LOCK_CORKS_READ;
+
+        BOOST_REVERSE_FOREACH(const cork_t& crk, corks_)
+        {
+            crk.second->for_each_in_range(start,
+                                          count,
+                                          [&](const ClusterAddress ca,
+                                              const ClusterLocationAndHash& loc)
+                                          {
+                                              const size_t i = ca - start;
+                                              if (not corked[i])
+                                              {
+                                                  locs[i] = loc;
+                                                  corked[i] = true;
+                                                  ++cache_hits_;
+                                              }
+                                          });
+        }
+    }
+
+    // Resolve the remaining clusters page by page.
+    size_t off = 0;
+    while (off < count)
+    {
+        const ClusterAddress ca = start + off;
+        const size_t n =
+            std::min<size_t>(count - off,
+                             CachePage::capacity() - CachePage::offset(ca));
+
+        read_page_entries_(ca,
+                           n,
+                           locs + off,
+                           corked.begin() + off);
+        off += n;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        // cf. readCluster
+        if (ClusterLocationAndHash::use_hash() and locs[i].clusterLocation.isNull())
+        {
+            locs[i] = ClusterLocationAndHash::discarded_location_and_hash();
+        }
+    }
+}
+
+// Fills in the non-corked entries of [start, start + count) which must not
+// straddle a page boundary. The cache stats are updated as if each entry was
+// looked up separately.
+void
+CachedMetaDataStore::read_page_entries_(const ClusterAddress start,
+                                        const size_t count,
+                                        ClusterLocationAndHash* locs,
+                                        std::vector<bool>::const_iterator corked)
+{
+    ASSERT(CachePage::offset(start) + count <= CachePage::capacity());
+
+    const size_t needed = std::count(corked, corked + count, false);
+    if (needed == 0)
+    {
+        return;
+    }
+
+    auto copy([&](const CachePage& page)
+              {
+                  for (size_t i = 0; i < count; ++i)
+                  {
+                      if (not corked[i])
+                      {
+                          locs[i] = page[CachePage::offset(start + i)];
+                      }
+                  }
+              });
+
+    {
+        LOCK_CACHE_READ;
+
+        const CachePageIndex::Slot slot =
+            page_index_.find(CachePage::pageAddress(start));
+
+        if (slot != CachePageIndex::npos)
+        {
+            ASSERT(slot < num_pages_);
+            copy(pages_[slot]);
+
+            if (not referenced_[slot].load(std::memory_order_relaxed))
+            {
+                referenced_[slot].store(true, std::memory_order_relaxed);
+            }
+
+            cache_hits_ += needed;
+            return;
+        }
+    }
+
+    LOCK_CACHE_WRITE;
+
+    CachePage* page;
+    std::tie(page, std::ignore) = get_page_(start);
+    ASSERT(page);
+
+    copy(*page);
+    cache_hits_ += needed - 1;
+}
+
 // must not be called concurrently by consumers.
 void
 CachedMetaDataStore::writeCluster(const ClusterAddress caddr,
@@ -159,7 +294,23 @@ CachedMetaDataStore::writeCluster(const ClusterAddress caddr,
 
     LOCK_CORKS_WRITE;
     ASSERT(not corks_.empty());
-    (*corks_.back().second)[caddr] = loc;
+    corks_.back().second->set(caddr, loc);
+}
+
+void
+CachedMetaDataStore::writeClusters(const ClusterAddress* caddrs,
+                                   const ClusterLocationAndHash* locs,
+                                   const size_t count)
+{
+    LOG_TRACE(id_ << ": count " << count);
+
+    LOCK_CORKS_WRITE;
+    ASSERT(not corks_.empty());
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        corks_.back().second->set(caddrs[i], locs[i]);
+    }
 }
 
 void
@@ -333,13 +484,13 @@ CachedMetaDataStore::unCork(const boost::optional<yt::UUID>& cork)
             m = corks_.front().second;
         }
 
-        for (const auto& val : *m)
+        // Apply the entries in ClusterAddress (and hence page) order.
+        for (const auto& val : m->sorted())
         {
             // AR: why is this here? The corked entries (map) itself should not be
             // modified (see above, and if it was, the whole loop would have to be locked)?
             LOCK_CORKS_READ;
             // Y42 not correct, just write to the own cache
-            // Ordening here might be better
             if (not get_cluster_location_(val.first, const_cast<ClusterLocationAndHash&>(val.second), true))
             {
                 misses++;
@@ -353,9 +504,9 @@ CachedMetaDataStore::unCork(const boost::optional<yt::UUID>& cork)
         uint32_t dirty_count = 0;
 
         LOCK_CACHE_READ;
-        for (CachePage& p : page_list_)
+        for (size_t i = 0; i < num_pages_; ++i)
         {
-            if (maybeWritePage_locked_context(p, false))
+            if (maybeWritePage_locked_context(pages_[i], false))
             {
                 dirty_count++;
             }
@@ -405,27 +556,85 @@ CachedMetaDataStore::processCloneTLogs(const CloneTLogs& ctl,
         std::shared_ptr<TLogReaderInterface>
             r(CombinedTLogReader::create(tlog_path,
                                          tlogs,
-                                         nsidmap.get(cloneid)->clone()));
+                                         nsidmap.get(cloneid)->clone(),
+                                         CombinedTLogReader::FetchStrategy::Parallel));
         processTLogReaderInterface(r, cloneid);
     }
 
     if(sync)
     {
-        LOCK_CACHE_WRITE;
+        write_pages_and_set_cork_(cork);
+    }
 
-        for (CachePage& p : page_list_)
-        {
-            maybeWritePage_locked_context(p, false);
-        }
+    cork_uuid_ = cork;
+}
+
+void
+CachedMetaDataStore::write_pages_and_set_cork_(const boost::optional<yt::UUID>& cork)
+{
+    LOCK_CACHE_WRITE;
+
+    for (size_t i = 0; i < num_pages_; ++i)
+    {
+        maybeWritePage_locked_context(pages_[i], false);
+    }
+
+    if (cork != boost::none)
+    {
+        LOCK_BACKEND;
+        backend_->setCork(*cork);
+        backend_->sync();
+    }
+}
+
+void
+CachedMetaDataStore::bulkLoadCloneTLogs(const CloneTLogs& ctl,
+                                        const NSIDMap& nsidmap,
+                                        const fs::path& tlog_path,
+                                        const boost::optional<yt::UUID>& cork)
+{
+    LOCK_CORKS_WRITE;
+
+    VERIFY(corks_.size() == 0 or
+           (corks_.size() == 1 and
+            corks_.front().second->empty()));
+
+    LOG_INFO(id_ << ": bulk loading TLogs of " << ctl.size() << " clone(s)");
+
+    std::unique_ptr<yt::Generator<PageDataPtr>>
+        g(new ExternalPageSortingGenerator(ctl,
+                                           nsidmap,
+                                           tlog_path,
+                                           tlog_path,
+                                           bulkLoadRunEntries));
 
-        if (cork != boost::none)
+    // pages are handed out in ascending order and only once, so with the
+    // CLOCK eviction each page is written to the backend only once as well
+    g.reset(new yt::ThreadedGenerator<PageDataPtr>(std::move(g),
+                                                   replayPagesQueued));
+
+    uint64_t pages = 0;
+    uint64_t entries = 0;
+
+    while (not g->finished())
+    {
+        for (const Entry& e : *g->current())
         {
-            LOCK_BACKEND;
-            backend_->setCork(*cork);
-            backend_->sync();
+            ClusterLocationAndHash loc(e.clusterLocationAndHash());
+            get_cluster_location_(e.clusterAddress(),
+                                  loc,
+                                  true);
+            ++entries;
         }
+
+        ++pages;
+        g->next();
     }
 
+    LOG_INFO(id_ << ": bulk load finished, " << entries << " entries written to " <<
+             pages << " pages");
+
+    write_pages_and_set_cork_(cork);
     cork_uuid_ = cork;
 }
 
@@ -445,7 +654,10 @@ CachedMetaDataStore::processPages(std::unique_ptr<yt::Generator<PageDataPtr>> r,
         for (const Entry& e : m)
         {
             ClusterLocationAndHash loc = e.clusterLocationAndHash();
-            loc.clusterLocation.cloneID(cloneid);
+            if (not e.isDiscard())
+            {
+                loc.clusterLocation.cloneID(cloneid);
+            }
             get_cluster_location_(e.clusterAddress(),
                                   const_cast<ClusterLocationAndHash&>(loc),
                                   true);
@@ -487,12 +699,14 @@ void
 CachedMetaDataStore::do_write_dirty_pages_to_backend_and_clear_page_list(bool sync,
                                                                          bool ignore_errors)
 {
-    while (not page_list_.empty())
+    ASSERT_CACHE_WRITE_LOCKED;
+
+    while (num_pages_ > 0)
     {
-        CachePage& p(page_list_.front());
+        CachePage& p(pages_[num_pages_ - 1]);
 
-        p.unlink_from_list();
-        p.unlink_from_set();
+        page_index_.erase(p.page_address());
+        referenced_[num_pages_ - 1] = false;
         --num_pages_;
 
         if (sync)
@@ -501,8 +715,8 @@ CachedMetaDataStore::do_write_dirty_pages_to_backend_and_clear_page_list(bool sy
         }
     }
 
-    ASSERT(page_map_.empty());
-    ASSERT(num_pages_ == 0);
+    ASSERT(page_index_.size() == 0);
+    clock_hand_ = 0;
 
     for (auto& p : pages_)
     {
@@ -515,8 +729,9 @@ CachedMetaDataStore::write_dirty_pages_to_backend_keeping_page_list()
 {
     LOCK_CACHE_WRITE;
 
-    for (auto& page : page_list_)
+    for (size_t i = 0; i < num_pages_; ++i)
     {
+        CachePage& page = pages_[i];
         if(page.dirty and not page.empty())
         {
             maybeWritePage_locked_context(page, false);
@@ -527,28 +742,6 @@ CachedMetaDataStore::write_dirty_pages_to_backend_keeping_page_list()
     }
 }
 
-namespace
-{
-
-struct PageCmp
-{
-    bool
-    operator()(const PageAddress& pa,
-               const CachePage& cp) const
-    {
-        return pa < cp.page_address();
-    }
-
-    bool
-    operator()(const CachePage& cp,
-               const PageAddress& pa) const
-    {
-        return cp.page_address() < pa;
-    }
-};
-
-}
-
 uint64_t
 CachedMetaDataStore::applyRelocs(RelocationReaderFactory& factory,
                                  SCOCloneID scid,
@@ -654,59 +847,168 @@ CachedMetaDataStore::set_cache_capacity(const size_t new_capacity)
 std::pair<CachePage*, bool>
 CachedMetaDataStore::get_page_(const ClusterAddress ca)
 {
+    ASSERT_CACHE_WRITE_LOCKED;
+
     const PageAddress pa = CachePage::pageAddress(ca);
-    bool hit = false;
+    const CachePageIndex::Slot slot = page_index_.find(pa);
 
-    CachePage* page;
-    auto it = page_map_.find(pa,
-                             PageCmp());
-    if (it == page_map_.end())
+    if (slot != CachePageIndex::npos)
+    {
+        ASSERT(slot < num_pages_);
+        ++cache_hits_;
+        referenced_[slot] = true;
+        return std::make_pair(&pages_[slot], true);
+    }
+
+    ++cache_misses_;
+
+    std::vector<PageAddress> pas{ pa };
+
+    // Readahead on sequential misses, limited to half of the cache so the pages
+    // fetched in one go don't evict each other.
+    if (pa == next_sequential_miss_)
     {
-        ++cache_misses_;
+        const size_t readahead =
+            std::min<size_t>(VolManager::get()->metadata_cache_readahead_pages.value(),
+                             pages_.size() / 2);
 
-        if (num_pages_ < pages_.size())
+        for (size_t i = 1; i <= readahead; ++i)
         {
-            page = &pages_[num_pages_];
+            if (page_index_.find(pa + i) == CachePageIndex::npos)
+            {
+                pas.push_back(pa + i);
+            }
+        }
+    }
+
+    fetch_pages_(pas);
+    next_sequential_miss_ = pas.back() + 1;
+
+    const CachePageIndex::Slot new_slot = page_index_.find(pa);
+    VERIFY(new_slot != CachePageIndex::npos);
+
+    return std::make_pair(&pages_[new_slot], false);
+}
+
+// The pages are fetched from the backend before any slot is touched as a
+// failure would otherwise leave an evicted slot behind that's not in the index.
+void
+CachedMetaDataStore::fetch_pages_(const std::vector<PageAddress>& pas)
+{
+    ASSERT_CACHE_WRITE_LOCKED;
+    ASSERT(not pas.empty());
+    VERIFY(pas.size() <= pages_.size());
+
+    std::vector<ClusterLocationAndHash> data(pas.size() * CachePage::capacity());
+    std::vector<CachePage> tmp;
+    tmp.reserve(pas.size());
+
+    std::vector<CachePage*> ptrs;
+    ptrs.reserve(pas.size());
+
+    for (size_t i = 0; i < pas.size(); ++i)
+    {
+        tmp.emplace_back(pas[i], &data[i * CachePage::capacity()]);
+        ptrs.push_back(&tmp.back());
+    }
+
+    const std::vector<bool> found(pas.size() == 1 ?
+                                  std::vector<bool>{ backend_->getPage(tmp[0]) } :
+                                  backend_->getPages(ptrs));
+    VERIFY(found.size() == pas.size());
+
+    std::vector<CachePageIndex::Slot> slots;
+    slots.reserve(pas.size());
+
+    for (size_t i = 0; i < pas.size(); ++i)
+    {
+        const CachePageIndex::Slot slot =
+            num_pages_ < pages_.size() ? num_pages_ : evict_page_();
+
+        CachePage* page = &pages_[slot];
+        ASSERT(not page->dirty);
+
+        page = new(page) CachePage(pas[i], page->data());
+        if (found[i])
+        {
+            memcpy(page->data(), tmp[i].data(), CachePage::size());
         }
         else
         {
-            page = &page_list_.front();
-            page->unlink_from_list();
-            page->unlink_from_set();
-            --num_pages_;
-            maybeWritePage_locked_context(*page, false);
+            page->reset();
         }
 
-        ASSERT(not page->dirty);
-        ASSERT(not page->is_in_set());
-        ASSERT(not page->is_in_list());
-        ASSERT(num_pages_ < pages_.size());
-
-        page = new(page) CachePage(pa, page->data());
+        page_index_.insert(pas[i], slot);
+        // keeps the CLOCK sweep from evicting pages of this batch
+        referenced_[slot] = true;
 
-        const bool found = backend_->getPage(*page);
-        if (not found)
+        if (slot == num_pages_)
         {
-            page->reset();
+            ++num_pages_;
         }
 
-        page_map_.insert(*page);
-        ++num_pages_;
+        slots.push_back(slot);
     }
-    else
+
+    for (const auto slot : slots)
     {
-        ++cache_hits_;
-        hit = true;
-        page = &(*it);
-        page->unlink_from_list();
+        referenced_[slot] = false;
     }
+}
+
+// CLOCK: sweep over the slots, giving referenced pages a second chance.
+// The victim is written out before it's removed from the index s.t. it stays
+// accessible if that fails.
+CachePageIndex::Slot
+CachedMetaDataStore::evict_page_()
+{
+    ASSERT_CACHE_WRITE_LOCKED;
+    ASSERT(num_pages_ == pages_.size());
 
-    ASSERT(not page->is_in_list());
-    ASSERT(page->is_in_set());
+    while (true)
+    {
+        const size_t slot = clock_hand_;
+        clock_hand_ = (clock_hand_ + 1) % num_pages_;
+
+        if (not referenced_[slot].exchange(false))
+        {
+            CachePage& page = pages_[slot];
+            maybeWritePage_locked_context(page, false);
 
-    page_list_.push_back(*page);
+            const bool erased = page_index_.erase(page.page_address());
+            VERIFY(erased);
 
-    return std::make_pair(page, hit);
+            return slot;
+        }
+    }
+}
+
+bool
+CachedMetaDataStore::try_read_cached_cluster_location_(const ClusterAddress ca,
+                                                       ClusterLocationAndHash& loc)
+{
+    LOCK_CACHE_READ;
+
+    const CachePageIndex::Slot slot =
+        page_index_.find(CachePage::pageAddress(ca));
+
+    if (slot == CachePageIndex::npos)
+    {
+        return false;
+    }
+    else
+    {
+        ASSERT(slot < num_pages_);
+        loc = pages_[slot][CachePage::offset(ca)];
+
+        if (not referenced_[slot].load(std::memory_order_relaxed))
+        {
+            referenced_[slot].store(true, std::memory_order_relaxed);
+        }
+
+        ++cache_hits_;
+        return true;
+    }
 }
 
 std::vector<ClusterLocation>
@@ -731,13 +1033,13 @@ CachedMetaDataStore::get_page(const ClusterAddress ca)
 
         for (const auto& cork : corks_)
         {
-            for (const auto& p : *cork.second)
-            {
-                if (p.first >= ca_start and p.first < ca_end)
-                {
-                    tmp[CachePage::offset(p.first)] = p.second;
-                }
-            }
+            cork.second->for_each_in_range(ca_start,
+                                           ca_end - ca_start,
+                                           [&](const ClusterAddress ca,
+                                               const ClusterLocationAndHash& clh)
+                                           {
+                                               tmp[CachePage::offset(ca)] = clh;
+                                           });
         }
     }
 
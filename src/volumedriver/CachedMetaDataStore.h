@@ -16,13 +16,16 @@
 #ifndef CACHED_METADATA_STORE_H_
 #define CACHED_METADATA_STORE_H_
 
+#include "CachePageIndex.h"
 #include "CachedMetaDataPage.h"
+#include "CorkedClusters.h"
 #include "MetaDataBackendInterface.h"
 #include "MetaDataStoreInterface.h"
 #include "PageSortingGenerator.h"
 #include "ScrubId.h"
 #include "Types.h"
 
+#include <atomic>
 #include <memory>
 
 #include <boost/thread/locks.hpp>
@@ -78,11 +81,22 @@ public:
     readCluster(const ClusterAddress caddr,
                 ClusterLocationAndHash& loc) override final;
 
+    virtual void
+    readClusters(const ClusterAddress start,
+                 const size_t count,
+                 ClusterLocationAndHash* locs) override final;
+
     // must not be called concurrently by consumers.
     virtual void
     writeCluster(const ClusterAddress caddr,
                  const ClusterLocationAndHash& loc) override final;
 
+    // must not be called concurrently by consumers.
+    virtual void
+    writeClusters(const ClusterAddress* caddrs,
+                  const ClusterLocationAndHash* locs,
+                  const size_t count) override final;
+
     virtual void
     clear_all_keys() override final;
 
@@ -126,6 +140,12 @@ public:
                       bool sync,
                       const boost::optional<youtils::UUID>& uuid) override final;
 
+    virtual void
+    bulkLoadCloneTLogs(const CloneTLogs& ctl,
+                       const NSIDMap& nsidmap,
+                       const boost::filesystem::path& tlog_path,
+                       const boost::optional<youtils::UUID>& uuid) override final;
+
     virtual uint64_t
     applyRelocs(RelocationReaderFactory&,
                 SCOCloneID,
@@ -202,6 +222,8 @@ public:
     // not const as VolManagerRestartTest.testAllTlogEntriesAreReplayed messes with it
     static uint64_t replayClustersCached;
     static const uint32_t replayPagesQueued = 5;
+    // max number of TLog entries sorted in memory by bulkLoadCloneTLogs
+    static uint64_t bulkLoadRunEntries;
 
 private:
     DECLARE_LOGGER("CachedMetaDataStore");
@@ -211,24 +233,18 @@ private:
     std::vector<CachePage> pages_;
     std::vector<ClusterLocationAndHash> page_data_;
 
-    // For now "num_pages_" tracks the size of the map as its ->size() is not O(1).
-    // However, we only make use of auto-unlinking (which necessitates our use of
-    // constant_time_size<false>), or more precisely an explicit
-    // page->unlink_from_set(), just before we have to go to the backend in the hot
-    // path. So it might be acceptable to use constant_time_size<true> instead and
-    // get rid of "num_pages_" which has the potential of being out of sync if not
-    // treated carefully.
-    typedef bi::set<CachePage,
-                    bi::constant_time_size<false> > map_type;
-
-    typedef bi::list<CachePage,
-                     bi::constant_time_size<false> > list_type;
-
-    map_type page_map_;
-    list_type page_list_;
+    // Maps the PageAddresses of the resident pages to their slot in pages_.
+    // Slots [0, num_pages_) are in use.
+    CachePageIndex page_index_;
+    // CLOCK reference bits, one per slot. Set on cache hits (possibly with only
+    // the cache lock held in shared mode), cleared by the eviction sweep.
+    std::unique_ptr<std::atomic<bool>[]> referenced_;
+    size_t clock_hand_;
+    // readahead is triggered by a miss on this page
+    PageAddress next_sequential_miss_;
     uint64_t num_pages_;
-    uint64_t cache_hits_;
-    uint64_t cache_misses_;
+    std::atomic<uint64_t> cache_hits_;
+    std::atomic<uint64_t> cache_misses_;
     uint64_t written_clusters_;
     uint64_t discarded_clusters_;
 
@@ -248,7 +264,7 @@ private:
     boost::optional<youtils::UUID> cork_uuid_;
     MaybeScrubId scrub_id_;
 
-    typedef std::map<ClusterAddress, ClusterLocationAndHash> ca_loc_map_type;
+    typedef CorkedClusters ca_loc_map_type;
     typedef std::shared_ptr<ca_loc_map_type> ca_loc_map_ptr_type;
     typedef std::pair<youtils::UUID, ca_loc_map_ptr_type> cork_t;
     // orders latest cork at the end
@@ -263,6 +279,9 @@ private:
     void
     init_pages_(size_t capacity);
 
+    void
+    write_pages_and_set_cork_(const boost::optional<youtils::UUID>& cork);
+
     // bit of a misnomer - if sync is false nothing is written out!
     void
     write_dirty_pages_to_backend_and_clear_page_list(bool sync,
@@ -288,6 +307,22 @@ private:
     std::pair<CachePage*, bool>
     get_page_(const ClusterAddress);
 
+    bool
+    try_read_cached_cluster_location_(const ClusterAddress,
+                                      ClusterLocationAndHash&);
+
+    void
+    read_page_entries_(const ClusterAddress start,
+                       const size_t count,
+                       ClusterLocationAndHash* locs,
+                       std::vector<bool>::const_iterator corked);
+
+    CachePageIndex::Slot
+    evict_page_();
+
+    void
+    fetch_pages_(const std::vector<PageAddress>&);
+
     typedef void (MetaDataBackendInterface::*backend_mem_fun)(const CachePage&,
                                                               int32_t);
 
@@ -31,6 +31,7 @@
 
 #include <atomic>
 #include <algorithm>
+#include <climits>
 #include <list>
 #include <string>
 #include <utility>
@@ -239,6 +240,27 @@ struct SListNodeValueTraits: NodeValueTraits<T, SListNodeTraits>
     static const boost::intrusive::link_mode_type link_mode = boost::intrusive::normal_link;
 };
 
+// One cluster of a batched ClusterCacheT::read / add. As with the non-batched
+// variants the ClusterAddress is used for LocationBased and the Weed for
+// ContentBased handles.
+struct ClusterCacheIODescriptor
+{
+    ClusterCacheIODescriptor(const ClusterAddress a,
+                             const youtils::Weed& w,
+                             uint8_t* b)
+        : ca(a)
+        , weed(w)
+        , buf(b)
+        , hit(false)
+    {}
+
+    ClusterAddress ca;
+    youtils::Weed weed;
+    uint8_t* buf;
+    // set by read()
+    bool hit;
+};
+
 template<typename T,
          uint64_t logging_interval = (1 << 19)>
 class ClusterCacheT
@@ -358,8 +380,11 @@ private:
     typedef boost::mutex register_lock_type;
     register_lock_type register_lock_;
 
+    // Lookups only need rwlock in shared mode: hits merely mark the entry as
+    // referenced (cf. ClusterCacheEntry::reference) instead of relinking it in
+    // its LRU list, the latter being approximated by giving referenced entries a
+    // second chance on eviction.
     mutable fungi::RWLock rwlock;
-    mutable boost::mutex listlock;
 
     DECLARE_PARAMETER(serialize_read_cache);
     DECLARE_PARAMETER(read_cache_serialization_path);
@@ -697,6 +722,195 @@ private:
         dlist_algo::init(&entry);
     }
 
+    static boost::optional<ClusterCacheKey>
+    make_key_(const ClusterCacheHandle handle,
+              const ClusterAddress ca,
+              const youtils::Weed& weed)
+    {
+        if (handle != content_based_handle)
+        {
+            return ClusterCacheKey(handle,
+                                   ca);
+        }
+        else if (weed != youtils::Weed::null())
+        {
+            return ClusterCacheKey(weed);
+        }
+        else
+        {
+            return boost::none;
+        }
+    }
+
+    // Calls fun(device, first_index, count) for each run of entries adjacent
+    // on the same device (and hence dealt with by a single vectored
+    // I/O), entries being a sequence of pairs with the ClusterCacheEntry*
+    // as first member.
+    template<typename Entries,
+             typename Fun>
+    void
+    for_each_device_run_(const Entries& entries,
+                         Fun&& fun)
+    {
+        size_t start = 0;
+        while (start < entries.size())
+        {
+            T* dev = manager_.getDeviceFromEntry(entries[start].first);
+            size_t n = 1;
+
+            while (start + n < entries.size() and
+                   n < max_iovecs_ and
+                   entries[start + n].first == entries[start].first + n and
+                   dev and
+                   dev->hasEntry(entries[start + n].first))
+            {
+                ++n;
+            }
+
+            fun(dev,
+                start,
+                n);
+            start += n;
+        }
+    }
+
+    ClusterCacheEntry*
+    evict_from_lru_(dlist_t& lru)
+    {
+        rwlock.assertWriteLocked();
+
+        // Terminates after at most one pass over the list as the referenced
+        // bits cannot be set again while we hold the lock exclusively.
+        while (not lru.empty())
+        {
+            ClusterCacheEntry& e = lru.back();
+            lru.pop_back();
+
+            if (e.referenced())
+            {
+                e.unreference();
+                lru.push_front(e);
+            }
+            else
+            {
+                return &e;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // Finds / allocates the entry for key and links it into the map and the
+    // appropriate LRU. Returns nullptr if there's nothing to write (the
+    // immutable ContentBased entry is present already or no entry could be
+    // allocated).
+    ClusterCacheEntry*
+    prepare_add_(Namespace& nspace,
+                 const ClusterCacheHandle handle,
+                 const ClusterCacheKey& key,
+                 T*& read_cache)
+    {
+        rwlock.assertWriteLocked();
+
+        bool reinit = true;
+        read_cache = nullptr;
+
+        ClusterCacheEntry* entry = nspace.map.find(key);
+        if (entry)
+        {
+            /* ContentBased cache is immutable */
+            if (handle == content_based_handle)
+            {
+                return nullptr;
+            }
+            /* This means that the entry has not been invalidated yet
+             * but needs a buffer update. LocationBased cache is
+             * mutable.
+             */
+            reinit = false;
+            unlink_entry_from_dlist_(*entry);
+            entry->unreference();
+        }
+
+        if (not entry and
+            nspace.max_entries and
+            nspace.map.entries() == *nspace.max_entries)
+        {
+            // the namespace reached its size limit - recycle an entry from its
+            // private LRU
+            if (*nspace.max_entries == 0)
+            {
+                LOG_DEBUG("namespace " << handle << " is misconfigured with size 0, not caching anything");
+                return nullptr;
+            }
+
+            entry = evict_from_lru_(nspace.lru);
+            VERIFY(entry);
+            const bool ignore = nspace.map.remove(*entry);
+            VERIFY(ignore);
+        }
+
+        if (not entry)
+        {
+            /* Try to allocate an invalidated entry first */
+            entry = get_invalidated_cache_entry_();
+        }
+
+        if (not entry)
+        {
+            /* otherwise get the next free one */
+            entry = manager_.getNextFreeCluster(key,
+                                                read_cache);
+        }
+
+        if (not entry and not lru_.empty())
+        {
+            // finally we have no other option but to recycle an existing one
+            // from the global LRU list
+            entry = evict_from_lru_(lru_);
+            VERIFY(entry);
+
+            Namespace* old_nspace = find_namespace_(make_handle_(entry->mode(),
+                                                                 entry->key));
+            VERIFY(old_nspace);
+            const bool ignore = old_nspace->map.remove(*entry);
+            VERIFY(ignore);
+        }
+
+        if (not entry)
+        {
+            LOG_WARN("Failed to allocate an entry for handle " << handle <<
+                     " - are all devices gone or all entries consumed by other namespaces?");
+            return nullptr;
+        }
+
+        if (not read_cache)
+        {
+            read_cache = manager_.getDeviceFromEntry(entry);
+        }
+
+        VERIFY(read_cache);
+
+        if (reinit)
+        {
+            entry = new(entry) ClusterCacheEntry(key,
+                                                 get_cache_entry_mode(handle));
+            nspace.map.insert(*entry);
+        }
+
+        if (nspace.max_entries)
+        {
+            VERIFY(nspace.map.entries() <= *nspace.max_entries);
+            nspace.lru.push_front(*entry);
+        }
+        else
+        {
+            lru_.push_front(*entry);
+        }
+
+        return entry;
+    }
+
 public:
     ClusterCacheT(const boost::property_tree::ptree& pt,
                   const ClusterSize csize,
@@ -1099,120 +1313,95 @@ public:
 
         fungi::ScopedWriteLock l(rwlock);
 
-        // Really only serves as documentation - the rwlock should rule
-        // out concurrent accesses already hence we can be lazy and use
-        // listlock rather coarsely.
-        boost::lock_guard<decltype(listlock)> llg(listlock);
-
         Namespace* nspace = find_namespace_(handle);
         VERIFY(nspace);
 
-        bool reinit = true;
         T* read_cache = nullptr;
-
-        ClusterCacheEntry* entry = nspace->map.find(key);
+        ClusterCacheEntry* entry = prepare_add_(*nspace,
+                                                handle,
+                                                key,
+                                                read_cache);
         if (entry)
         {
-            /* ContentBased cache is immutable */
-            if (handle == content_based_handle)
-            {
-                return;
-            }
-            /* This means that the entry has not been invalidated yet
-             * but needs a buffer update. LocationBased cache is
-             * mutable.
-             */
-            reinit = false;
-            unlink_entry_from_dlist_(*entry);
-        }
-
-        if (not entry and
-            nspace->max_entries and
-            nspace->map.entries() == *nspace->max_entries)
-        {
-            // the namespace reached its size limit - recycle an entry from its
-            // private LRU
-            if (*nspace->max_entries == 0)
+            ssize_t res = read_cache->write(buf,
+                                            entry);
+            if (res != static_cast<ssize_t>(cluster_size()))
             {
-                LOG_DEBUG("namespace " << handle << " is misconfigured with size 0, not caching anything");
-                return;
+                LOG_ERROR("Couldn't write to " << read_cache << " - offlining it");
+                offlineDevice(read_cache);
             }
-
-            dlist_t& lru = nspace->lru;
-            VERIFY(not lru.empty());
-            entry = &lru.back();
-            lru.pop_back();
-            const bool ignore = nspace->map.remove(*entry);
-            VERIFY(ignore);
         }
+    }
 
-        if (not entry)
-        {
-            /* Try to allocate an invalidated entry first */
-            entry = get_invalidated_cache_entry_();
-        }
-
-        if (not entry)
-        {
-            /* otherwise get the next free one */
-            entry = manager_.getNextFreeCluster(key,
-                                                read_cache);
-        }
-
-        if (not entry and not lru_.empty())
-        {
-            // finally we have no other option but to recycle an existing one
-            // from the global LRU list
-            entry = &lru_.back();
-            lru_.pop_back();
-
-            Namespace* old_nspace = find_namespace_(make_handle_(entry->mode(),
-                                                                 entry->key));
-            VERIFY(old_nspace);
-            const bool ignore = old_nspace->map.remove(*entry);
-            VERIFY(ignore);
-        }
-
-        if (not entry)
-        {
-            LOG_WARN("Failed to allocate an entry for handle " << handle <<
-                     " - are all devices gone or all entries consumed by other namespaces?");
-            return;
-        }
-
-        VERIFY(entry);
-
-        if (not read_cache)
-        {
-            read_cache = manager_.getDeviceFromEntry(entry);
-        }
+    // Batched variant of add(): one write lock acquisition for all descriptors
+    // and entries that end up adjacent on a device are written with a single
+    // pwritev.
+    void
+    add(const ClusterCacheHandle handle,
+        const std::vector<ClusterCacheIODescriptor>& descs)
+    {
+        fungi::ScopedWriteLock l(rwlock);
 
-        VERIFY(read_cache);
+        Namespace* nspace = find_namespace_(handle);
+        VERIFY(nspace);
 
-        if (reinit)
-        {
-            entry = new(entry) ClusterCacheEntry(key,
-                                                 get_cache_entry_mode(handle));
-            nspace->map.insert(*entry);
-        }
+        std::vector<std::pair<ClusterCacheEntry*, const uint8_t*>> todo;
+        todo.reserve(descs.size());
 
-        if (nspace->max_entries)
+        for (const auto& desc : descs)
         {
-            VERIFY(nspace->map.entries() <= *nspace->max_entries);
-            nspace->lru.push_front(*entry);
-        }
-        else
-        {
-            lru_.push_front(*entry);
+            const boost::optional<ClusterCacheKey> key(make_key_(handle,
+                                                                 desc.ca,
+                                                                 desc.weed));
+            if (key)
+            {
+                T* read_cache = nullptr;
+                ClusterCacheEntry* entry = prepare_add_(*nspace,
+                                                        handle,
+                                                        *key,
+                                                        read_cache);
+                if (entry)
+                {
+                    todo.emplace_back(entry,
+                                      desc.buf);
+                }
+            }
         }
 
-        ssize_t res = read_cache->write(buf,
-                                        entry);
-        if (res != static_cast<ssize_t>(cluster_size()))
-        {
-            LOG_ERROR("Couldn't write to " << read_cache << " - offlining it");
-            offlineDevice(read_cache);
-        }
+        // NB: an entry can show up more than once in `todo' if it was recycled
+        // within this batch - the writes are hence issued in order so the last
+        // one (which matches the entry's current key) wins.
+        std::vector<struct iovec> iov;
+
+        for_each_device_run_(todo,
+                             [&](T* read_cache,
+                                 size_t start,
+                                 size_t count)
+                             {
+                                 // its entries are gone already if the device
+                                 // was offlined by a previous run
+                                 if (read_cache == nullptr)
+                                 {
+                                     return;
+                                 }
+
+                                 iov.resize(count);
+                                 for (size_t i = 0; i < count; ++i)
+                                 {
+                                     iov[i].iov_base = const_cast<uint8_t*>(todo[start + i].second);
+                                     iov[i].iov_len = cluster_size();
+                                 }
+
+                                 ssize_t res = read_cache->write(iov.data(),
+                                                                 count,
+                                                                 todo[start].first);
+                                 if (res != static_cast<ssize_t>(count * cluster_size()))
+                                 {
+                                     LOG_ERROR("Couldn't write to " << read_cache <<
+                                               " - offlining it");
+                                     offlineDevice(read_cache);
+                                 }
+                             });
     }
 
     bool
@@ -1276,13 +1465,12 @@ public:
                 {
                     num_hits++;
 
-                    dlist_t& lru = nspace->max_entries ?
-                        nspace->lru :
-                        lru_;
+                    // avoid dirtying the cache line if it's already set
+                    if (not entry->referenced())
+                    {
+                        entry->reference();
+                    }
 
-                    boost::lock_guard<decltype(listlock)> llg(listlock);
-                    unlink_entry_from_dlist_(*entry);
-                    lru.push_front(*entry);
                     return true;
                 }
                 else
@@ -1298,6 +1486,104 @@ public:
         return false;
     }
 
+    // Batched variant of read(): all descriptors are looked up under a single
+    // lock acquisition and hits that are adjacent on a device are read with a
+    // single preadv (a sequentially written range typically ends up in
+    // adjacent entries). Sets the descriptors' `hit' member and returns the
+    // number of hits.
+    size_t
+    read(const ClusterCacheHandle handle,
+         std::vector<ClusterCacheIODescriptor>& descs)
+    {
+        size_t hits = 0;
+        T* failed = nullptr;
+
+        {
+            fungi::ScopedReadLock l(rwlock);
+            Namespace* nspace = find_namespace_(handle);
+            VERIFY(nspace);
+
+            std::vector<std::pair<ClusterCacheEntry*, size_t>> found;
+            found.reserve(descs.size());
+
+            for (size_t i = 0; i < descs.size(); ++i)
+            {
+                descs[i].hit = false;
+
+                const boost::optional<ClusterCacheKey> key(make_key_(handle,
+                                                                     descs[i].ca,
+                                                                     descs[i].weed));
+                if (key)
+                {
+                    ClusterCacheEntry* entry = nspace->map.find(*key);
+                    if (entry)
+                    {
+                        found.emplace_back(entry,
+                                           i);
+                    }
+                }
+            }
+
+            std::vector<struct iovec> iov;
+
+            for_each_device_run_(found,
+                                 [&](T* read_cache,
+                                     size_t start,
+                                     size_t count)
+                                 {
+                                     if (failed)
+                                     {
+                                         return;
+                                     }
+
+                                     ASSERT(read_cache);
+
+                                     iov.resize(count);
+                                     for (size_t i = 0; i < count; ++i)
+                                     {
+                                         iov[i].iov_base = descs[found[start + i].second].buf;
+                                         iov[i].iov_len = cluster_size();
+                                     }
+
+                                     ssize_t res = read_cache->read(iov.data(),
+                                                                    count,
+                                                                    found[start].first);
+                                     if (res == static_cast<ssize_t>(count * cluster_size()))
+                                     {
+                                         for (size_t i = start; i < start + count; ++i)
+                                         {
+                                             descs[found[i].second].hit = true;
+
+                                             ClusterCacheEntry* entry = found[i].first;
+                                             if (not entry->referenced())
+                                             {
+                                                 entry->reference();
+                                             }
+                                         }
+
+                                         hits += count;
+                                     }
+                                     else
+                                     {
+                                         LOG_ERROR("Couldn't read from " << read_cache <<
+                                                   " - offlining it");
+                                         failed = read_cache;
+                                     }
+                                 });
+        }
+
+        num_hits += hits;
+        num_misses += descs.size() - hits;
+
+        if (failed)
+        {
+            fungi::ScopedWriteLock l(rwlock);
+            offlineDevice(failed);
+        }
+
+        return hits;
+    }
+
     void
     get_stats(uint64_t& hits,
               uint64_t& misses,
@@ -1431,6 +1717,7 @@ public:
 private:
 
     static constexpr uint64_t test_frequency_ = 8192;
+    static constexpr size_t max_iovecs_ = IOV_MAX;
     static const ClusterCacheHandle content_based_handle;
 
     bool
@@ -21,6 +21,7 @@
 #include "Types.h"
 
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 #include <fcntl.h>
 #include <sys/mount.h>
 
@@ -81,6 +82,30 @@ public:
                             getIndex(entry));
     }
 
+    // Vectored variants for iovcnt entries that are adjacent in memory_ (and
+    // hence on the device), the first one being `entry'.
+    ssize_t
+    read(const struct iovec* iov,
+         int iovcnt,
+         ClusterCacheEntry* entry)
+    {
+        VERIFY(hasEntry(entry + iovcnt - 1));
+        return store_.read(iov,
+                           iovcnt,
+                           getIndex(entry));
+    }
+
+    ssize_t
+    write(const struct iovec* iov,
+          int iovcnt,
+          ClusterCacheEntry* entry)
+    {
+        VERIFY(hasEntry(entry + iovcnt - 1));
+        return store_.write(iov,
+                            iovcnt,
+                            getIndex(entry));
+    }
+
     void
     sync()
     {
@@ -19,6 +19,7 @@
 #include "Types.h"
 
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 #include <fcntl.h>
 #include <sys/mount.h>
 
@@ -26,6 +27,7 @@
 #include <youtils/IOException.h>
 #include <youtils/Logging.h>
 #include <youtils/Md5.h>
+#include <youtils/WeedType.h>
 
 namespace volumedriver
 {
@@ -195,6 +197,25 @@ public:
         return pwrite(device_fd_, buf, cluster_size_, (index+1)*cluster_size_);
     }
 
+    // iovcnt clusters stored at consecutive indices, starting at index.
+    ssize_t
+    read(const struct iovec* iov,
+         int iovcnt,
+         uint32_t index)
+    {
+        VERIFY(device_fd_ >= 0);
+        return preadv(device_fd_, iov, iovcnt, (index+1) * cluster_size_);
+    }
+
+    ssize_t
+    write(const struct iovec* iov,
+          int iovcnt,
+          uint32_t index)
+    {
+        VERIFY(device_fd_ >= 0);
+        return pwritev(device_fd_, iov, iovcnt, (index+1) * cluster_size_);
+    }
+
     void
     sync()
     {
@@ -215,13 +236,19 @@ public:
         VERIFY(device_fd_ >= 0);
         std::vector<uint8_t> vec(cluster_size_);
         VERIFY(pread(device_fd_, &vec[0], cluster_size_, (index+1) * cluster_size_) == (ssize_t)cluster_size_);
-        youtils::Weed w (vec);
-        if (w != key)
+        // The store is shared by volumes with different WeedTypes.
+        for (const auto t : { youtils::WeedType::Md5,
+                              youtils::WeedType::Murmur3_128 })
         {
-            LOG_ERROR("MD5 mismatch detected: path_ " << path_ << " index " << index);
-            throw VerificationFailedException("MD5 mismatch detected",
-                                              path_.string().c_str());
+            if (youtils::make_weed(t, vec.data(), vec.size()) == key)
+            {
+                return;
+            }
         }
+
+        LOG_ERROR("Hash mismatch detected: path_ " << path_ << " index " << index);
+        throw VerificationFailedException("Hash mismatch detected",
+                                          path_.string().c_str());
     }
 
     uint64_t
@@ -113,7 +113,31 @@ public:
     ClusterCacheMode
     mode() const
     {
-        return ClusterCacheMode(dprevious_ bitand priv_mask);
+        return ClusterCacheMode(dprevious_ bitand mode_mask);
+    }
+
+    // Second chance bit, set on cache hits instead of moving the entry to the
+    // front of its LRU list. Readers only hold the ClusterCache's lock in shared
+    // mode hence the atomic update; clearing it / consuming it happens with the
+    // lock held exclusively.
+    bool
+    referenced() const
+    {
+        return dprevious_ bitand referenced_bit;
+    }
+
+    void
+    reference()
+    {
+        __sync_fetch_and_or(&dprevious_,
+                            referenced_bit);
+    }
+
+    void
+    unreference()
+    {
+        __sync_fetch_and_and(&dprevious_,
+                             ~referenced_bit);
     }
 
     friend bool
@@ -126,6 +150,8 @@ public:
     static const uint64_t align_bits = 3;
     static const uint64_t priv_mask = (1ULL << align_bits) - 1;
     static const uint64_t ptr_mask = ~priv_mask;
+    static const uint64_t mode_mask = (1ULL << 2) - 1;
+    static const uint64_t referenced_bit = 1ULL << 2;
 
     const ClusterCacheKey key;
 
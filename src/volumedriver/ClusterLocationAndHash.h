@@ -20,6 +20,7 @@
 #include "VolumeConfig.h"
 
 #include <youtils/Md5.h>
+#include <youtils/WeedType.h>
 
 namespace volumedrivertesting
 {
@@ -51,11 +52,17 @@ struct ClusterLocationAndHash
 #ifndef ENABLE_MD5_HASH
                            __attribute__((unused))
 #endif
-                           )
+                           ,
+                           const youtils::WeedType weed_type
+#ifndef ENABLE_MD5_HASH
+                           __attribute__((unused))
+#endif
+                           = youtils::WeedType::Md5)
         : clusterLocation(cloc)
 #ifdef ENABLE_MD5_HASH
-        , weed_(data,
-                size)
+        , weed_(youtils::make_weed(weed_type,
+                                   data,
+                                   size))
 #endif
     {}
 
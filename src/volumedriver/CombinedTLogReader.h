@@ -17,9 +17,12 @@
 #define COMBINEDTLOGBACKENDREADER_H_
 
 #include "BackwardTLogReader.h"
+#include "MemoryTLogReader.h"
 #include "TLogReader.h"
 #include "TLogReaderInterface.h"
 
+#include <deque>
+#include <future>
 #include <vector>
 #include <string>
 
@@ -104,6 +107,107 @@ private:
     const std::vector<typename Items::value_type> items_;
 };
 
+// Fetches up to `depth' TLogs concurrently - each with its own clone of the
+// BackendInterface - into MemoryTLogReaders and hands them out in order. While
+// the current one is consumed the next `depth' ones are in flight or ready, so
+// memory use is bounded by depth + 1 TLogs; the TLog directory only holds the
+// ones that are being downloaded.
+class ParallelTLogReaderGen
+    : public TLogGen
+{
+public:
+    ParallelTLogReaderGen(const boost::filesystem::path& tlog_path,
+                          std::vector<std::string> names,
+                          BackendInterfacePtr bi,
+                          size_t depth)
+        : tlog_path_(tlog_path)
+        , names_(std::move(names))
+        , next_index_(0)
+        , bi_(std::move(bi))
+        , depth_(depth)
+    {
+        VERIFY(depth_ > 0);
+        update();
+    }
+
+    // std::async futures block on destruction, i.e. the fetches still in
+    // flight are waited for.
+    ~ParallelTLogReaderGen() = default;
+
+    void
+    next() override final
+    {
+        update();
+    }
+
+    TLogGenItem&
+    current() override final
+    {
+        return current_;
+    }
+
+    bool
+    finished() override final
+    {
+        return not current_.get();
+    }
+
+private:
+    DECLARE_LOGGER("ParallelTLogReaderGen");
+
+    void
+    fill()
+    {
+        while (next_index_ < names_.size() and
+               pending_.size() < depth_)
+        {
+            const std::string& name = names_[next_index_++];
+            BackendInterfacePtr bi(bi_ ? bi_->clone() : nullptr);
+
+            pending_.emplace_back(std::async(std::launch::async,
+                                             [path = tlog_path_,
+                                              name,
+                                              bi = std::move(bi)]() mutable -> TLogGenItem
+                                             {
+                                                 if (bi)
+                                                 {
+                                                     return TLogGenItem(new MemoryTLogReader(path,
+                                                                                             name,
+                                                                                             std::move(bi)));
+                                                 }
+                                                 else
+                                                 {
+                                                     return TLogGenItem(new MemoryTLogReader(path / name));
+                                                 }
+                                             }));
+        }
+    }
+
+    void
+    update()
+    {
+        current_.reset();
+        fill();
+
+        if (not pending_.empty())
+        {
+            std::future<TLogGenItem> f(std::move(pending_.front()));
+            pending_.pop_front();
+            // get the next one going before possibly blocking on this one
+            fill();
+            current_ = f.get();
+        }
+    }
+
+    TLogGenItem current_;
+    const boost::filesystem::path tlog_path_;
+    const std::vector<std::string> names_;
+    size_t next_index_;
+    BackendInterfacePtr bi_;
+    const size_t depth_;
+    std::deque<std::future<TLogGenItem>> pending_;
+};
+
 class CombinedTLogReader
     : public TLogReaderInterface
 {
@@ -144,8 +248,12 @@ public:
         Prefetch,
         OnDemand,
         Concurrent,
+        // fetch_depth TLogs downloaded in parallel, read from memory
+        Parallel,
     };
 
+    static constexpr size_t default_fetch_depth = 8;
+
     // Why templates you ask: The OrderedTLogIds are sufficient for everything except scrubbing
     // where we treat the relocation as TLog. You can't type that as OrderedTLogIds.
     template <typename T>
@@ -153,27 +261,45 @@ public:
     create(const fs::path& tlog_path,
            const T& items,
            BackendInterfacePtr bi,
-           const FetchStrategy strategy = FetchStrategy::Concurrent)
+           const FetchStrategy strategy = FetchStrategy::Concurrent,
+           const size_t fetch_depth = default_fetch_depth)
     {
         std::unique_ptr<TLogGen> generator;
 
-        std::unique_ptr<TLogGen>
-            base_generator(new TLogReaderGen<TLogReader, T>(tlog_path,
-                                                           items,
-                                                           std::move(bi)));
+        auto base_generator([&]() -> std::unique_ptr<TLogGen>
+                            {
+                                return std::unique_ptr<TLogGen>(new TLogReaderGen<TLogReader, T>(tlog_path,
+                                                                                                 items,
+                                                                                                 std::move(bi)));
+                            });
 
         switch (strategy)
         {
         case FetchStrategy::Prefetch:
-            generator.reset(new youtils::PrefetchGenerator<TLogGenItem>(std::move(base_generator)));
+            generator.reset(new youtils::PrefetchGenerator<TLogGenItem>(base_generator()));
             break;
         case FetchStrategy::Concurrent:
-            generator.reset(new youtils::ThreadedGenerator<TLogGenItem>(std::move(base_generator),
+            generator.reset(new youtils::ThreadedGenerator<TLogGenItem>(base_generator(),
                                                                         uint32_t(10)));
             break;
         case FetchStrategy::OnDemand:
-            generator = std::move(base_generator);
+            generator = base_generator();
             break;
+        case FetchStrategy::Parallel:
+            {
+                std::vector<std::string> names;
+                names.reserve(items.size());
+                for (const auto& i : items)
+                {
+                    names.emplace_back(boost::lexical_cast<std::string>(i));
+                }
+
+                generator.reset(new ParallelTLogReaderGen(tlog_path,
+                                                          std::move(names),
+                                                          std::move(bi),
+                                                          fetch_depth));
+                break;
+            }
         }
 
         VERIFY(generator);
@@ -0,0 +1,475 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+#include "CompressedTLog.h"
+
+#include <array>
+#include <cstring>
+#include <functional>
+
+#include <youtils/Assert.h>
+#include <youtils/FileDescriptor.h>
+
+namespace volumedriver
+{
+
+namespace yt = youtils;
+
+namespace
+{
+
+constexpr uint64_t magic = 0x315a474f4c544456ULL; // "VDTLOGZ1"
+constexpr uint32_t version = 1;
+
+struct FileHeader
+{
+    uint64_t magic;
+    uint32_t version;
+    uint32_t entry_size;
+};
+
+static_assert(sizeof(FileHeader) == 16,
+              "unexpected FileHeader size");
+
+struct BlockHeader
+{
+    uint32_t num_entries;
+    uint32_t payload_size;
+    uint32_t payload_crc;
+    uint32_t pad;
+};
+
+static_assert(sizeof(BlockHeader) == 16,
+              "unexpected BlockHeader size");
+
+constexpr size_t words_per_entry = sizeof(Entry) / sizeof(uint64_t);
+constexpr size_t flag_bytes_per_entry = (words_per_entry + 3) / 4;
+
+static_assert(sizeof(Entry) % sizeof(uint64_t) == 0,
+              "Entry size is not a multiple of 64 bits");
+
+enum WordCode
+    : uint8_t
+{
+    Predicted = 0,
+    Delta = 1,
+    Raw = 2,
+};
+
+using Words = std::array<uint64_t, words_per_entry>;
+
+uint64_t
+zigzag(uint64_t d)
+{
+    return (d << 1) ^ static_cast<uint64_t>(static_cast<int64_t>(d) >> 63);
+}
+
+uint64_t
+unzigzag(uint64_t z)
+{
+    return (z >> 1) ^ (~(z & 1) + 1);
+}
+
+// Reads until `size' bytes were read or EOF is hit.
+size_t
+read_fully(yt::FileDescriptor& fd,
+           void* buf,
+           size_t size)
+{
+    size_t off = 0;
+    while (off < size)
+    {
+        const size_t r = fd.read(static_cast<uint8_t*>(buf) + off,
+                                 size - off);
+        if (r == 0)
+        {
+            break;
+        }
+        off += r;
+    }
+
+    return off;
+}
+
+}
+
+bool
+CompressedTLog::is_compressed(const fs::path& p)
+{
+    FileHeader hdr;
+
+    yt::FileDescriptor fd(p,
+                          yt::FDMode::Read);
+
+    return
+        read_fully(fd,
+                   &hdr,
+                   sizeof(hdr)) == sizeof(hdr) and
+        hdr.magic == magic;
+}
+
+void
+CompressedTLog::encode(const Entry* entries,
+                       size_t count,
+                       std::vector<uint8_t>& out)
+{
+    Words prev;
+    Words stride;
+
+    prev.fill(0);
+    stride.fill(0);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        Words w;
+        memcpy(w.data(),
+               entries + i,
+               sizeof(Entry));
+
+        const size_t flag_pos = out.size();
+        out.resize(out.size() + flag_bytes_per_entry, 0);
+
+        for (size_t j = 0; j < words_per_entry; ++j)
+        {
+            WordCode code;
+
+            if (w[j] == prev[j] + stride[j])
+            {
+                code = WordCode::Predicted;
+            }
+            else
+            {
+                uint64_t z = zigzag(w[j] - prev[j]);
+                // varints of more than 7 bytes don't pay off
+                if (z < (1ULL << 49))
+                {
+                    code = WordCode::Delta;
+                    while (z >= 0x80)
+                    {
+                        out.push_back(static_cast<uint8_t>(z) | 0x80);
+                        z >>= 7;
+                    }
+                    out.push_back(static_cast<uint8_t>(z));
+                }
+                else
+                {
+                    code = WordCode::Raw;
+                    const uint8_t* p = reinterpret_cast<const uint8_t*>(&w[j]);
+                    out.insert(out.end(),
+                               p,
+                               p + sizeof(uint64_t));
+                }
+            }
+
+            out[flag_pos + j / 4] |= code << (2 * (j % 4));
+
+            stride[j] = w[j] - prev[j];
+            prev[j] = w[j];
+        }
+    }
+}
+
+void
+CompressedTLog::decode(const uint8_t* data,
+                       size_t size,
+                       size_t count,
+                       std::vector<Entry>& out)
+{
+    Words prev;
+    Words stride;
+
+    prev.fill(0);
+    stride.fill(0);
+
+    const uint8_t* const end = data + size;
+
+    const size_t off = out.size();
+    out.resize(off + count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (data + flag_bytes_per_entry > end)
+        {
+            throw CompressedTLogException("compressed TLog block is truncated");
+        }
+
+        const uint8_t* flags = data;
+        data += flag_bytes_per_entry;
+
+        Words w;
+
+        for (size_t j = 0; j < words_per_entry; ++j)
+        {
+            const uint8_t code = (flags[j / 4] >> (2 * (j % 4))) & 0x3;
+
+            switch (code)
+            {
+            case WordCode::Predicted:
+                w[j] = prev[j] + stride[j];
+                break;
+            case WordCode::Delta:
+                {
+                    uint64_t z = 0;
+                    unsigned shift = 0;
+
+                    while (true)
+                    {
+                        if (data == end or shift > 63)
+                        {
+                            throw CompressedTLogException("invalid varint in compressed TLog block");
+                        }
+
+                        const uint8_t b = *data++;
+                        z |= static_cast<uint64_t>(b & 0x7f) << shift;
+                        if ((b & 0x80) == 0)
+                        {
+                            break;
+                        }
+                        shift += 7;
+                    }
+
+                    w[j] = prev[j] + unzigzag(z);
+                    break;
+                }
+            case WordCode::Raw:
+                if (data + sizeof(uint64_t) > end)
+                {
+                    throw CompressedTLogException("compressed TLog block is truncated");
+                }
+                memcpy(&w[j],
+                       data,
+                       sizeof(uint64_t));
+                data += sizeof(uint64_t);
+                break;
+            default:
+                throw CompressedTLogException("invalid word code in compressed TLog block");
+            }
+
+            stride[j] = w[j] - prev[j];
+            prev[j] = w[j];
+        }
+
+        memcpy(&out[off + i],
+               w.data(),
+               sizeof(Entry));
+    }
+
+    if (data != end)
+    {
+        throw CompressedTLogException("trailing garbage in compressed TLog block");
+    }
+}
+
+yt::CheckSum
+CompressedTLog::compress(const fs::path& src,
+                         const fs::path& dst,
+                         uint32_t entries_per_block)
+{
+    VERIFY(entries_per_block > 0);
+
+    yt::FileDescriptor in(src,
+                          yt::FDMode::Read);
+    yt::FileDescriptor out(dst,
+                           yt::FDMode::Write,
+                           CreateIfNecessary::T);
+    out.truncate(0);
+
+    yt::CheckSum cs;
+
+    auto write([&](const void* buf,
+                   size_t size)
+               {
+                   out.write(buf,
+                             size);
+                   cs.update(buf,
+                             size);
+               });
+
+    const FileHeader fhdr{ magic,
+                           version,
+                           static_cast<uint32_t>(sizeof(Entry)) };
+    write(&fhdr,
+          sizeof(fhdr));
+
+    std::vector<Entry> entries(entries_per_block);
+    std::vector<uint8_t> payload;
+
+    uint64_t raw_size = 0;
+    uint64_t compressed_size = sizeof(fhdr);
+
+    while (true)
+    {
+        const size_t r = read_fully(in,
+                                    entries.data(),
+                                    entries.size() * sizeof(Entry));
+        if (r % sizeof(Entry) != 0)
+        {
+            LOG_ERROR(src << ": trailing garbage (" << (r % sizeof(Entry)) <<
+                      " bytes)");
+            throw CompressedTLogException("trailing garbage in TLog");
+        }
+
+        const size_t count = r / sizeof(Entry);
+        if (count == 0)
+        {
+            break;
+        }
+
+        payload.clear();
+        encode(entries.data(),
+               count,
+               payload);
+
+        yt::CheckSum pcs;
+        pcs.update(payload.data(),
+                   payload.size());
+
+        const BlockHeader bhdr{ static_cast<uint32_t>(count),
+                                static_cast<uint32_t>(payload.size()),
+                                pcs.getValue(),
+                                0 };
+        write(&bhdr,
+              sizeof(bhdr));
+        write(payload.data(),
+              payload.size());
+
+        raw_size += r;
+        compressed_size += sizeof(bhdr) + payload.size();
+
+        if (count < entries.size())
+        {
+            break;
+        }
+    }
+
+    out.sync();
+
+    LOG_INFO(src << " (" << raw_size << " bytes) -> " << dst << " (" <<
+             compressed_size << " bytes)");
+
+    return cs;
+}
+
+void
+CompressedTLog::decompress(const fs::path& src,
+                           const fs::path& dst)
+{
+    yt::FileDescriptor out(dst,
+                           yt::FDMode::Write,
+                           CreateIfNecessary::T);
+    out.truncate(0);
+
+    decompress_(src,
+                [&](const std::vector<Entry>& entries)
+                {
+                    out.write(entries.data(),
+                              entries.size() * sizeof(Entry));
+                });
+
+    out.sync();
+}
+
+void
+CompressedTLog::decompress(const fs::path& src,
+                           std::vector<Entry>& out)
+{
+    decompress_(src,
+                [&](const std::vector<Entry>& entries)
+                {
+                    out.insert(out.end(),
+                               entries.begin(),
+                               entries.end());
+                });
+}
+
+void
+CompressedTLog::decompress_(const fs::path& src,
+                            const std::function<void(const std::vector<Entry>&)>& fun)
+{
+    yt::FileDescriptor in(src,
+                          yt::FDMode::Read);
+
+    FileHeader fhdr;
+    if (read_fully(in,
+                   &fhdr,
+                   sizeof(fhdr)) != sizeof(fhdr) or
+        fhdr.magic != magic)
+    {
+        LOG_ERROR(src << ": not a compressed TLog");
+        throw CompressedTLogException("not a compressed TLog");
+    }
+
+    if (fhdr.version != version or
+        fhdr.entry_size != sizeof(Entry))
+    {
+        LOG_ERROR(src << ": unsupported version " << fhdr.version <<
+                  " / entry size " << fhdr.entry_size);
+        throw CompressedTLogException("unsupported compressed TLog version or entry size");
+    }
+
+    std::vector<uint8_t> payload;
+    std::vector<Entry> entries;
+
+    while (true)
+    {
+        BlockHeader bhdr;
+        const size_t r = read_fully(in,
+                                    &bhdr,
+                                    sizeof(bhdr));
+        if (r == 0)
+        {
+            break;
+        }
+        else if (r != sizeof(bhdr))
+        {
+            LOG_ERROR(src << ": truncated block header");
+            throw CompressedTLogException("truncated compressed TLog block header");
+        }
+
+        payload.resize(bhdr.payload_size);
+        if (read_fully(in,
+                       payload.data(),
+                       payload.size()) != payload.size())
+        {
+            LOG_ERROR(src << ": truncated block");
+            throw CompressedTLogException("truncated compressed TLog block");
+        }
+
+        yt::CheckSum pcs;
+        pcs.update(payload.data(),
+                   payload.size());
+
+        if (pcs.getValue() != bhdr.payload_crc)
+        {
+            LOG_ERROR(src << ": block checksum mismatch: expected " <<
+                      bhdr.payload_crc << ", got " << pcs.getValue());
+            throw CompressedTLogException("compressed TLog block checksum mismatch");
+        }
+
+        entries.clear();
+        decode(payload.data(),
+               payload.size(),
+               bhdr.num_entries,
+               entries);
+
+        fun(entries);
+    }
+}
+
+}
+
+// Local Variables: **
+// mode: c++ **
+// End: **
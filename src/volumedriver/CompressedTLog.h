@@ -0,0 +1,105 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+#ifndef COMPRESSED_TLOG_H_
+#define COMPRESSED_TLOG_H_
+
+#include "Entry.h"
+
+#include <functional>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <youtils/CheckSum.h>
+#include <youtils/IOException.h>
+#include <youtils/Logging.h>
+
+namespace volumedriver
+{
+
+MAKE_EXCEPTION(CompressedTLogException, fungi::IOException);
+
+// Compact TLog format for TLogs stored on the backend (cf.
+// compress_tlogs_on_backend). Sequentially written TLogs mostly consist of runs
+// of entries whose cluster address and cluster location advance by a constant
+// stride, so each 64 bit word of an entry is encoded relative to a per-word
+// stride predictor:
+//
+// file    := header block*
+// header  := magic (u64) | version (u32) | sizeof(Entry) (u32)
+// block   := #entries (u32) | payload size (u32) | payload crc32c (u32) | pad (u32) |
+//            payload
+// payload := per entry: a flag byte for each group of 4 words (2 bits per word)
+//            followed by the words that are not predicted:
+//            0: word == previous + previous stride (nothing stored)
+//            1: zigzag encoded delta to the previous word (varint)
+//            2: raw word (8 bytes)
+//
+// The predictor is reset at each block boundary, hence blocks can be decoded
+// independently.
+// Local TLogs are always kept in the plain format as they're appended to;
+// OneFileTLogReader transparently expands compressed ones.
+class CompressedTLog
+{
+public:
+    static constexpr uint32_t default_entries_per_block = 4096;
+
+    static bool
+    is_compressed(const fs::path&);
+
+    // Returns the checksum of `dst'.
+    static youtils::CheckSum
+    compress(const fs::path& src,
+             const fs::path& dst,
+             uint32_t entries_per_block = default_entries_per_block);
+
+    static void
+    decompress(const fs::path& src,
+               const fs::path& dst);
+
+    // Appends all entries of `src' to `out'.
+    static void
+    decompress(const fs::path& src,
+               std::vector<Entry>& out);
+
+    // Appends the encoding of `count' entries to `out'.
+    static void
+    encode(const Entry* entries,
+           size_t count,
+           std::vector<uint8_t>& out);
+
+    // Appends `count' entries decoded from [data, data + size) to `out'.
+    static void
+    decode(const uint8_t* data,
+           size_t size,
+           size_t count,
+           std::vector<Entry>& out);
+
+private:
+    DECLARE_LOGGER("CompressedTLog");
+
+    static void
+    decompress_(const fs::path& src,
+                const std::function<void(const std::vector<Entry>&)>& fun);
+};
+
+}
+
+#endif // !COMPRESSED_TLOG_H_
+
+// Local Variables: **
+// mode: c++ **
+// End: **
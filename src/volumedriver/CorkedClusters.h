@@ -0,0 +1,214 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+#ifndef CORKED_CLUSTERS_H_
+#define CORKED_CLUSTERS_H_
+
+#include "ClusterLocationAndHash.h"
+#include "Types.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <youtils/Assert.h>
+
+namespace volumedriver
+{
+
+// The cluster locations written under a cork, i.e. not yet reflected in the
+// metadata pages. Entries are kept in an append-only vector (in order of first
+// write; rewrites update the entry in place) which is indexed by a linear probing
+// hash table, making inserts and lookups O(1) without a heap allocation per
+// cluster.
+// Not thread safe - locking is up to the user.
+class CorkedClusters
+{
+public:
+    using Entry = std::pair<ClusterAddress, ClusterLocationAndHash>;
+    using const_iterator = std::vector<Entry>::const_iterator;
+
+    CorkedClusters()
+        : index_(min_index_size_, Index(npos))
+    {}
+
+    ~CorkedClusters() = default;
+
+    CorkedClusters(const CorkedClusters&) = default;
+
+    CorkedClusters&
+    operator=(const CorkedClusters&) = default;
+
+    void
+    set(const ClusterAddress ca,
+        const ClusterLocationAndHash& loc)
+    {
+        size_t i = bucket_(ca);
+        for (; index_[i] != npos; i = (i + 1) & (index_.size() - 1))
+        {
+            Entry& e = entries_[index_[i]];
+            if (e.first == ca)
+            {
+                e.second = loc;
+                return;
+            }
+        }
+
+        VERIFY(entries_.size() < npos);
+
+        index_[i] = entries_.size();
+        entries_.emplace_back(ca, loc);
+
+        if (2 * entries_.size() > index_.size())
+        {
+            rehash_(2 * index_.size());
+        }
+    }
+
+    const ClusterLocationAndHash*
+    find(const ClusterAddress ca) const
+    {
+        for (size_t i = bucket_(ca);
+             index_[i] != npos;
+             i = (i + 1) & (index_.size() - 1))
+        {
+            const Entry& e = entries_[index_[i]];
+            if (e.first == ca)
+            {
+                return &e.second;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // Invokes fun(ClusterAddress, const ClusterLocationAndHash&) for each corked
+    // entry in [start, start + count), in no particular order.
+    template<typename Fun>
+    void
+    for_each_in_range(const ClusterAddress start,
+                      const size_t count,
+                      Fun&& fun) const
+    {
+        if (count < entries_.size())
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                const ClusterLocationAndHash* loc = find(start + i);
+                if (loc)
+                {
+                    fun(start + i, *loc);
+                }
+            }
+        }
+        else
+        {
+            for (const auto& e : entries_)
+            {
+                if (e.first >= start and e.first - start < count)
+                {
+                    fun(e.first, e.second);
+                }
+            }
+        }
+    }
+
+    // The entries sorted by ClusterAddress, for applying them to the metadata
+    // pages in page order.
+    std::vector<Entry>
+    sorted() const
+    {
+        std::vector<Entry> vec(entries_);
+        std::sort(vec.begin(),
+                  vec.end(),
+                  [](const Entry& a, const Entry& b)
+                  {
+                      return a.first < b.first;
+                  });
+        return vec;
+    }
+
+    const_iterator
+    begin() const
+    {
+        return entries_.begin();
+    }
+
+    const_iterator
+    end() const
+    {
+        return entries_.end();
+    }
+
+    size_t
+    size() const
+    {
+        return entries_.size();
+    }
+
+    bool
+    empty() const
+    {
+        return entries_.empty();
+    }
+
+private:
+    using Index = uint32_t;
+
+    static constexpr Index npos = std::numeric_limits<Index>::max();
+    static constexpr size_t min_index_size_ = 64;
+
+    std::vector<Entry> entries_;
+    // power of two sized, load factor <= 0.5
+    std::vector<Index> index_;
+
+    size_t
+    bucket_(const ClusterAddress ca) const
+    {
+        return (ca * 0x9E3779B97F4A7C15ULL) >> (64 - bits_());
+    }
+
+    unsigned
+    bits_() const
+    {
+        return __builtin_ctzll(index_.size());
+    }
+
+    void
+    rehash_(const size_t size)
+    {
+        std::vector<Index>(size, Index(npos)).swap(index_);
+
+        for (size_t n = 0; n < entries_.size(); ++n)
+        {
+            size_t i = bucket_(entries_[n].first);
+            while (index_[i] != npos)
+            {
+                i = (i + 1) & (index_.size() - 1);
+            }
+
+            index_[i] = n;
+        }
+    }
+};
+
+}
+
+#endif // !CORKED_CLUSTERS_H_
+
+// Local Variables: **
+// mode: c++ **
+// End: **
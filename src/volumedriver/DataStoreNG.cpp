@@ -23,8 +23,10 @@
 #include <algorithm>
 
 #include <youtils/Assert.h>
+#include <youtils/Catchers.h>
 #include <youtils/ScopeExit.h>
 #include <youtils/Timer.h>
+#include <youtils/WorkerPool.h>
 
 namespace volumedriver
 {
@@ -35,6 +37,32 @@ namespace bc = boost::chrono;
 namespace be = backend;
 namespace yt = youtils;
 
+namespace
+{
+
+// A chunk of a sparse SCO read from the backend, and the parts of it that were
+// asked for (slice offsets are relative to the SCO, buffers are the callers').
+struct SparseChunkFetch
+{
+    SparseSCOPtr sparse;
+    uint64_t offset = 0;
+    std::vector<uint8_t> buf;
+    std::vector<be::BackendConnectionInterface::ObjectSlice> copies;
+};
+
+// Whether (and how) an SCO is read via sparse chunk fetches is decided once per
+// readClusters call, as chunk fetches and plain slices of the same SCO could
+// end up at the same offset. A sparse SCO that fails or turns out to be mostly
+// present is dropped along the way: the remaining reads of it are still chunk
+// fetches but nothing is added to it anymore.
+struct SparseSCOState
+{
+    SparseSCOPtr sparse;
+    bool dropped = false;
+};
+
+}
+
 #define WLOCK_DATASTORE()                       \
     boost::unique_lock<decltype(rw_lock_)> ulg__(rw_lock_)
 
@@ -53,6 +81,9 @@ namespace yt = youtils;
 #define LOCK_PARTIAL_READ_COUNTER()                     \
     boost::lock_guard<decltype(partial_read_counter_lock_)> prclg__(partial_read_counter_lock_)
 
+#define LOCK_SPARSE_SCOS()                              \
+    boost::lock_guard<decltype(sparse_scos_lock_)> sslg__(sparse_scos_lock_)
+
 DataStoreNG::DataStoreNG(const VolumeConfig& cfg,
                          SCOCache* scoCache,
                          unsigned num_open_scos)
@@ -521,6 +552,12 @@ DataStoreNG::readClusters(const std::vector<ClusterReadDescriptor>& descs)
 
     const size_t csize = getClusterSize();
 
+    // Backend reads of SCOs that are sparsely cached are widened to whole
+    // chunks which are then added to the sparse SCOs.
+    const size_t sparse_chunk_size = VolManager::get()->sparse_sco_chunk_size.value();
+    std::map<SCO, SparseSCOState> sparse_scos;
+    std::map<std::pair<SCO, uint64_t>, SparseChunkFetch> sparse_fetches;
+
     for (size_t start = 0; start < num_descs; )
     {
         size_t num_clusters = 1;
@@ -569,16 +606,137 @@ DataStoreNG::readClusters(const std::vector<ClusterReadDescriptor>& descs)
             else
             {
                 // the SCO is (supposed to be) on the backend
-                sco.cloneID(SCOCloneID(0));
-                be::BackendConnectionInterface::ObjectSlice
-                    slice(num_clusters * csize,
-                          descs[start].getClusterLocation().offset() * csize,
-                          descs[start].getBuffer());
-
-                be::BackendConnectionInterface::PartialReads&
-                    partial_reads = partial_reads_map[start_cid];
-                const auto res(partial_reads[sco.str()].emplace(std::move(slice)));
-                VERIFY(res.second);
+                SCO backend_sco(sco);
+                backend_sco.cloneID(SCOCloneID(0));
+
+                const uint64_t off = descs[start].getClusterLocation().offset() * csize;
+                const size_t size = num_clusters * csize;
+                uint8_t* const buf = descs[start].getBuffer();
+
+                SparseSCOState* state = nullptr;
+                SparseSCOPtr sparse;
+
+                if (sparse_chunk_size != 0)
+                {
+                    auto it = sparse_scos.find(sco);
+                    if (it == sparse_scos.end())
+                    {
+                        SparseSCOState s;
+                        s.sparse = get_sparse_sco_(sco,
+                                                   sparse_chunk_size);
+
+                        if (s.sparse)
+                        {
+                            // all reads of this SCO have to fit
+                            uint64_t end = 0;
+                            for (size_t i = start; i < num_descs; ++i)
+                            {
+                                const ClusterLocation& loc = descs[i].getClusterLocation();
+                                if (loc.sco() == sco)
+                                {
+                                    end = std::max<uint64_t>(end,
+                                                             (loc.offset() + 1) * csize);
+                                }
+                            }
+
+                            if (end > s.sparse->size())
+                            {
+                                LOG_ERROR(nspace_ << ": read beyond the end of " << sco <<
+                                          ": up to " << end << ", SCO size " <<
+                                          s.sparse->size() << " - not reading it sparsely");
+                                s.sparse = nullptr;
+                            }
+                        }
+
+                        it = sparse_scos.emplace(sco,
+                                                 std::move(s)).first;
+                    }
+
+                    state = &it->second;
+                    sparse = state->sparse;
+                }
+
+                if (sparse and not state->dropped)
+                {
+                    try
+                    {
+                        hit = sparse->read(buf,
+                                           size,
+                                           off);
+                    }
+                    CATCH_STD_ALL_EWHAT({
+                            LOG_WARN(nspace_ << ": failed to read from " <<
+                                     sparse->path() << ": " << EWHAT);
+                            drop_sparse_sco_(sparse);
+                            state->dropped = true;
+                        });
+
+                    if (hit)
+                    {
+                        cacheHitCounter_ += num_clusters;
+                    }
+                    else if (not state->dropped and sparse->dense())
+                    {
+                        // reads keep coming in for this one - get all of it
+                        LOG_INFO(nspace_ << ": " << sco <<
+                                 " is mostly present in the sparse SCO cache, fetching all of it");
+                        drop_sparse_sco_(sparse);
+                        state->dropped = true;
+
+                        hit = read_adjacent_clusters_(descs[start],
+                                                      num_clusters,
+                                                      true);
+                        VERIFY(hit);
+                    }
+                }
+
+                if (hit)
+                {
+                    // nothing to do
+                }
+                else if (sparse)
+                {
+                    const size_t chunk_size = sparse->chunk_size();
+
+                    for (uint64_t c = off / chunk_size; c * chunk_size < off + size; ++c)
+                    {
+                        SparseChunkFetch& f = sparse_fetches[std::make_pair(sco, c)];
+                        if (not f.sparse)
+                        {
+                            f.sparse = sparse;
+                            f.offset = c * chunk_size;
+                            f.buf.resize(std::min<uint64_t>(chunk_size,
+                                                            sparse->size() - f.offset));
+
+                            be::BackendConnectionInterface::PartialReads&
+                                partial_reads = partial_reads_map[start_cid];
+                            const auto res(partial_reads[backend_sco.str()].emplace(f.buf.size(),
+                                                                                    f.offset,
+                                                                                    f.buf.data()));
+                            VERIFY(res.second);
+                        }
+
+                        const uint64_t b = std::max<uint64_t>(off,
+                                                              f.offset);
+                        const uint64_t e = std::min<uint64_t>(off + size,
+                                                              f.offset + f.buf.size());
+                        f.copies.emplace_back(e - b,
+                                              b,
+                                              buf + (b - off));
+                    }
+                }
+                else
+                {
+                    be::BackendConnectionInterface::ObjectSlice
+                        slice(size,
+                              off,
+                              buf);
+
+                    be::BackendConnectionInterface::PartialReads&
+                        partial_reads = partial_reads_map[start_cid];
+                    const auto res(partial_reads[backend_sco.str()].emplace(std::move(slice)));
+                    VERIFY(res.second);
+                }
             }
         }
 
@@ -590,63 +748,245 @@ DataStoreNG::readClusters(const std::vector<ClusterReadDescriptor>& descs)
         InsistOnLatestVersion::F :
         InsistOnLatestVersion::T;
 
-    // Candidate for parallelization
+    auto partial_read([&](const SCOCloneID cid,
+                          const be::BackendConnectionInterface::PartialReads& partial_reads)
+                      {
+                          yt::SteadyTimer t;
+
+                          auto& bi = getVolume()->getBackendInterface(cid);
+                          auto fun([&](SCO sco,
+                                       bool& cached,
+                                       InsistOnLatestVersion) -> CachedSCOPtr
+                                   {
+                                       sco.cloneID(cid);
+
+                                       RLOCK_DATASTORE();
+                                       return getSCO_(sco,
+                                                      bi->clone(),
+                                                      cached,
+                                                      nullptr);
+                                   });
+
+                          PartialReadFallback fallback(fun);
+
+                          try
+                          {
+                              const be::PartialReadCounter prc(bi->partial_read(partial_reads,
+                                                                                fallback,
+                                                                                insist_on_latest));
+                              LOCK_PARTIAL_READ_COUNTER();
+                              partial_read_counter_ += prc;
+                          }
+                          catch (be::BackendConnectFailureException&)
+                          {
+                              throw TransientException("Backend connection failure");
+                          }
+
+                          cacheHitCounter_ += fallback.hits;
+                          cacheMissCounter_ += fallback.misses;
+
+                          if (fallback.misses or
+                              (fallback.hits == 0 and fallback.misses == 0))
+                          {
+                              const auto duration_us(bc::duration_cast<bc::microseconds>(t.elapsed()));
+                              PerformanceCounters& c = getVolume()->performance_counters();
+                              c.backend_read_request_usecs.count(duration_us.count());
+
+                              uint64_t bytes = 0;
+                              for (const auto& pr : partial_reads)
+                              {
+                                  for (const auto& slice : pr.second)
+                                  {
+                                      bytes += slice.size;
+                                  }
+                              }
+
+                              c.backend_read_request_size.count(bytes);
+                          }
+                      });
+
+    const uint32_t max_threads = VolManager::get()->partial_read_threads.value();
+    size_t num_scos = 0;
+
     for (const auto& partial_reads : partial_reads_map)
     {
-        yt::SteadyTimer t;
+        num_scos += partial_reads.second.size();
+    }
 
-        const SCOCloneID cid = partial_reads.first;
-        auto& bi = getVolume()->getBackendInterface(cid);
-        auto fun([&](SCO sco,
-                     bool& cached,
-                     InsistOnLatestVersion) -> CachedSCOPtr
-                 {
-                     sco.cloneID(cid);
+    if (max_threads <= 1 or num_scos <= 1)
+    {
+        for (const auto& partial_reads : partial_reads_map)
+        {
+            partial_read(partial_reads.first,
+                         partial_reads.second);
+        }
+    }
+    else
+    {
+        // Split up per clone *and* per SCO and have up to max_threads workers
+        // (the calling thread being one of them) of the VolManager's shared
+        // partial read pool pick those off.
+        using Work = std::pair<SCOCloneID,
+                               be::BackendConnectionInterface::PartialReads>;
+        std::vector<Work> work;
+        work.reserve(num_scos);
+
+        for (auto& partial_reads : partial_reads_map)
+        {
+            for (auto& pr : partial_reads.second)
+            {
+                be::BackendConnectionInterface::PartialReads reads;
+                reads.emplace(pr.first,
+                              std::move(pr.second));
+                work.emplace_back(partial_reads.first,
+                                  std::move(reads));
+            }
+        }
 
-                     RLOCK_DATASTORE();
-                     return getSCO_(sco,
-                                    bi->clone(),
-                                    cached,
-                                    nullptr);
-                 });
+        VolManager::get()->partial_read_pool().for_each_index(work.size(),
+                                                              max_threads,
+                                                              [&](size_t i)
+                                                              {
+                                                                  partial_read(work[i].first,
+                                                                               work[i].second);
+                                                              });
+    }
 
-        PartialReadFallback fallback(fun);
+    for (auto& f : sparse_fetches)
+    {
+        SparseChunkFetch& fetch = f.second;
 
-        try
+        for (const auto& c : fetch.copies)
         {
-            const be::PartialReadCounter prc(bi->partial_read(partial_reads.second,
-                                                              fallback,
-                                                              insist_on_latest));
-            LOCK_PARTIAL_READ_COUNTER();
-            partial_read_counter_ += prc;
+            memcpy(c.buf,
+                   fetch.buf.data() + (c.offset - fetch.offset),
+                   c.size);
         }
-        catch (be::BackendConnectFailureException&)
+
+        SparseSCOState& state = sparse_scos.at(f.first.first);
+        if (state.dropped)
         {
-            throw TransientException("Backend connection failure");
+            continue;
         }
 
-        cacheHitCounter_ += fallback.hits;
-        cacheMissCounter_ += fallback.misses;
-
-        if (fallback.misses or
-            (fallback.hits == 0 and fallback.misses == 0))
+        try
         {
-            const auto duration_us(bc::duration_cast<bc::microseconds>(t.elapsed()));
-            PerformanceCounters& c = getVolume()->performance_counters();
-            c.backend_read_request_usecs.count(duration_us.count());
+            fetch.sparse->write(fetch.buf.data(),
+                                fetch.buf.size(),
+                                fetch.offset);
+        }
+        CATCH_STD_ALL_EWHAT({
+                LOG_WARN(nspace_ << ": failed to fill in " <<
+                         fetch.sparse->path() << ": " << EWHAT);
+                drop_sparse_sco_(fetch.sparse);
+                state.dropped = true;
+            });
+    }
+}
+
+SparseSCOPtr
+DataStoreNG::get_sparse_sco_(SCO sco,
+                             size_t chunk_size)
+{
+    {
+        LOCK_SPARSE_SCOS();
 
-            uint64_t bytes = 0;
-            for (const auto& pr : partial_reads.second)
+        for (auto it = sparse_scos_.begin(); it != sparse_scos_.end(); ++it)
+        {
+            if ((*it)->getSCO() == sco and
+                (*it)->chunk_size() == chunk_size)
             {
-                for (const auto& slice : pr.second)
-                {
-                    bytes += slice.size;
-                }
+                // most recently used ones go to the back
+                sparse_scos_.splice(sparse_scos_.end(),
+                                    sparse_scos_,
+                                    it);
+                return sparse_scos_.back();
             }
+        }
+    }
+
+    uint64_t size;
+
+    try
+    {
+        SCO backend_sco(sco);
+        backend_sco.cloneID(SCOCloneID(0));
+        size = getVolume()->getBackendInterface(sco.cloneID())->getSize(backend_sco.str());
+    }
+    CATCH_STD_ALL_EWHAT({
+            LOG_WARN(nspace_ << ": failed to get the size of " << sco << ": " <<
+                     EWHAT << " - not caching it sparsely");
+            return nullptr;
+        });
+
+    // Destroyed outside of the lock (in reverse order of declaration).
+    SparseSCOPtr evicted;
+    std::list<SparseSCOPtr> stale;
+
+    LOCK_SPARSE_SCOS();
 
-            c.backend_read_request_size.count(bytes);
+    // A concurrent reader might have beaten us to it. Creating the file while
+    // holding the lock also keeps two of them from using the same path.
+    for (auto it = sparse_scos_.begin(); it != sparse_scos_.end(); ++it)
+    {
+        if ((*it)->getSCO() == sco)
+        {
+            if ((*it)->chunk_size() == chunk_size)
+            {
+                return *it;
+            }
+            else
+            {
+                // chunk size was changed in the meantime
+                stale.splice(stale.end(),
+                             sparse_scos_,
+                             it);
+                break;
+            }
         }
     }
+
+    SparseSCOPtr sparse;
+
+    try
+    {
+        sparse = scoCache_->createSparseSCO(nspace_,
+                                            sco,
+                                            size,
+                                            chunk_size);
+    }
+    CATCH_STD_ALL_EWHAT({
+            LOG_INFO(nspace_ << ": failed to create sparse SCO for " << sco <<
+                     ": " << EWHAT);
+            return nullptr;
+        });
+
+    sparse_scos_.push_back(sparse);
+
+    if (sparse_scos_.size() > max_sparse_scos_)
+    {
+        evicted = sparse_scos_.front();
+        sparse_scos_.pop_front();
+    }
+
+    return sparse;
+}
+
+void
+DataStoreNG::drop_sparse_sco_(const SparseSCOPtr& sparse)
+{
+    SparseSCOPtr p;
+
+    LOCK_SPARSE_SCOS();
+
+    auto it = std::find(sparse_scos_.begin(),
+                        sparse_scos_.end(),
+                        sparse);
+    if (it != sparse_scos_.end())
+    {
+        p = *it;
+        sparse_scos_.erase(it);
+    }
 }
 
 bool
@@ -846,11 +1186,24 @@ void
 DataStoreNG::writeClusterToLocation(const uint8_t* buf,
                                     const ClusterLocation& loc,
                                     uint32_t& throttle)
+{
+    writeClustersToLocation(buf,
+                            loc,
+                            1,
+                            throttle);
+}
+
+void
+DataStoreNG::writeClustersToLocation(const uint8_t* buf,
+                                     const ClusterLocation& loc,
+                                     size_t num_locs,
+                                     uint32_t& throttle)
 {
     WLOCK_DATASTORE();
-    LOG_DEBUG(nspace_ << ": forced write to " << loc << ", current loc: " <<
-              currentClusterLoc_);
+    LOG_DEBUG(nspace_ << ": forced write of " << num_locs << " clusters to " <<
+              loc << ", current loc: " << currentClusterLoc_);
 
+    VERIFY(num_locs > 0);
     VERIFY(loc.cloneID() == 0);
     VERIFY(loc.version() == 0);
 
@@ -862,9 +1215,9 @@ DataStoreNG::writeClusterToLocation(const uint8_t* buf,
                                  nspace_.c_str());
     }
 
-    std::vector<ClusterLocation> dummy(1);
-    writeClusters_(buf, dummy, 1, throttle);
-    VERIFY(dummy[0] == loc);
+    std::vector<ClusterLocation> locs(num_locs);
+    writeClusters_(buf, locs, num_locs, throttle);
+    VERIFY(locs[0] == loc);
 }
 
 void
@@ -1170,6 +1523,12 @@ void DataStoreNG::destroy(const DeleteLocalData delete_local_data)
         openSCOs_.erase(scoName);
     }
 
+    {
+        // before their directory goes away
+        LOCK_SPARSE_SCOS();
+        sparse_scos_.clear();
+    }
+
     if (T(delete_local_data))
     {
         //        checkSumStore_.destroy();
@@ -24,10 +24,12 @@
 #include "SCO.h"
 #include "SCOCache.h"
 #include "SCOFetcher.h"
+#include "SparseSCO.h"
 #include "VolumeBackPointer.h"
 #include "VolumeConfig.h"
 #include "WriteSCOCache.h"
 
+#include <list>
 #include <vector>
 #include <set>
 
@@ -151,6 +153,14 @@ public:
                            const ClusterLocation& loc,
                            uint32_t& throttle);
 
+    // num_locs consecutive clusters starting at loc, which has to be the
+    // current cluster location (cf. FOC replay)
+    void
+    writeClustersToLocation(const uint8_t* buf,
+                            const ClusterLocation& loc,
+                            size_t num_locs,
+                            uint32_t& throttle);
+
     void
     writeClusters(const uint8_t* buf,
                   std::vector<ClusterLocation>& locs,
@@ -280,11 +290,18 @@ private:
     //  * pendingTLogSCOs_
     //  -- to modify any of these, the lock needs to be held exclusively
     //  (2) error_lock_ serializes error reporting
-    // Lock order: (1) before (2)
+    //  (3) sparse_scos_lock_ protects sparse_scos_
+    // Lock order: (1) before (2), (1) before (3)
 
     mutable boost::shared_mutex rw_lock_;
     mutable boost::mutex error_lock_;
     mutable fungi::SpinLock partial_read_counter_lock_;
+    mutable boost::mutex sparse_scos_lock_;
+
+    // Backend SCOs that are partially cached (cf. sparse_sco_chunk_size), least
+    // recently used first.
+    std::list<SparseSCOPtr> sparse_scos_;
+    static constexpr size_t max_sparse_scos_ = 32;
 
     std::atomic<uint64_t> cacheHitCounter_;
     std::atomic<uint64_t> cacheMissCounter_;
@@ -330,6 +347,14 @@ private:
     MaybeCheckSum
     pushAndUpdateCurrentSCO_(bool ignore_transient_errors = true);
 
+    // Returns nullptr if it cannot be cached sparsely.
+    SparseSCOPtr
+    get_sparse_sco_(SCO,
+                    size_t chunk_size);
+
+    void
+    drop_sparse_sco_(const SparseSCOPtr&);
+
     bool
     read_adjacent_clusters_(const ClusterReadDescriptor&,
                             size_t count,
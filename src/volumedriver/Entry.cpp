@@ -44,6 +44,14 @@ Entry::Entry(const CheckSum& checksum,
            type == Type::SCOCRC);
 }
 
+Entry::Entry(const ClusterAddress& ca)
+    : clusteraddress_(ca bitor discard_flag_)
+    , loc_and_hash_(ClusterLocationAndHash::discarded_location_and_hash())
+{
+    VERIFY(loc_and_hash_.clusterLocation.isNull());
+    THROW_UNLESS(ca <= max_valid_cluster_address());
+}
+
 ClusterAddress
 Entry::clusterAddress() const
 {
@@ -51,6 +59,12 @@ Entry::clusterAddress() const
     {
         THROW_UNLESS(clusteraddress_ <= max_valid_cluster_address());
     }
+    else if (clusteraddress_ bitand discard_flag_)
+    {
+        const ClusterAddress ca = clusteraddress_ bitand ~discard_flag_;
+        THROW_UNLESS(ca <= max_valid_cluster_address());
+        return ca;
+    }
 
     return clusteraddress_;
 }
@@ -74,6 +88,11 @@ Entry::type() const
     {
         return Type::LOC;
     }
+    else if ((clusteraddress_ bitand discard_flag_) and
+             (clusteraddress_ bitand ~discard_flag_) <= max_valid_cluster_address())
+    {
+        return Type::Discard;
+    }
     else
     {
         const uint64_t crc_type = clusteraddress_ >> checksum_shift_;
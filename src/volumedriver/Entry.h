@@ -40,7 +40,8 @@ public:
         SyncTC = 0,
         TLogCRC = 1,
         SCOCRC = 2,
-        LOC = 3
+        LOC = 3,
+        Discard = 4,
     };
 
     // SyncTC
@@ -54,6 +55,9 @@ public:
     Entry(const CheckSum& cs,
           Type t);
 
+    // Discard
+    explicit Entry(const ClusterAddress&);
+
     ~Entry() = default;
 
     Entry(const Entry&) = default;
@@ -79,6 +83,7 @@ MAKE_CHECKER(isLocation, Type::LOC)
 MAKE_CHECKER(isTLogCRC, Type::TLogCRC)
 MAKE_CHECKER(isSCOCRC, Type::SCOCRC)
 MAKE_CHECKER(isSync, Type::SyncTC)
+MAKE_CHECKER(isDiscard, Type::Discard)
 
 #undef MAKE_CHECKER
 
@@ -129,6 +134,10 @@ private:
 
     static constexpr uint64_t checksum_shift_ = 32;
     static constexpr uint64_t checksum_mask_ = (1ULL << checksum_shift_) - 1;
+
+    // Discard entries carry the cluster address with this flag set and the
+    // location of a discarded cluster (i.e. a null one).
+    static constexpr uint64_t discard_flag_ = 1ULL << 63;
 };
 
 static_assert(sizeof(Entry) == sizeof(ClusterAddress) + sizeof(ClusterLocationAndHash),
@@ -150,6 +159,8 @@ operator<<(std::ostream& os,
         return os << "SCOCRC";
     case Entry::Type::LOC:
         return os << "LOC";
+    case Entry::Type::Discard:
+        return os << "Discard";
     }
     UNREACHABLE
 }
@@ -92,6 +92,10 @@ protected:
         {
             processSync();
         }
+        else if(e->isDiscard())
+        {
+            processDiscard(e->clusterAddress());
+        }
         else
         {
             LOG_FATAL("Unknown Entry in TLOG, this should not happen!");
@@ -112,6 +116,11 @@ protected:
     virtual void
     processSync() = 0;
 
+    // Discard entries are ignored unless asked for.
+    virtual void
+    processDiscard(ClusterAddress /*a*/)
+    {}
+
     DECLARE_LOGGER("Dispatcher");
 };
 
@@ -0,0 +1,327 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+#include "CachedMetaDataPage.h"
+#include "CombinedTLogReader.h"
+#include "ExternalPageSortingGenerator.h"
+
+#include <algorithm>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/optional.hpp>
+
+#include <youtils/Assert.h>
+#include <youtils/Catchers.h>
+#include <youtils/IOException.h>
+#include <youtils/UUID.h>
+
+namespace volumedriver
+{
+
+namespace fs = boost::filesystem;
+namespace yt = youtils;
+
+namespace
+{
+
+// entries read from a run file in one go
+const size_t read_buffer_entries = 64ULL << 10;
+
+bool
+same_address(const Entry& a,
+             const Entry& b)
+{
+    return a.clusterAddress() == b.clusterAddress();
+}
+
+// smallest address first; for the same address the newest run first
+bool
+heap_less(const std::pair<ClusterAddress, size_t>& a,
+          const std::pair<ClusterAddress, size_t>& b)
+{
+    return a.first > b.first or
+        (a.first == b.first and a.second < b.second);
+}
+
+}
+
+ExternalPageSortingGenerator::ExternalPageSortingGenerator(const CloneTLogs& ctl,
+                                                           const NSIDMap& nsidmap,
+                                                           const fs::path& tlog_path,
+                                                           const fs::path& scratch_dir,
+                                                           size_t run_entries)
+    : dir_(scratch_dir / ("page_sort_" + yt::UUID().str()))
+    , run_entries_(run_entries)
+{
+    VERIFY(run_entries_ > 0);
+
+    fs::create_directories(dir_);
+
+    try
+    {
+        std::vector<Entry> buf;
+        buf.reserve(run_entries_);
+
+        uint64_t entries = 0;
+
+        for (const auto& p : ctl)
+        {
+            const SCOCloneID cloneid = p.first;
+
+            std::unique_ptr<TLogReaderInterface>
+                r(CombinedTLogReader::create(tlog_path,
+                                             p.second,
+                                             nsidmap.get(cloneid)->clone(),
+                                             CombinedTLogReader::FetchStrategy::Parallel));
+
+            const Entry* e;
+            while ((e = r->nextLocationOrDiscard()))
+            {
+                if (e->isDiscard())
+                {
+                    buf.emplace_back(*e);
+                }
+                else
+                {
+                    ClusterLocationAndHash loc(e->clusterLocationAndHash());
+                    loc.clusterLocation.cloneID(cloneid);
+                    buf.emplace_back(e->clusterAddress(),
+                                     loc);
+                }
+                ++entries;
+
+                if (buf.size() >= run_entries_)
+                {
+                    spill_(buf);
+                }
+            }
+        }
+
+        if (runs_.empty())
+        {
+            // everything fits into memory - no need to go through a file
+            sort_and_dedup_(buf);
+            runs_.emplace_back(Run{ nullptr,
+                                    0,
+                                    0,
+                                    std::move(buf),
+                                    0 });
+        }
+        else if (not buf.empty())
+        {
+            spill_(buf);
+        }
+
+        LOG_INFO(entries << " entries, " << runs_.size() << " sorted run(s)");
+
+        for (size_t i = 0; i < runs_.size(); ++i)
+        {
+            if (refill_(runs_[i]))
+            {
+                push_(i);
+            }
+        }
+
+        fill_current_();
+    }
+    catch (...)
+    {
+        runs_.clear();
+        fs::remove_all(dir_);
+        throw;
+    }
+}
+
+ExternalPageSortingGenerator::~ExternalPageSortingGenerator()
+{
+    runs_.clear();
+
+    try
+    {
+        fs::remove_all(dir_);
+    }
+    CATCH_STD_ALL_LOG_IGNORE("Failed to remove " << dir_);
+}
+
+void
+ExternalPageSortingGenerator::sort_and_dedup_(std::vector<Entry>& entries)
+{
+    // stable: entries for the same address stay in TLog order, i.e. the newest
+    // one comes last ...
+    std::stable_sort(entries.begin(),
+                     entries.end(),
+                     [](const Entry& a,
+                        const Entry& b)
+                     {
+                         return a.clusterAddress() < b.clusterAddress();
+                     });
+
+    // ... and is the one that's kept when uniquing from the back.
+    auto it = std::unique(entries.rbegin(),
+                          entries.rend(),
+                          same_address);
+    entries.erase(entries.begin(),
+                  it.base());
+}
+
+void
+ExternalPageSortingGenerator::spill_(std::vector<Entry>& entries)
+{
+    sort_and_dedup_(entries);
+
+    const fs::path p(dir_ / ("run_" + boost::lexical_cast<std::string>(runs_.size())));
+    LOG_INFO("spilling " << entries.size() << " entries to " << p);
+
+    auto fd(std::make_unique<yt::FileDescriptor>(p,
+                                                 yt::FDMode::ReadWrite,
+                                                 CreateIfNecessary::T,
+                                                 SyncOnCloseAndDestructor::F));
+    const size_t size = entries.size() * sizeof(Entry);
+    const size_t w = fd->pwrite(entries.data(),
+                                size,
+                                0);
+    if (w != size)
+    {
+        LOG_ERROR(p << ": short write, expected " << size << ", got " << w);
+        throw fungi::IOException("Short write to sorted run",
+                                 p.string().c_str());
+    }
+
+    runs_.emplace_back(Run{ std::move(fd),
+                            entries.size(),
+                            0,
+                            std::vector<Entry>(),
+                            0 });
+    entries.clear();
+}
+
+bool
+ExternalPageSortingGenerator::refill_(Run& run)
+{
+    if (run.pos < run.buf.size())
+    {
+        return true;
+    }
+
+    run.buf.clear();
+    run.pos = 0;
+
+    if (run.fd == nullptr or run.off == run.size)
+    {
+        return false;
+    }
+
+    const size_t n = std::min<uint64_t>(read_buffer_entries,
+                                        run.size - run.off);
+    run.buf.resize(n);
+
+    const size_t size = n * sizeof(Entry);
+    const size_t r = run.fd->pread(run.buf.data(),
+                                   size,
+                                   run.off * sizeof(Entry));
+    if (r != size)
+    {
+        LOG_ERROR(run.fd->path() << ": short read, expected " << size << ", got " << r);
+        throw fungi::IOException("Short read from sorted run",
+                                 run.fd->path().string().c_str());
+    }
+
+    run.off += n;
+    return true;
+}
+
+void
+ExternalPageSortingGenerator::push_(size_t idx)
+{
+    const Run& run = runs_[idx];
+    ASSERT(run.pos < run.buf.size());
+
+    heap_.emplace_back(run.buf[run.pos].clusterAddress(),
+                       idx);
+    std::push_heap(heap_.begin(),
+                   heap_.end(),
+                   heap_less);
+}
+
+void
+ExternalPageSortingGenerator::fill_current_()
+{
+    current_.reset();
+
+    boost::optional<PageAddress> page;
+    boost::optional<ClusterAddress> last;
+
+    while (not heap_.empty())
+    {
+        const HeapEntry top(heap_.front());
+        const PageAddress pa = CachePage::pageAddress(top.first);
+
+        if (page and *page != pa)
+        {
+            break;
+        }
+
+        std::pop_heap(heap_.begin(),
+                      heap_.end(),
+                      heap_less);
+        heap_.pop_back();
+
+        Run& run = runs_[top.second];
+
+        // older entries for an address that was already handed out are skipped
+        if (not last or *last != top.first)
+        {
+            if (not current_)
+            {
+                current_.reset(new PageData());
+                page = pa;
+            }
+
+            current_->push_back(run.buf[run.pos]);
+            last = top.first;
+        }
+
+        ++run.pos;
+        if (refill_(run))
+        {
+            push_(top.second);
+        }
+    }
+}
+
+void
+ExternalPageSortingGenerator::next()
+{
+    VERIFY(current_ != nullptr);
+    fill_current_();
+}
+
+bool
+ExternalPageSortingGenerator::finished()
+{
+    return current_ == nullptr;
+}
+
+PageDataPtr&
+ExternalPageSortingGenerator::current()
+{
+    return current_;
+}
+
+}
+
+// Local Variables: **
+// mode: c++ **
+// End: **
@@ -0,0 +1,122 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+#ifndef EXTERNAL_PAGE_SORTING_GENERATOR_H_
+#define EXTERNAL_PAGE_SORTING_GENERATOR_H_
+
+#include "Entry.h"
+#include "NSIDMap.h"
+#include "PageSortingGenerator.h"
+#include "Types.h"
+
+#include <memory>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <youtils/FileDescriptor.h>
+#include <youtils/Generator.h>
+#include <youtils/Logging.h>
+
+namespace volumedriver
+{
+
+// Bulk loading counterpart of the PageSortingGenerator_: all location entries
+// of the clone TLogs (oldest clone first) are run through an external merge
+// sort keyed by cluster address - sorted runs of at most `run_entries' entries
+// are spilled to files below the scratch dir and merged afterwards. Entries
+// for the same cluster address are deduplicated (newest wins) along the way,
+// so every page is handed out exactly once, in ascending order, and holds at
+// most one entry per cluster. The entries carry the SCOCloneID of their TLog.
+class ExternalPageSortingGenerator
+    : public youtils::Generator<PageDataPtr>
+{
+public:
+    ExternalPageSortingGenerator(const CloneTLogs& ctl,
+                                 const NSIDMap& nsidmap,
+                                 const boost::filesystem::path& tlog_path,
+                                 const boost::filesystem::path& scratch_dir,
+                                 size_t run_entries);
+
+    virtual ~ExternalPageSortingGenerator();
+
+    ExternalPageSortingGenerator(const ExternalPageSortingGenerator&) = delete;
+
+    ExternalPageSortingGenerator&
+    operator=(const ExternalPageSortingGenerator&) = delete;
+
+    virtual void
+    next() override final;
+
+    virtual bool
+    finished() override final;
+
+    virtual PageDataPtr&
+    current() override final;
+
+    size_t
+    runs() const
+    {
+        return runs_.size();
+    }
+
+private:
+    DECLARE_LOGGER("ExternalPageSortingGenerator");
+
+    struct Run
+    {
+        // nullptr for a run that's kept in memory
+        std::unique_ptr<youtils::FileDescriptor> fd;
+        // entries in the file
+        uint64_t size;
+        // entries read from the file so far
+        uint64_t off;
+        std::vector<Entry> buf;
+        size_t pos;
+    };
+
+    // (cluster address, run index)
+    using HeapEntry = std::pair<ClusterAddress, size_t>;
+
+    const boost::filesystem::path dir_;
+    const size_t run_entries_;
+
+    std::vector<Run> runs_;
+    std::vector<HeapEntry> heap_;
+    PageDataPtr current_;
+
+    static void
+    sort_and_dedup_(std::vector<Entry>&);
+
+    void
+    spill_(std::vector<Entry>&);
+
+    bool
+    refill_(Run&);
+
+    void
+    push_(size_t run_idx);
+
+    void
+    fill_current_();
+};
+
+}
+
+#endif // !EXTERNAL_PAGE_SORTING_GENERATOR_H_
+
+// Local Variables: **
+// mode: c++ **
+// End: **
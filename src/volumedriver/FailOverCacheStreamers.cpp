@@ -131,7 +131,9 @@ operator>>(fungi::IOBaseStream& stream, CommandData<AddEntries>& data)
             VERIFY(data.buf_ == nullptr);
 
             cluster_size = sz;
-            data.buf_ = std::make_unique<uint8_t[]>(cluster_size * count);
+            data.buf_ = data.pool_ ?
+                data.pool_->get(cluster_size * count) :
+                failovercache::ReceiveBufferPool::get_unpooled(cluster_size * count);
             ptr = data.buf_.get();
         }
         else
@@ -17,6 +17,7 @@
 #define FAILOVERCACHESTREAMERS_H
 
 #include "failovercache/fungilib/IOBaseStream.h"
+#include "failovercache/ReceiveBufferPool.h"
 #include <youtils/IOException.h>
 #include "Types.h"
 #include <boost/ptr_container/ptr_vector.hpp>
@@ -104,7 +105,10 @@ struct CommandData<AddEntries>
     {}
 
     // Only used when streaming in
-    std::unique_ptr<uint8_t[]> buf_;
+    failovercache::ReceiveBuffer buf_;
+
+    // Only used when streaming in - optional, buf_ is taken from it if set
+    std::shared_ptr<failovercache::ReceiveBufferPool> pool_;
 
     // Only used when streaming out
     CommandData() = default;
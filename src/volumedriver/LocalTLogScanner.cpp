@@ -93,6 +93,29 @@ LocalTLogScanner::processSync()
     ASSERT(not aborted_);
 }
 
+void
+LocalTLogScanner::processDiscard(ClusterAddress ca)
+{
+    ASSERT(not aborted_);
+    ASSERT(current_proc_);
+
+    LOG_TRACE("Processing discard of clusteraddress " << ca);
+
+    if (replay_queue_.empty())
+    {
+        // Nothing pending that could still be thrown away: discards do not
+        // refer to SCO data, so there's no checksum to wait for.
+        mdstore_.writeCluster(ca,
+                              ClusterLocationAndHash::discarded_location_and_hash());
+        last_good_tlog_.second = current_proc_->num_entries_ + 1;
+    }
+    else
+    {
+        replay_queue_.emplace_back(ca,
+                                   ClusterLocationAndHash::discarded_location_and_hash());
+    }
+}
+
 void
 LocalTLogScanner::scanTLog(const TLogId& tlog_id)
 {
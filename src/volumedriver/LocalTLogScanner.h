@@ -64,6 +64,9 @@ public:
     virtual void
     processSync() override final;
 
+    virtual void
+    processDiscard(ClusterAddress) override final;
+
     using TLogIdAndSize = std::pair<TLogId, uint64_t>;
 
     const TLogIdAndSize&
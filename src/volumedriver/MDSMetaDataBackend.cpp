@@ -184,6 +184,42 @@ MDSMetaDataBackend::getPage(CachePage& p)
     }
 }
 
+std::vector<bool>
+MDSMetaDataBackend::getPages(const std::vector<CachePage*>& pages)
+{
+    LOG_TRACE(table_->nspace() << ": " << pages.size() << " pages");
+
+    mds::TableInterface::Keys keys;
+    keys.reserve(pages.size());
+
+    for (const CachePage* p : pages)
+    {
+        keys.emplace_back(mds::Key(p->page_address()));
+    }
+
+    const mds::TableInterface::MaybeStrings ms(table_->multiget(keys));
+    VERIFY(ms.size() == pages.size());
+
+    std::vector<bool> found;
+    found.reserve(pages.size());
+
+    for (size_t i = 0; i < pages.size(); ++i)
+    {
+        if (ms[i] != boost::none)
+        {
+            VERIFY(ms[i]->size() == CachePage::size());
+            memcpy(pages[i]->data(), ms[i]->data(), ms[i]->size());
+            found.push_back(true);
+        }
+        else
+        {
+            found.push_back(false);
+        }
+    }
+
+    return found;
+}
+
 void
 MDSMetaDataBackend::putPage(const CachePage& p,
                             int32_t used_clusters_delta)
@@ -59,6 +59,9 @@ public:
     bool
     getPage(CachePage& p) override final;
 
+    std::vector<bool>
+    getPages(const std::vector<CachePage*>& pages) override final;
+
     void
     putPage(const CachePage& p,
             int32_t used_clusters_delta) override final;
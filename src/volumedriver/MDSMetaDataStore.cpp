@@ -333,6 +333,21 @@ MDSMetaDataStore::readCluster(const ClusterAddress addr,
                                      loc);
 }
 
+void
+MDSMetaDataStore::readClusters(const ClusterAddress start,
+                               const size_t count,
+                               ClusterLocationAndHash* locs)
+{
+    handle_<void,
+            ClusterAddress,
+            size_t,
+            ClusterLocationAndHash*>(__FUNCTION__,
+                                     &MetaDataStoreInterface::readClusters,
+                                     start,
+                                     count,
+                                     locs);
+}
+
 void
 MDSMetaDataStore::writeCluster(const ClusterAddress addr,
                                const ClusterLocationAndHash& loc)
@@ -405,6 +420,24 @@ MDSMetaDataStore::processCloneTLogs(const CloneTLogs& ctl,
                             uuid);
 }
 
+void
+MDSMetaDataStore::bulkLoadCloneTLogs(const CloneTLogs& ctl,
+                                     const NSIDMap& nsidmap,
+                                     const fs::path& tlog_location,
+                                     const boost::optional<youtils::UUID>& uuid)
+{
+    handle_<void,
+            decltype(ctl),
+            decltype(nsidmap),
+            decltype(tlog_location),
+            decltype(uuid)>(__FUNCTION__,
+                            &MetaDataStoreInterface::bulkLoadCloneTLogs,
+                            ctl,
+                            nsidmap,
+                            tlog_location,
+                            uuid);
+}
+
 bool
 MDSMetaDataStore::compare(MetaDataStoreInterface& other)
 {
@@ -65,6 +65,11 @@ public:
     readCluster(const ClusterAddress addr,
                 ClusterLocationAndHash& loc) override;
 
+    virtual void
+    readClusters(const ClusterAddress start,
+                 const size_t count,
+                 ClusterLocationAndHash* locs) override;
+
     virtual void
     writeCluster(const ClusterAddress addr,
                  const ClusterLocationAndHash& loc) override;
@@ -89,6 +94,12 @@ public:
                       bool sync,
                       const boost::optional<youtils::UUID>& uuid) override;
 
+    virtual void
+    bulkLoadCloneTLogs(const CloneTLogs& ctl,
+                       const NSIDMap& nsidmap,
+                       const fs::path& tlog_location,
+                       const boost::optional<youtils::UUID>& uuid) override final;
+
     virtual uint64_t
     applyRelocs(RelocationReaderFactory&,
                 SCOCloneID,
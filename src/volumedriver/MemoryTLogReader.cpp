@@ -0,0 +1,141 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+#include "CompressedTLog.h"
+#include "MemoryTLogReader.h"
+#include "VolumeDriverError.h"
+
+#include <youtils/Assert.h>
+#include <youtils/Catchers.h>
+#include <youtils/FileDescriptor.h>
+#include <youtils/FileUtils.h>
+#include <youtils/ScopeExit.h>
+
+namespace volumedriver
+{
+
+namespace fs = boost::filesystem;
+namespace yt = youtils;
+
+MemoryTLogReader::MemoryTLogReader(const fs::path& tlog_path,
+                                   const std::string& name,
+                                   BackendInterfacePtr bi)
+    : pos_(0)
+{
+    LOG_TRACE(tlog_path << ", " << name);
+
+    const fs::path p(tlog_path / name);
+
+    if (fs::exists(p))
+    {
+        load_(p);
+    }
+    else
+    {
+        VERIFY(bi);
+
+        const fs::path tmp(yt::FileUtils::create_temp_file(tlog_path,
+                                                           name + "_temporary"));
+        auto on_exit(yt::make_scope_exit([&]
+                                         {
+                                             yt::FileUtils::removeFileNoThrow(tmp);
+                                         }));
+        try
+        {
+            bi->read(tmp,
+                     name,
+                     InsistOnLatestVersion::F);
+        }
+        CATCH_STD_ALL_EWHAT({
+                VolumeDriverError::report(events::VolumeDriverErrorCode::GetTLogFromBackend,
+                                          EWHAT,
+                                          VolumeId(bi->getNS().str()));
+                throw;
+            });
+
+        load_(tmp);
+    }
+}
+
+MemoryTLogReader::MemoryTLogReader(const fs::path& path)
+    : pos_(0)
+{
+    LOG_TRACE(path);
+    load_(path);
+}
+
+void
+MemoryTLogReader::load_(const fs::path& p)
+{
+    try
+    {
+        if (CompressedTLog::is_compressed(p))
+        {
+            CompressedTLog::decompress(p,
+                                       entries_);
+        }
+        else
+        {
+            yt::FileDescriptor fd(p,
+                                  yt::FDMode::Read);
+
+            const uint64_t size = fd.size();
+            if (size % sizeof(Entry))
+            {
+                LOG_WARN("trailing garbage in " << p << " ignored (" <<
+                         size % sizeof(Entry) << " bytes)");
+            }
+
+            entries_.resize(size / sizeof(Entry));
+
+            const size_t len = entries_.size() * sizeof(Entry);
+            const size_t r = fd.pread(entries_.data(),
+                                      len,
+                                      0);
+            if (r != len)
+            {
+                LOG_ERROR(p << ": short read, expected " << len << ", got " << r);
+                throw fungi::IOException("Short read from TLog",
+                                         p.string().c_str());
+            }
+        }
+    }
+    CATCH_STD_ALL_EWHAT({
+            VolumeDriverError::report(events::VolumeDriverErrorCode::ReadTLog,
+                                      EWHAT);
+            throw;
+        });
+
+    LOG_TRACE(p << ": " << entries_.size() << " entries");
+}
+
+const Entry*
+MemoryTLogReader::nextAny()
+{
+    if (pos_ < entries_.size())
+    {
+        return &entries_[pos_++];
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+}
+
+// Local Variables: **
+// mode: c++ **
+// End: **
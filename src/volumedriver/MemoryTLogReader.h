@@ -0,0 +1,79 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+#ifndef MEMORY_TLOG_READER_H_
+#define MEMORY_TLOG_READER_H_
+
+#include "Entry.h"
+#include "TLogReaderInterface.h"
+
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <youtils/Logging.h>
+
+#include <backend/BackendInterface.h>
+
+namespace volumedriver
+{
+
+// Reads a whole TLog (expanded if it's a CompressedTLog) into memory up front,
+// so a copy fetched from the backend can be removed again right away instead
+// of being kept in the TLog directory while it's consumed.
+class MemoryTLogReader
+    : public TLogReaderInterface
+{
+public:
+    // Uses tlog_path / name if present, otherwise fetches it from the backend.
+    MemoryTLogReader(const boost::filesystem::path& tlog_path,
+                     const std::string& name,
+                     BackendInterfacePtr bi);
+
+    explicit MemoryTLogReader(const boost::filesystem::path& path);
+
+    virtual ~MemoryTLogReader() = default;
+
+    MemoryTLogReader(const MemoryTLogReader&) = delete;
+
+    MemoryTLogReader&
+    operator=(const MemoryTLogReader&) = delete;
+
+    virtual const Entry*
+    nextAny() override final;
+
+    size_t
+    size() const
+    {
+        return entries_.size();
+    }
+
+private:
+    DECLARE_LOGGER("MemoryTLogReader");
+
+    std::vector<Entry> entries_;
+    size_t pos_;
+
+    void
+    load_(const boost::filesystem::path&);
+};
+
+}
+
+#endif // !MEMORY_TLOG_READER_H_
+
+// Local Variables: **
+// mode: c++ **
+// End: **
@@ -20,6 +20,8 @@
 #include "ScrubId.h"
 #include "Types.h"
 
+#include <vector>
+
 #include <youtils/IOException.h>
 
 namespace volumedriver
@@ -41,6 +43,23 @@ public:
     virtual bool
     getPage(CachePage& p) = 0;
 
+    // Fetches several pages in one go, the result indicates per page whether
+    // it was found. Backends that can batch lookups are expected to override
+    // this.
+    virtual std::vector<bool>
+    getPages(const std::vector<CachePage*>& pages)
+    {
+        std::vector<bool> found;
+        found.reserve(pages.size());
+
+        for (CachePage* p : pages)
+        {
+            found.push_back(getPage(*p));
+        }
+
+        return found;
+    }
+
     virtual bool
     isEmancipated() const = 0;
 
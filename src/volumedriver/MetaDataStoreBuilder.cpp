@@ -178,11 +178,22 @@ MetaDataStoreBuilder::update_metadata_store_(const boost::optional<yt::UUID>& fr
         {
             LOG_INFO(bi_->getNS() << ": replaying " << res.num_tlogs << " TLogs");
 
-            mdstore_.processCloneTLogs(tlogs,
-                                       nsid_map,
-                                       scratch_dir_,
-                                       true,
-                                       end_cork);
+            if (start_cork == boost::none)
+            {
+                // (re)building from scratch: sort all entries by page first
+                mdstore_.bulkLoadCloneTLogs(tlogs,
+                                            nsid_map,
+                                            scratch_dir_,
+                                            end_cork);
+            }
+            else
+            {
+                mdstore_.processCloneTLogs(tlogs,
+                                           nsid_map,
+                                           scratch_dir_,
+                                           true,
+                                           end_cork);
+            }
 
             if (res.full_rebuild or check_scrub_id == CheckScrubId::T)
             {
@@ -67,10 +67,39 @@ public:
     readCluster(const ClusterAddress addr,
                 ClusterLocationAndHash& loc) = 0;
 
+    // Looks up the locations of the clusters [start, start + count) and stores
+    // them in locs[0, count). Implementations are expected to override this to
+    // resolve all clusters of a page in one go.
+    virtual void
+    readClusters(const ClusterAddress start,
+                 const size_t count,
+                 ClusterLocationAndHash* locs)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            readCluster(start + i,
+                        locs[i]);
+        }
+    }
+
     virtual void
     writeCluster(const ClusterAddress addr,
                  const ClusterLocationAndHash& loc) = 0;
 
+    // Stores locs[i] for addrs[i], i in [0, count). Implementations are
+    // expected to override this to take their locks only once.
+    virtual void
+    writeClusters(const ClusterAddress* addrs,
+                  const ClusterLocationAndHash* locs,
+                  const size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            writeCluster(addrs[i],
+                         locs[i]);
+        }
+    }
+
     virtual void
     clear_all_keys() = 0;
 
@@ -91,6 +120,22 @@ public:
                       bool sync,
                       const boost::optional<youtils::UUID>& uuid) = 0;
 
+    // Like processCloneTLogs (with sync), for (re)building the store from
+    // scratch. Implementations are expected to override this to write each
+    // page only once.
+    virtual void
+    bulkLoadCloneTLogs(const CloneTLogs& ctl,
+                       const NSIDMap& nsidmap,
+                       const boost::filesystem::path& tlog_location,
+                       const boost::optional<youtils::UUID>& uuid)
+    {
+        processCloneTLogs(ctl,
+                          nsidmap,
+                          tlog_location,
+                          true,
+                          uuid);
+    }
+
     virtual uint64_t
     applyRelocs(RelocationReaderFactory&,
                 SCOCloneID,
@@ -13,6 +13,7 @@
 // Open vStorage is distributed in the hope that it will be useful,
 // but WITHOUT ANY WARRANTY of any kind.
 
+#include "CompressedTLog.h"
 #include "OneFileTLogReader.h"
 #include "TLogWriter.h"
 #include "VolumeDriverError.h"
@@ -54,10 +55,11 @@ OneFileTLogReader::OneFileTLogReader(const fs::path& TLogPath,
 
         unlinkOnDestruction_ = true;
     }
-    setFileSize_(tmp);
 
     try
     {
+        tmp = maybe_decompress_(tmp);
+        setFileSize_(tmp);
         file_.reset(new FileDescriptor(tmp, FDMode::Read));
     }
     CATCH_STD_ALL_EWHAT({
@@ -75,8 +77,9 @@ OneFileTLogReader::OneFileTLogReader(const fs::path& path)
     LOG_TRACE(path);
     try
     {
-        setFileSize_(path);
-        file_.reset(new FileDescriptor(path,FDMode::Read));
+        const fs::path p(maybe_decompress_(path));
+        setFileSize_(p);
+        file_.reset(new FileDescriptor(p, FDMode::Read));
     }
     CATCH_STD_ALL_EWHAT({
             VolumeDriverError::report(events::VolumeDriverErrorCode::ReadTLog,
@@ -102,6 +105,37 @@ OneFileTLogReader::~OneFileTLogReader()
     }
 }
 
+fs::path
+OneFileTLogReader::maybe_decompress_(const fs::path& path)
+{
+    if (not CompressedTLog::is_compressed(path))
+    {
+        return path;
+    }
+
+    const fs::path tmp(FileUtils::create_temp_file(path.parent_path(),
+                                                   path.filename().string() +
+                                                   "_decompressed"));
+    try
+    {
+        CompressedTLog::decompress(path,
+                                   tmp);
+    }
+    catch (...)
+    {
+        fs::remove(tmp);
+        throw;
+    }
+
+    if (unlinkOnDestruction_)
+    {
+        fs::remove(path);
+    }
+
+    unlinkOnDestruction_ = true;
+    return tmp;
+}
+
 void
 OneFileTLogReader::setFileSize_(const fs::path& path)
 {
@@ -49,6 +49,11 @@ private:
 
     void
     setFileSize_(const fs::path& path);
+
+    // Returns the path of an expanded copy (removed on destruction) if `path'
+    // is a CompressedTLog, `path' otherwise.
+    fs::path
+    maybe_decompress_(const fs::path& path);
 };
 }
 
@@ -103,7 +103,7 @@ private:
             VERIFY(cached_ < max_);
 
             const Entry* e;
-            while((e = reader_->nextLocation()))
+            while((e = reader_->nextLocationOrDiscard()))
             {
                 PageAddress pageAddress = CachePage::pageAddress(e->clusterAddress());
                 makePagesUpTo_(pageAddress);
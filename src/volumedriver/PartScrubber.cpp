@@ -27,8 +27,8 @@ namespace scrubbing
 using namespace volumedriver;
 
 // Not so good since it's coupled too tightly to TLogSplitter
-PartScrubber::PartScrubber(TLogSplitter::MapType::const_iterator& iterator,
-                           scrubbing::ScrubbingSCODataVector& scodata,
+PartScrubber::PartScrubber(TLogSplitter::MapType::const_iterator iterator,
+                           const scrubbing::ScrubbingSCODataVector& scodata,
                            FilePool& filepool,
                            RegionExponent regionsize,
                            ClusterExponent clustersize)
@@ -36,6 +36,7 @@ PartScrubber::PartScrubber(TLogSplitter::MapType::const_iterator& iterator,
     , clustersize_(clustersize)
     , regionsize_(regionsize)
     , scodata_(scodata)
+    , usage_counts_(scodata.size(), 0)
     , filepool_(filepool)
 {
     cluster_begin_ = (iterator_->first << regionsize_);
@@ -56,13 +57,27 @@ PartScrubber::updateIterator(const SCO sconame)
     }
     else
     {
-        ++(scodata_iterator->usageCount);
-        VERIFY(scodata_iterator->size >= scodata_iterator->usageCount);
+        uint16_t& count =
+            usage_counts_[scodata_.rend() - scodata_iterator - 1];
+        ++count;
+        VERIFY(scodata_iterator->size >= count);
     }
 }
 
 void
-PartScrubber::operator()(std::vector<fs::path>& tlogs)
+PartScrubber::applyUsageCounts(ScrubbingSCODataVector& scodata) const
+{
+    VERIFY(scodata.size() == usage_counts_.size());
+
+    for (size_t i = 0; i < usage_counts_.size(); ++i)
+    {
+        scodata[i].usageCount += usage_counts_[i];
+        VERIFY(scodata[i].size >= scodata[i].usageCount);
+    }
+}
+
+fs::path
+PartScrubber::operator()()
 {
     BackwardTLogReader tlog_reader(iterator_->second);
 
@@ -87,8 +102,10 @@ PartScrubber::operator()(std::vector<fs::path>& tlogs)
     TLogWriter out_tlog(tlog_path);
     ss.clear();
 
+    std::unique_ptr<TLogWriter> discards_out;
+
     const Entry* e;
-    while((e = tlog_reader.nextLocation()))
+    while((e = tlog_reader.nextLocationOrDiscard()))
     {
         // switch(e->getType())
         // {
@@ -97,10 +114,25 @@ PartScrubber::operator()(std::vector<fs::path>& tlogs)
 
         if(not bitset[e->clusterAddress() - cluster_begin_])
         {
-            // We know it's a location entry here
-            out_tlog.add(e->clusterAddress(),
-                         e->clusterLocationAndHash());
-            updateIterator(e->clusterLocation().sco());
+            if(e->isDiscard())
+            {
+                // The older entries for this cluster are dead now - not
+                // counting them is what makes their data reclaimable.
+                if(not discards_out)
+                {
+                    std::stringstream ds;
+                    ds << "discards_for_region_" << iterator_->first;
+                    discards_tlog_ = filepool_.newFile(ds.str());
+                    discards_out.reset(new TLogWriter(*discards_tlog_));
+                }
+                discards_out->addDiscard(e->clusterAddress());
+            }
+            else
+            {
+                out_tlog.add(e->clusterAddress(),
+                             e->clusterLocationAndHash());
+                updateIterator(e->clusterLocation().sco());
+            }
             bitset[e->clusterAddress() - cluster_begin_] = true;
         }
 
@@ -110,7 +142,7 @@ PartScrubber::operator()(std::vector<fs::path>& tlogs)
         //     throw fungi::IOException("Unknown entry type");
         // }
     }
-    tlogs.push_back(tlog_path);
+    return tlog_path;
 }
 
 }
@@ -19,34 +19,57 @@
 #include "FilePool.h"
 #include "TLogSplitter.h"
 #include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
 
 namespace scrubbing
 {
+// Metadata scrubs a single region. The SCO data is only read while scrubbing,
+// the usage counts are gathered per PartScrubber and only added to the shared
+// SCO data by applyUsageCounts(), so several regions can be scrubbed concurrently
+// as long as the latter is serialized.
 class PartScrubber
 {
 public:
-    PartScrubber(TLogSplitter::MapType::const_iterator&,
-                 scrubbing::ScrubbingSCODataVector& scodata,
+    PartScrubber(TLogSplitter::MapType::const_iterator,
+                 const scrubbing::ScrubbingSCODataVector& scodata,
                  volumedriver::FilePool& filepool,
                  RegionExponent regionsize,
                  volumedriver::ClusterExponent clustersize);
 
+    // Returns the path of the metadatascrubbed (backward) tlog of the region.
+    fs::path
+    operator()();
+
+    // The region's discard entries that are still relevant (i.e. not followed
+    // by a write to the same cluster) are kept apart as they do not refer to a
+    // SCO - these have to be added back to the scrubbed tlogs.
+    const boost::optional<fs::path>&
+    discardsTLog() const
+    {
+        return discards_tlog_;
+    }
+
     void
-    operator()(std::vector<fs::path>& tlogs);
+    applyUsageCounts(scrubbing::ScrubbingSCODataVector& scodata) const;
 
 private:
     DECLARE_LOGGER("PartScrubber");
 
-    ScrubbingSCODataVector::reverse_iterator scodata_iterator;
+    ScrubbingSCODataVector::const_reverse_iterator scodata_iterator;
 
-    TLogSplitter::MapType::const_iterator& iterator_;
+    TLogSplitter::MapType::const_iterator iterator_;
     // What the F?
     const uint16_t clustersize_;
     RegionExponent regionsize_;
-    scrubbing::ScrubbingSCODataVector& scodata_;
+    const scrubbing::ScrubbingSCODataVector& scodata_;
+    // indexed like scodata_
+    std::vector<uint16_t> usage_counts_;
 
     volumedriver::FilePool& filepool_;
     volumedriver::ClusterAddress cluster_begin_;
+    boost::optional<fs::path> discards_tlog_;
 
     void
     updateIterator(const volumedriver::SCO sconame);
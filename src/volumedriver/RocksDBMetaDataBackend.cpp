@@ -245,6 +245,66 @@ RocksDBMetaDataBackend::getPage(CachePage& p)
     UNREACHABLE;
 }
 
+std::vector<bool>
+RocksDBMetaDataBackend::getPages(const std::vector<CachePage*>& pages)
+{
+    LOG_TRACE(pages.size() << " pages");
+
+    std::vector<PageAddress> pas;
+    pas.reserve(pages.size());
+
+    std::vector<rdb::Slice> keys;
+    keys.reserve(pages.size());
+
+    for (const CachePage* p : pages)
+    {
+        pas.push_back(p->page_address());
+        check_page_address_(pas.back());
+    }
+
+    for (const PageAddress& pa : pas)
+    {
+        keys.emplace_back(reinterpret_cast<const char*>(&pa),
+                          sizeof(pa));
+    }
+
+    std::vector<std::string> vals;
+    const std::vector<rdb::Status> statv(db_->MultiGet(make_read_options(),
+                                                       keys,
+                                                       &vals));
+
+    VERIFY(statv.size() == pages.size());
+    VERIFY(vals.size() == pages.size());
+
+    std::vector<bool> found;
+    found.reserve(pages.size());
+
+    for (size_t i = 0; i < statv.size(); ++i)
+    {
+        switch (statv[i].code())
+        {
+        case rdb::Status::kOk:
+            {
+                VERIFY(vals[i].size() == CachePage::size());
+                memcpy(pages[i]->data(), vals[i].data(), vals[i].size());
+                found.push_back(true);
+                break;
+            }
+        case rdb::Status::kNotFound:
+            {
+                found.push_back(false);
+                break;
+            }
+        default:
+            {
+                HANDLE(statv[i]);
+            }
+        }
+    }
+
+    return found;
+}
+
 void
 RocksDBMetaDataBackend::putPage(const CachePage& p,
                                 int32_t used_clusters_diff)
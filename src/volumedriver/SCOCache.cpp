@@ -1120,6 +1120,42 @@ SCOCache::removeSCO(const backend::Namespace& nsname,
                       unlink);
 }
 
+CachedSCOPtr
+SCOCache::findSCO_or_fetch_(const backend::Namespace& nsname,
+                            SCO scoName,
+                            boost::optional<std::shared_future<void>>& fetch)
+{
+    ASSERT_RWLOCKED();
+
+    fetch = boost::none;
+
+    SCOCacheNamespace* ns = findNamespace_throw_(nsname);
+    SCOCacheNamespaceEntry *e = ns->findEntry(scoName);
+    if (e)
+    {
+        if (e->isBlocked())
+        {
+            auto it = fetches_.find(e->getSCO().get());
+            if (it == fetches_.end())
+            {
+                // blocked for other reasons than a fetch (cf. setSCOAccessData)
+                LOG_DEBUG("sco " << ns->getName() << "/" << scoName <<
+                          " is blocked");
+                throw TransientException("sco is currently being fetched");
+            }
+
+            fetch = it->second;
+            return nullptr;
+        }
+
+        return e->getSCO();
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
 CachedSCOPtr
 SCOCache::getSCO_(const backend::Namespace& nsname,
                   SCO scoName,
@@ -1127,23 +1163,23 @@ SCOCache::getSCO_(const backend::Namespace& nsname,
                   SCOFetcher& fetch,
                   float xval,
                   bool* cached,
-                  bool /* prefetch */)
+                  bool prefetch)
 {
     if (cached)
     {
         *cached = false;
     }
 
-    CachedSCOPtr sco;
+    while (true)
     {
-        // Z42: any way to RLOCK_CACHE() first and upgrade to WLOCK_CACHE() only if
-        // we need to fetch it? boost::thread has the notion of upgradeable,
-        // shared locks...
-        WLOCK_CACHE();
-        try
+        boost::optional<std::shared_future<void>> pending;
+
         {
-            sco = findSCO_(nsname,
-                           scoName);
+            // Fast path: cache hits only need the shared lock.
+            RLOCK_CACHE();
+            CachedSCOPtr sco(findSCO_or_fetch_(nsname,
+                                               scoName,
+                                               pending));
             if (sco != nullptr)
             {
                 LOG_DEBUG("findSCO_ " << nsname << ":" << scoName << " succeeded");
@@ -1155,10 +1191,65 @@ SCOCache::getSCO_(const backend::Namespace& nsname,
                 return sco;
             }
         }
-        catch (TransientException&)
+
+        if (not pending)
+        {
+            CachedSCOPtr sco(fetchSCO_(nsname,
+                                       scoName,
+                                       scoSize,
+                                       fetch,
+                                       xval));
+            if (sco != nullptr)
+            {
+                return sco;
+            }
+        }
+
+        if (prefetch)
         {
+            // don't tie up the prefetcher with somebody else's fetch
             LOG_DEBUG("findSCO_ " << nsname << ":" << scoName << " reported blocked SCO");
-            throw;
+            throw TransientException("sco is currently being fetched");
+        }
+
+        if (pending)
+        {
+            // Single flight: wait for the concurrent fetch of this SCO and look
+            // it up again afterwards. Its errors are passed on to us.
+            LOG_DEBUG(nsname << ":" << scoName <<
+                      " is being fetched concurrently, waiting for it");
+            pending->get();
+        }
+    }
+}
+
+// Returns nullptr if the SCO is concurrently being fetched by someone else -
+// the caller needs to retry then.
+CachedSCOPtr
+SCOCache::fetchSCO_(const backend::Namespace& nsname,
+                    SCO scoName,
+                    uint64_t scoSize,
+                    SCOFetcher& fetch,
+                    float xval)
+{
+    CachedSCOPtr sco;
+    std::promise<void> promise;
+
+    {
+        WLOCK_CACHE();
+
+        boost::optional<std::shared_future<void>> pending;
+        sco = findSCO_or_fetch_(nsname,
+                                scoName,
+                                pending);
+        if (sco != nullptr)
+        {
+            LOG_DEBUG("findSCO_ " << nsname << ":" << scoName << " succeeded");
+            return sco;
+        }
+        else if (pending)
+        {
+            return nullptr;
         }
 
         LOG_DEBUG("findSCO_ " << nsname << ":" << scoName << " failed, fetching it");
@@ -1167,8 +1258,26 @@ SCOCache::getSCO_(const backend::Namespace& nsname,
                          scoSize,
                          xval,
                          true);
+
+        fetches_.emplace(sco.get(),
+                         promise.get_future().share());
     }
 
+    auto fail([&](std::exception_ptr ex,
+                  bool remove)
+              {
+                  {
+                      WLOCK_CACHE();
+                      fetches_.erase(sco.get());
+                      if (remove)
+                      {
+                          removeSCO_(sco, false);
+                      }
+                  }
+
+                  promise.set_exception(ex);
+              });
+
     try
     {
         fetch(sco->path());
@@ -1179,54 +1288,66 @@ SCOCache::getSCO_(const backend::Namespace& nsname,
     catch (SCOCacheMountPointIOException& e)
     {
         reportIOError(sco);
-        throw TransientException("Retryable I/O error");
+        const TransientException t("Retryable I/O error");
+        fail(std::make_exception_ptr(t),
+             false);
+        throw t;
     }
     catch(std::exception& e)
     {
         LOG_ERROR("fetching SCO " << nsname << ":" <<
                   scoName <<
                   " failed: " << e.what());
-
-        WLOCK_CACHE();
-        removeSCO_(sco, false);
+        fail(std::current_exception(),
+             true);
         throw;
-
     }
-
     catch (...)
     {
         LOG_ERROR("fetching SCO " << nsname << ":" <<
                   scoName <<
                   " failed, unkown exception");
-        WLOCK_CACHE();
-        removeSCO_(sco, false);
+        fail(std::current_exception(),
+             true);
         throw;
     }
 
-    WLOCK_CACHE();
-    if (fetch.disposable())
+    try
     {
-        try
+        WLOCK_CACHE();
+
+        fetches_.erase(sco.get());
+
+        if (fetch.disposable())
         {
-            sco->setDisposable();
+            try
+            {
+                sco->setDisposable();
+            }
+            catch (std::exception& e)
+            {
+                reportIOError_(sco);
+                throw;
+            }
         }
-        catch (std::exception& e)
+
+        // while the SCO is fetched and the rwlock was released, the mountpoint
+        // could've gone bad, so we need to do another lookup
+        try
         {
-            reportIOError_(sco);
-            throw;
+            SCOCacheNamespaceEntry* e = sco->getNamespace()->findEntry_throw(sco->getSCO());
+            e->setBlocked(false);
         }
+        CATCH_STD_ALL_LOG_RETHROW("Problem with mountpoint when getting SCO " <<
+                                  scoName << " From the FOC");
     }
-
-    // while the SCO is fetched and the rwlock was released, the mountpoint
-    // could've gone bad, so we need to do another lookup
-    try
+    catch (...)
     {
-        SCOCacheNamespaceEntry* e = sco->getNamespace()->findEntry_throw(sco->getSCO());
-        e->setBlocked(false);
+        promise.set_exception(std::current_exception());
+        throw;
     }
-    CATCH_STD_ALL_LOG_RETHROW("Problem with mountpoint when getting SCO " <<
-                              scoName << " From the FOC");
 
+    promise.set_value();
     return sco;
 }
 
@@ -1320,6 +1441,29 @@ SCOCache::prefetchSCO(const backend::Namespace& nsname,
     return true;
 }
 
+SparseSCOPtr
+SCOCache::createSparseSCO(const backend::Namespace& nsname,
+                          SCO scoName,
+                          uint64_t scoSize,
+                          size_t chunk_size)
+{
+    SCOCacheMountPointPtr mp;
+
+    {
+        WLOCK_CACHE();
+        findNamespace_throw_(nsname);
+        // chunks are only accounted for once they're filled in
+        mp = getWriteMountPoint_(chunk_size);
+    }
+
+    return std::make_shared<SparseSCO>(mp,
+                                       SparseSCO::make_path(mp->getPath() / nsname.str(),
+                                                            scoName),
+                                       scoName,
+                                       scoSize,
+                                       chunk_size);
+}
+
 void
 SCOCache::setSCODisposable(CachedSCOPtr sco)
 {
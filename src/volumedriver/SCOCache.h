@@ -22,13 +22,17 @@
 #include "SCOAccessData.h"
 #include "SCOFetcher.h"
 #include "SCOCacheInfo.h"
+#include "SparseSCO.h"
 #include "Types.h"
 #include "VolumeDriverParameters.h"
 
+#include <future>
 #include <list>
+#include <unordered_map>
 #include <vector>
 
 #include <boost/intrusive/set.hpp>
+#include <boost/optional.hpp>
 #include <boost/thread/mutex.hpp>
 
 #include <youtils/RWLock.h>
@@ -96,6 +100,14 @@ public:
                 float sap,
                 SCOFetcher& fetch);
 
+    // The sparse SCO is created on one of the mountpoints but otherwise not
+    // tracked - it's owned by the caller.
+    SparseSCOPtr
+    createSparseSCO(const backend::Namespace& nspace,
+                    SCO scoName,
+                    uint64_t scoSize,
+                    size_t chunk_size);
+
     // consumers of SCOCache need to use these 2 to be protected against races,
     // see CachedSCO.h
     void
@@ -260,6 +272,12 @@ private:
     SCOCacheMountPointList mountPoints_;
     SCOCacheMountPointList::const_iterator currentMountPoint_;
 
+    // SCOs that are being fetched by getSCO_ (their entries are blocked):
+    // concurrent requesters wait for the fetch to complete instead of bailing
+    // out with a TransientException. Protected by rwLock_.
+    std::unordered_map<const CachedSCO*,
+                       std::shared_future<void>> fetches_;
+
     typedef std::map<const Namespace, SCOCacheNamespace*> NSMap;
     NSMap nsMap_;
 
@@ -353,6 +371,20 @@ private:
     findSCO_(const Namespace& nsname,
              SCO scoName);
 
+    // Like findSCO_, but instead of throwing for a blocked SCO it returns
+    // its in-flight fetch (if there is one) via `fetch'.
+    CachedSCOPtr
+    findSCO_or_fetch_(const Namespace& nsname,
+                      SCO scoName,
+                      boost::optional<std::shared_future<void>>& fetch);
+
+    CachedSCOPtr
+    fetchSCO_(const Namespace& nsname,
+              SCO scoName,
+              uint64_t scoSize,
+              SCOFetcher& fetch,
+              float xval);
+
     void
     insertSCO_(CachedSCOPtr sco,
                bool blocked);
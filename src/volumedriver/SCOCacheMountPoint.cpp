@@ -17,6 +17,7 @@
 #include "SCOCache.h"
 #include "SCOCacheMountPoint.h"
 #include "SCOCacheNamespace.h"
+#include "SparseSCO.h"
 
 #include <boost/serialization/string.hpp>
 #include <boost/archive/binary_oarchive.hpp>
@@ -147,7 +148,13 @@ SCOCacheMountPoint::scan_()
         }
         else
         {
-            if (not SCO::isSCOString(it->path().filename().string()))
+            if (SparseSCO::is_sparse_sco_path(it->path()))
+            {
+                // left over from before the restart
+                LOG_INFO(path_ << ": removing sparse SCO " << it->path());
+                fs::remove(it->path());
+            }
+            else if (not SCO::isSCOString(it->path().filename().string()))
             {
                 LOG_WARN(path_ << ": ignoring non-SCO entry " << it->path());
             }
@@ -278,6 +285,11 @@ SCOCacheMountPoint::scanNamespace(SCOCacheNamespace* nspace)
            continue;
        }
 
+       if (SparseSCO::is_sparse_sco_path(it->path()))
+       {
+           continue;
+       }
+
        const std::string fname(it->path().filename().string());
        if (!SCO::isSCOString(fname))
        {
@@ -55,6 +55,7 @@ SCOPool::SCOPool(ScrubbingSCODataVector& scos,
     , new_scos_(new_scos)
     , number_of_scos_read_from_backend(0)
     , number_of_scos_written_to_backend(0)
+    , next_prefetch_(0)
 {
     // Make sure the last SCO is not scrubbed away. This is needed to ensure that the failover
     // cache can be replayed without gaps in case or restart.
@@ -68,6 +69,131 @@ SCOPool::SCOPool(ScrubbingSCODataVector& scos,
     }
 }
 
+namespace
+{
+
+// Number of SCO downloads in flight while rewriting.
+const size_t prefetch_depth = 2;
+
+}
+
+// Whether doEntry is going to rewrite an SCO it comes across in state Unknown -
+// also used to predict which SCOs to prefetch.
+bool
+SCOPool::rewrite_(const ScrubbingSCOData& d) const
+{
+    return d.usageCount < minimum_used_entries_;
+}
+
+void
+SCOPool::prefetch_()
+{
+    while (prefetches_.size() < prefetch_depth and
+           next_prefetch_ < scos_to_fetch_.size())
+    {
+        const SCO sco = scos_to_fetch_[next_prefetch_++];
+        const fs::path sco_path = filepool_.newFile(sco.str());
+
+        prefetches_.emplace_back(sco,
+                                 std::async(std::launch::async,
+                                            [bi = backendinterface_.clone(),
+                                             sco_path,
+                                             sco]() -> fs::path
+                                            {
+                                                bi->read(sco_path,
+                                                         sco.str(),
+                                                         InsistOnLatestVersion::F);
+                                                return sco_path;
+                                            }));
+    }
+}
+
+void
+SCOPool::drop_prefetches_()
+{
+    next_prefetch_ = scos_to_fetch_.size();
+
+    while (not prefetches_.empty())
+    {
+        try
+        {
+            fs::remove(prefetches_.front().second.get());
+        }
+        CATCH_STD_ALL_LOG_IGNORE("Failed to drop prefetched SCO " <<
+                                 prefetches_.front().first);
+        prefetches_.pop_front();
+    }
+}
+
+fs::path
+SCOPool::fetch_(const SCO sco)
+{
+    prefetch_();
+
+    if (prefetches_.empty() or prefetches_.front().first != sco)
+    {
+        LOG_WARN("SCO " << sco << " was not prefetched (" <<
+                 (prefetches_.empty() ?
+                  std::string("nothing prefetched") :
+                  "expected " + prefetches_.front().first.str()) <<
+                 ") - dropping the prefetches and reading it synchronously");
+
+        drop_prefetches_();
+
+        const fs::path sco_path = filepool_.newFile(sco.str());
+        backendinterface_.read(sco_path,
+                               sco.str(),
+                               InsistOnLatestVersion::F);
+        ++number_of_scos_read_from_backend;
+        return sco_path;
+    }
+
+    std::future<fs::path> f(std::move(prefetches_.front().second));
+    prefetches_.pop_front();
+
+    prefetch_();
+
+    const fs::path p(f.get());
+    ++number_of_scos_read_from_backend;
+    return p;
+}
+
+void
+SCOPool::wait_for_upload_()
+{
+    if (upload_.valid())
+    {
+        upload_.get();
+    }
+}
+
+void
+SCOPool::upload_sco_(const fs::path& sco_path)
+{
+    wait_for_upload_();
+
+    ++number_of_scos_written_to_backend;
+    new_scos_.push_back(current_sco_name_);
+
+    upload_ = std::async(std::launch::async,
+                         [bi = backendinterface_.clone(),
+                          sco_path,
+                          sco = current_sco_name_,
+                          cs = checksum_]()
+                         {
+                             // work around ALBA uploads timing out but eventually
+                             // succeeding in the background, leading to overwrite
+                             // on retry.
+                             TODO("AR: use OverwriteObject::F instead");
+                             VERIFY(not bi->objectExists(sco.str()));
+                             bi->write(sco_path,
+                                       sco.str(),
+                                       OverwriteObject::T,
+                                       &cs);
+                             fs::remove(sco_path);
+                         });
+}
+
 void
 SCOPool::doEntry(const Entry& e)
 {
@@ -97,7 +223,7 @@ SCOPool::doEntry(const Entry& e)
     if(scodata_iterator_->state == ScrubbingSCOData::State::Unknown)
     {
         scodata_iterator_->state =
-            scodata_iterator_->usageCount < minimum_used_entries_ ?
+            rewrite_(*scodata_iterator_) ?
             ScrubbingSCOData::State::Scrubbed : ScrubbingSCOData::State::NotScrubbed;
 
         current_usage_count_ = scodata_iterator_->usageCount;
@@ -132,10 +258,7 @@ SCOPool::doEntry(const Entry& e)
                                          " from the filepool");
             }
 
-            std::string sco_string = sco_name.str();
-            fs::path sco_path = filepool_.newFile(sco_string);
-            backendinterface_.read(sco_path, sco_string, InsistOnLatestVersion::F);
-            ++number_of_scos_read_from_backend;
+            const fs::path sco_path(fetch_(sco_name));
             auto fd(std::make_unique<yt::FileDescriptor>(sco_path,
                                                          yt::FDMode::Read));
             in_io = fd.get();
@@ -201,6 +324,21 @@ SCOPool::operator()()
 
     TLogReader input_reader(metadatascrubbed_tlog_);
 
+    // doEntry rewrites the SCOs with entries it finds in state Unknown and
+    // rewrite_() agreeing, in scodata_ order. Should that prediction ever be
+    // off, fetch_ falls back to synchronous reads.
+    for (const auto& d : scodata_)
+    {
+        if (d.state == ScrubbingSCOData::State::Unknown and
+            d.usageCount != 0 and
+            rewrite_(d))
+        {
+            scos_to_fetch_.push_back(d.sconame_);
+        }
+    }
+
+    prefetch_();
+
     scodata_iterator_ = scodata_.begin();
     to_be_reused_iterator_ = scodata_.begin();
 
@@ -233,19 +371,15 @@ SCOPool::operator()()
                  << " to " << new_sco_access_data[current_sco_name_] << " / "  <<
                  current_offset_);
         new_sco_access_data[current_sco_name_] /= current_offset_;
-        fs::path new_sco_path = current_sco_->path();
-        ++number_of_scos_written_to_backend;
-
-        // work around ALBA uploads timing out but eventually succeeding in the
-        // background, leading to overwrite on retry.
-        TODO("AR: use OverwriteObject::F instead");
-        VERIFY(not backendinterface_.objectExists(current_sco_name_.str()));
-        backendinterface_.write(new_sco_path,
-                                 current_sco_name_.str(),
-                                 OverwriteObject::T,
-                                 &checksum_);
-        new_scos_.push_back(current_sco_name_);
+        upload_sco_(current_sco_->path());
+    }
+
+    wait_for_upload_();
 
+    if (not prefetches_.empty())
+    {
+        LOG_WARN(prefetches_.size() << " prefetched SCOs were not used");
+        drop_prefetches_();
     }
 
     current_sco_ = nullptr;
@@ -333,18 +467,7 @@ SCOPool::MaybeUpdateCurrentSCO()
                      << " to " << new_sco_access_data[current_sco_name_]
                      << " / " <<  sco_size_);
             new_sco_access_data[current_sco_name_] /= sco_size_;
-            ++number_of_scos_written_to_backend;
-
-            // work around ALBA uploads timing out but eventually succeeding in the
-            // background, leading to overwrite on retry.
-            TODO("AR: use OverwriteObject::F instead");
-            VERIFY(not backendinterface_.objectExists(current_sco_name_.str()));
-            backendinterface_.write(old_sco_path,
-                                    current_sco_name_.str(),
-                                    OverwriteObject::T,
-                                    &checksum_);
-            new_scos_.push_back(current_sco_name_);
-            fs::remove(filepool_.directory() / current_sco_name_.str());
+            upload_sco_(old_sco_path);
         }
 
         current_offset_ = 0;
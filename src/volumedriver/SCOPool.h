@@ -22,6 +22,9 @@
 #include "ScrubbingTypes.h"
 #include "TLogSplitter.h"
 
+#include <deque>
+#include <future>
+
 #include <youtils/FileDescriptor.h>
 #include <youtils/CheckSum.h>
 
@@ -161,9 +164,36 @@ public:
     uint64_t number_of_scos_read_from_backend;
     uint64_t number_of_scos_written_to_backend;
 
+    // The SCOs that will be rewritten are downloaded in the order they're needed
+    // ahead of time and the rewritten ones are uploaded in the background, so
+    // the backend transfers overlap with the local rewriting.
+    std::vector<volumedriver::SCO> scos_to_fetch_;
+    size_t next_prefetch_;
+    std::deque<std::pair<volumedriver::SCO,
+                         std::future<boost::filesystem::path>>> prefetches_;
+    std::future<void> upload_;
+
     void
     doEntry(const volumedriver::Entry& e);
 
+    bool
+    rewrite_(const ScrubbingSCOData&) const;
+
+    void
+    prefetch_();
+
+    void
+    drop_prefetches_();
+
+    boost::filesystem::path
+    fetch_(const volumedriver::SCO);
+
+    void
+    upload_sco_(const boost::filesystem::path&);
+
+    void
+    wait_for_upload_();
+
     volumedriver::SCO
     makeNewSCOName(const volumedriver::SCO in) const;
 
@@ -25,8 +25,11 @@
 #include "TLogMerger.h"
 #include "TLogSplitter.h"
 
+#include <algorithm>
+
 #include <youtils/Assert.h>
 #include <youtils/wall_timer.h>
+#include <youtils/WorkerPool.h>
 
 #include <boost/filesystem/fstream.hpp>
 
@@ -144,7 +147,8 @@ Scrubber::operator()()
     std::shared_ptr<TLogReaderInterface>
         combined_tlog_reader(CombinedTLogReader::create(filepool.directory(),
                                                         result_.tlog_names_in,
-                                                        backend_interface_->clone()));
+                                                        backend_interface_->clone(),
+                                                        CombinedTLogReader::FetchStrategy::Parallel));
     // Split the TLogs in parts and go through them
     LOG_INFO("Starting the TLog Splitter");
     scrubbing::ScrubbingSCODataVector scrubbing_data_vector;
@@ -167,23 +171,70 @@ Scrubber::operator()()
 
     LOG_INFO("Metadata scrubbing the region tlogs");
 
-    std::vector<fs::path> tlogs;
+    // The regions are independent: they're metadata scrubbed by up to
+    // args_.num_threads workers (this thread being one of them). The usage
+    // counts are only added to the SCO data afterwards, in region order.
+    std::vector<TLogSplitter::MapType::const_iterator> regions;
+    regions.reserve(split_tlog_map.size());
 
     for(TLogSplitter::MapType::const_iterator it = split_tlog_map.begin();
         it != split_tlog_map.end();
         ++it)
     {
-        LOG_INFO("Handling tlog for region " << it->first);
-        PartScrubber part_scrubber(it,
-                                   scrubbing_data_vector,
-                                   filepool,
-                                   args_.region_size_exponent,
-                                   args_.cluster_size_exponent);
-        boost::this_thread::interruption_point();
-        part_scrubber(tlogs);
-        boost::this_thread::interruption_point();
+        regions.push_back(it);
     }
 
+    std::vector<std::unique_ptr<PartScrubber>> part_scrubbers(regions.size());
+    std::vector<fs::path> tlogs(regions.size());
+
+    const size_t num_threads =
+        std::max<size_t>(1,
+                         std::min<size_t>(args_.num_threads,
+                                          regions.size()));
+
+    // only this thread is subject to interruption
+    const boost::thread::id self(boost::this_thread::get_id());
+
+    youtils::WorkerPool pool("ScrubberRegionPool",
+                             num_threads - 1);
+
+    pool.for_each_index(regions.size(),
+                        num_threads,
+                        [&](size_t i)
+                        {
+                            const bool interruptible = boost::this_thread::get_id() == self;
+
+                            LOG_INFO("Handling tlog for region " << regions[i]->first);
+                            part_scrubbers[i] =
+                                std::make_unique<PartScrubber>(regions[i],
+                                                               scrubbing_data_vector,
+                                                               filepool,
+                                                               args_.region_size_exponent,
+                                                               args_.cluster_size_exponent);
+                            if (interruptible)
+                            {
+                                boost::this_thread::interruption_point();
+                            }
+                            tlogs[i] = (*part_scrubbers[i])();
+                            if (interruptible)
+                            {
+                                boost::this_thread::interruption_point();
+                            }
+                        });
+
+    std::vector<fs::path> discard_tlogs;
+
+    for (const auto& p : part_scrubbers)
+    {
+        p->applyUsageCounts(scrubbing_data_vector);
+        if (p->discardsTLog())
+        {
+            discard_tlogs.push_back(*p->discardsTLog());
+        }
+    }
+
+    part_scrubbers.clear();
+
     LOG_INFO("Stopped the region metadatascrubs");
     if(verbose_)
     {
@@ -279,7 +330,7 @@ Scrubber::operator()()
                  ClusterSize(1U << args_.cluster_size_exponent));
 
     boost::this_thread::interruption_point();
-    result_.tlogs_out = t();
+    result_.tlogs_out = t(discard_tlogs);
     boost::this_thread::interruption_point();
 
     VERIFY(not result_.tlogs_out.empty());
@@ -115,6 +115,9 @@ struct ScrubberArgs
     /* if true applies the scrubbing work immediately */
     bool apply_immediately;
 
+    /* number of regions that are metadata scrubbed concurrently */
+    uint32_t num_threads = 1;
+
 private:
     ScrubberArgs&
     clone(const ScrubberArgs& other)
@@ -126,6 +129,7 @@ private:
         region_size_exponent = other.region_size_exponent;
         sco_size = other.sco_size;
         fill_ratio = other.fill_ratio;
+        num_threads = other.num_threads;
         return *this;
     }
 };
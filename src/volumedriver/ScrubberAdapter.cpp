@@ -37,6 +37,9 @@ ScrubberAdapter::apply_immediately_default = false;
 const bool
 ScrubberAdapter::verbose_scrubbing_default = true;
 
+const uint32_t
+ScrubberAdapter::num_threads_default = 4;
+
 ScrubReply
 ScrubberAdapter::scrub(std::unique_ptr<BackendConfig> backend_config,
                        const ScrubWork& scrub_work,
@@ -44,7 +47,8 @@ ScrubberAdapter::scrub(std::unique_ptr<BackendConfig> backend_config,
                        const uint64_t region_size_exponent,
                        const float fill_ratio,
                        const bool apply_immediately,
-                       const bool verbose_scrubbing)
+                       const bool verbose_scrubbing,
+                       const uint32_t num_threads)
 {
     ScrubberArgs scrubber_args;
 
@@ -61,6 +65,7 @@ ScrubberAdapter::scrub(std::unique_ptr<BackendConfig> backend_config,
     scrubber_args.cluster_size_exponent = scrub_work.cluster_exponent_;
     scrubber_args.fill_ratio = fill_ratio;
     scrubber_args.apply_immediately = apply_immediately;
+    scrubber_args.num_threads = num_threads;
 
     Scrubber scrubber(scrubber_args,
                       verbose_scrubbing);
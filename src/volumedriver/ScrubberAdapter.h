@@ -44,6 +44,7 @@ struct ScrubberAdapter
     const static float fill_ratio_default;
     const static bool apply_immediately_default;
     const static bool verbose_scrubbing_default;
+    const static uint32_t num_threads_default;
 
     static ScrubReply
     scrub(std::unique_ptr<backend::BackendConfig>,
@@ -52,7 +53,8 @@ struct ScrubberAdapter
           const uint64_t region_size_exponent = region_size_exponent_default,
           const float fill_ratio = fill_ratio_default,
           const bool apply_immediately = apply_immediately_default,
-          const bool verbose_scrubbing = verbose_scrubbing_default);
+          const bool verbose_scrubbing = verbose_scrubbing_default,
+          const uint32_t num_threads = num_threads_default);
 };
 
 }
@@ -0,0 +1,312 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+
+#include "SnapshotJournal.h"
+#include "SnapshotPersistor.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/uuid/uuid_io.hpp>
+
+#include <youtils/Assert.h>
+#include <youtils/CheckSum.h>
+#include <youtils/FileUtils.h>
+
+namespace volumedriver
+{
+
+namespace fs = boost::filesystem;
+namespace yt = youtils;
+
+namespace
+{
+
+const uint64_t journal_magic = 0x4c4e4a5350414e53ULL; // "SNAPSJNL"
+const uint32_t journal_version = 1;
+
+struct Header
+{
+    uint64_t magic;
+    uint32_t version;
+    uint32_t pad;
+    uint8_t digest[16];
+};
+
+static_assert(sizeof(Header) == 32,
+              "unexpected journal header size");
+
+enum class RecordType
+    : uint32_t
+{
+    NewTLog = 1,
+    TLogWrittenToBackend = 2,
+};
+
+void
+copy_id(const TLogId& id,
+        uint8_t (&out)[16])
+{
+    const yt::UUID& uuid = static_cast<const yt::UUID&>(id);
+    VERIFY(yt::UUID::size() == sizeof(out));
+    memcpy(out,
+           uuid.data(),
+           sizeof(out));
+}
+
+TLogId
+make_id(const uint8_t (&in)[16])
+{
+    boost::uuids::uuid uuid;
+    static_assert(sizeof(uuid.data) == sizeof(in),
+                  "unexpected UUID size");
+    std::copy(in,
+              in + sizeof(in),
+              uuid.data);
+    return TLogId(yt::UUID(boost::uuids::to_string(uuid)));
+}
+
+yt::Weed
+file_digest(const fs::path& p)
+{
+    fs::ifstream ifs(p,
+                     std::ios::binary);
+    if (not ifs)
+    {
+        throw fungi::IOException("failed to open snapshots file",
+                                 p.string().c_str());
+    }
+
+    return yt::Weed(ifs);
+}
+
+}
+
+struct SnapshotJournal::Record
+{
+    uint32_t type;
+    // over the record with crc = 0
+    uint32_t crc;
+    uint64_t size;
+    uint8_t tlog[16];
+    uint8_t next[16];
+
+    uint32_t
+    checksum() const
+    {
+        Record r(*this);
+        r.crc = 0;
+
+        yt::CheckSum cs;
+        cs.update(&r,
+                  sizeof(r));
+        return cs.getValue();
+    }
+};
+
+SnapshotJournal::SnapshotJournal(const fs::path& snapshots_file)
+    : path_(path(snapshots_file))
+    , records_(0)
+{
+    static_assert(sizeof(Record) == 48,
+                  "unexpected journal record size");
+
+    const yt::Weed digest(file_digest(snapshots_file));
+
+    Header h;
+    memset(&h, 0x0, sizeof(h));
+    h.magic = journal_magic;
+    h.version = journal_version;
+    memcpy(h.digest,
+           digest.bytes(),
+           sizeof(h.digest));
+
+    const fs::path tmp(yt::FileUtils::create_temp_file(path_));
+    ALWAYS_CLEANUP_FILE(tmp);
+
+    fd_ = std::make_unique<yt::FileDescriptor>(tmp,
+                                               yt::FDMode::Write,
+                                               CreateIfNecessary::T,
+                                               SyncOnCloseAndDestructor::F);
+    fd_->pwrite(&h,
+                sizeof(h),
+                0);
+    fd_->sync();
+
+    // the descriptor stays valid across the rename
+    fs::rename(tmp,
+               path_);
+
+    LOG_TRACE(path_ << ": started, snapshots digest " << digest);
+}
+
+fs::path
+SnapshotJournal::path(const fs::path& snapshots_file)
+{
+    return snapshots_file.string() + ".journal";
+}
+
+void
+SnapshotJournal::remove(const fs::path& snapshots_file)
+{
+    fs::remove(path(snapshots_file));
+}
+
+void
+SnapshotJournal::append_(Record& r)
+{
+    r.crc = r.checksum();
+
+    fd_->pwrite(&r,
+                sizeof(r),
+                sizeof(Header) + records_ * sizeof(r));
+    fd_->sync();
+
+    ++records_;
+}
+
+void
+SnapshotJournal::new_tlog(const TLog& prev,
+                          const TLogId& next)
+{
+    Record r;
+    memset(&r, 0x0, sizeof(r));
+
+    r.type = static_cast<uint32_t>(RecordType::NewTLog);
+    r.size = prev.backend_size();
+    copy_id(prev.id(),
+            r.tlog);
+    copy_id(next,
+            r.next);
+
+    append_(r);
+}
+
+void
+SnapshotJournal::tlog_written_to_backend(const TLogId& tlog_id)
+{
+    Record r;
+    memset(&r, 0x0, sizeof(r));
+
+    r.type = static_cast<uint32_t>(RecordType::TLogWrittenToBackend);
+    copy_id(tlog_id,
+            r.tlog);
+
+    append_(r);
+}
+
+size_t
+SnapshotJournal::replay(const fs::path& snapshots_file,
+                        const yt::Weed& snapshots_digest,
+                        SnapshotPersistor& sp)
+{
+    const fs::path p(path(snapshots_file));
+    if (not fs::exists(p))
+    {
+        return 0;
+    }
+
+    yt::FileDescriptor fd(p,
+                          yt::FDMode::Read);
+
+    Header h;
+    if (fd.pread(&h,
+                 sizeof(h),
+                 0) != sizeof(h) or
+        h.magic != journal_magic)
+    {
+        LOG_ERROR(p << ": not a snapshots journal");
+        throw SnapshotJournalException("not a snapshots journal",
+                                       p.string().c_str());
+    }
+
+    if (h.version != journal_version)
+    {
+        LOG_ERROR(p << ": unsupported version " << h.version);
+        throw SnapshotJournalException("unsupported snapshots journal version",
+                                       p.string().c_str());
+    }
+
+    if (memcmp(h.digest,
+               snapshots_digest.bytes(),
+               sizeof(h.digest)) != 0)
+    {
+        LOG_INFO(p << ": belongs to another version of " << snapshots_file <<
+                 " - ignoring it");
+        return 0;
+    }
+
+    const uint64_t size = fd.size();
+    VERIFY(size >= sizeof(h));
+
+    std::vector<Record> records((size - sizeof(h)) / sizeof(Record));
+    if (not records.empty())
+    {
+        const size_t len = records.size() * sizeof(Record);
+        VERIFY(fd.pread(records.data(),
+                        len,
+                        sizeof(h)) == len);
+    }
+
+    size_t count = 0;
+
+    for (const auto& r : records)
+    {
+        if (r.crc != r.checksum())
+        {
+            // Records are synced one by one, so only the last one can be torn.
+            if (count + 1 != records.size())
+            {
+                LOG_ERROR(p << ": checksum mismatch in record " << count <<
+                          " of " << records.size());
+                throw SnapshotJournalException("snapshots journal record checksum mismatch",
+                                               p.string().c_str());
+            }
+
+            LOG_WARN(p << ": ignoring torn last record");
+            break;
+        }
+
+        switch (static_cast<RecordType>(r.type))
+        {
+        case RecordType::NewTLog:
+            sp.newTLog(make_id(r.tlog),
+                       r.size,
+                       make_id(r.next));
+            break;
+        case RecordType::TLogWrittenToBackend:
+            sp.setTLogWrittenToBackend(make_id(r.tlog));
+            break;
+        default:
+            LOG_ERROR(p << ": unknown record type " << r.type);
+            throw SnapshotJournalException("unknown snapshots journal record type",
+                                           p.string().c_str());
+        }
+
+        ++count;
+    }
+
+    LOG_INFO(p << ": replayed " << count << " records");
+    return count;
+}
+
+}
+
+// Local Variables: **
+// mode: c++ **
+// End: **
@@ -0,0 +1,112 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+
+#ifndef VD_SNAPSHOT_JOURNAL_H_
+#define VD_SNAPSHOT_JOURNAL_H_
+
+#include "TLog.h"
+#include "TLogId.h"
+
+#include <memory>
+
+#include <boost/filesystem.hpp>
+
+#include <youtils/FileDescriptor.h>
+#include <youtils/IOException.h>
+#include <youtils/Logging.h>
+#include <youtils/Md5.h>
+
+namespace volumedriver
+{
+
+class SnapshotPersistor;
+
+// Binary, append-only log of the SnapshotPersistor changes that happen on every
+// TLog rollover (a new TLog and a TLog making it to the backend), kept next to
+// the snapshots file. The snapshots file then only needs to be rewritten
+// (checkpointed) when the journal is full or on other, rare changes (snapshots,
+// scrubbing, ...), instead of on every rollover.
+// The journal header carries the digest of the snapshots file it applies to,
+// so a journal is ignored once the snapshots file was replaced by something
+// else (a newer checkpoint, a copy fetched from the backend, ...). Records are
+// fixed size and checksummed; a torn last record (crash while appending) is
+// ignored on replay.
+class SnapshotJournal
+{
+public:
+    MAKE_EXCEPTION(SnapshotJournalException, fungi::IOException);
+
+    // Starts a new, empty journal for the given (just written) snapshots file,
+    // replacing any previous one.
+    explicit SnapshotJournal(const boost::filesystem::path& snapshots_file);
+
+    ~SnapshotJournal() = default;
+
+    SnapshotJournal(const SnapshotJournal&) = delete;
+
+    SnapshotJournal&
+    operator=(const SnapshotJournal&) = delete;
+
+    // `prev' was closed with its final backend size, `next' is the new current
+    // TLog.
+    void
+    new_tlog(const TLog& prev,
+             const TLogId& next);
+
+    void
+    tlog_written_to_backend(const TLogId&);
+
+    // Number of records.
+    size_t
+    size() const
+    {
+        return records_;
+    }
+
+    static boost::filesystem::path
+    path(const boost::filesystem::path& snapshots_file);
+
+    static void
+    remove(const boost::filesystem::path& snapshots_file);
+
+    // Applies the journal belonging to the snapshots file with the given
+    // digest (if any) to the SnapshotPersistor loaded from that file. Returns
+    // the number of records applied.
+    static size_t
+    replay(const boost::filesystem::path& snapshots_file,
+           const youtils::Weed& snapshots_digest,
+           SnapshotPersistor&);
+
+private:
+    DECLARE_LOGGER("SnapshotJournal");
+
+    struct Record;
+
+    const boost::filesystem::path path_;
+    std::unique_ptr<youtils::FileDescriptor> fd_;
+    size_t records_;
+
+    void
+    append_(Record&);
+};
+
+}
+
+#endif // !VD_SNAPSHOT_JOURNAL_H_
+
+// Local Variables: **
+// mode: c++ **
+// End: **
@@ -31,6 +31,7 @@
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 #include <vector>
 
@@ -115,7 +116,7 @@ SnapshotManagement::SnapshotManagement(const VolumeConfig& cfg,
         fs::create_directories(tlogPath_);
 
         LOCKSNAP;
-        sp->saveToFile(snapshots_file_path_(), SyncAndRename::T);
+        checkpoint_();
         currentTLogId_ = sp->getCurrentTLog();
     }
 }
@@ -165,7 +166,7 @@ SnapshotManagement::currentTLogHasData()
     sync(boost::none);
 
     TLogReader r(tlogPath_ / boost::lexical_cast<std::string>(currentTLogId_));
-    return r.nextLocation() != nullptr;
+    return r.nextLocationOrDiscard() != nullptr;
 }
 
 const fs::path&
@@ -212,6 +213,55 @@ SnapshotManagement::snapshots_file_path_() const
     return snapshots_file_path(snapshotPath_);
 }
 
+void
+SnapshotManagement::checkpoint_()
+{
+    ASSERT_SNAP_LOCKED;
+
+    const fs::path path(snapshots_file_path_());
+
+    journal_.reset();
+    sp->saveToFile(path,
+                   SyncAndRename::T);
+
+    if (VolManager::get()->snapshots_journal_max_entries.value() > 0)
+    {
+        journal_ = std::make_unique<SnapshotJournal>(path);
+    }
+    else
+    {
+        SnapshotJournal::remove(path);
+    }
+}
+
+template<typename F>
+void
+SnapshotManagement::persist_(F&& journal_fun)
+{
+    ASSERT_SNAP_LOCKED;
+
+    if (journal_ and
+        journal_->size() < VolManager::get()->snapshots_journal_max_entries.value())
+    {
+        journal_fun(*journal_);
+    }
+    else
+    {
+        checkpoint_();
+    }
+}
+
+void
+SnapshotManagement::persist_new_tlog_()
+{
+    persist_([&](SnapshotJournal& j)
+             {
+                 VERIFY(sp->current.size() > 1);
+                 j.new_tlog(*std::prev(sp->current.end(), 2),
+                            sp->current.back().id());
+             });
+}
+
 bool
 SnapshotManagement::lastSnapshotOnBackend() const
 {
@@ -240,7 +290,7 @@ SnapshotManagement::setAsTemplate(const MaybeCheckSum& maybe_sco_crc)
     {
         LOCKSNAP;
         sp->deleteAllButLastSnapshot();
-        sp->saveToFile(snapshots_file_path_(), SyncAndRename::T);
+        checkpoint_();
     }
     scheduleWriteSnapshotToBackend();
 }
@@ -285,8 +335,7 @@ SnapshotManagement::createSnapshot(const SnapshotName& name,
                 currentTLogId_ = sp->getCurrentTLog();
                 openTLog_();
             }
-            sp->saveToFile(snapshots_file_path_(),
-                           SyncAndRename::T);
+            checkpoint_();
             // num = sp->getSnapshotNum(name);
             sp->getSnapshotNum(name);
         }
@@ -375,8 +424,7 @@ SnapshotManagement::scheduleBackendSync(const MaybeCheckSum& maybe_sco_crc)
                                   nspace_.str().c_str(),
                                   boost::lexical_cast<std::string>(currentTLogId_).c_str());
 
-                       sp->saveToFile(snapshots_file_path_(),
-                                      SyncAndRename::T);
+                       persist_new_tlog_();
 
                        scheduleWriteTLogToBackend(tlog_id,
                                                   tlogpath,
@@ -440,7 +488,7 @@ SnapshotManagement::eraseSnapshotsAndTLogsAfterSnapshot(SnapshotNum num)
             openTLog_();
         }
 
-        sp->saveToFile(snapshots_file_path_(), SyncAndRename::T);
+        checkpoint_();
     }
 
     const std::vector<fs::path> paths(tlogPathPrepender(tlog_ids));
@@ -462,7 +510,7 @@ SnapshotManagement::deleteSnapshot(const SnapshotName& name)
     {
         LOCKSNAP;
         sp->deleteSnapshot(sp->getSnapshotNum(name));
-        sp->saveToFile(snapshots_file_path_(), SyncAndRename::T);
+        checkpoint_();
     }
     scheduleWriteSnapshotToBackend();
 }
@@ -520,6 +568,19 @@ SnapshotManagement::destroy(const DeleteLocalData delete_local_data)
 
         fs::remove_all(getTLogsPath());
         fs::remove_all(snapshots_file_path_());
+        SnapshotJournal::remove(snapshots_file_path_());
+    }
+    else
+    {
+        // Leave a self-contained snapshots file behind, e.g. for versions
+        // that don't know about the journal.
+        try
+        {
+            LOCKSNAP;
+            checkpoint_();
+        }
+        CATCH_STD_ALL_VLOGLEVEL_IGNORE("failed to write out snapshots file",
+                                       WARN);
     }
 }
 
@@ -719,8 +780,7 @@ SnapshotManagement::maybe_switch_tlog_()
                                    location.sco(),
                                    tlog_crc);
 
-        sp->saveToFile(snapshots_file_path_(),
-                       SyncAndRename::T);
+        persist_new_tlog_();
     }
 }
 
@@ -741,6 +801,46 @@ SnapshotManagement::addClusterEntry(const ClusterAddress address,
                    "add cluster entry");
 }
 
+void
+SnapshotManagement::addClusterEntries(const std::vector<ClusterAddress>& addresses,
+                                      const std::vector<ClusterLocationAndHash>& locations_and_hashes)
+{
+    VERIFY(addresses.size() == locations_and_hashes.size());
+
+    LOCKSNAP;
+    LOCKTLOG;
+    REQUIRE_CURRENT_TLOG;
+
+    halt_on_error_([&]()
+                   {
+                       for (size_t i = 0; i < addresses.size(); ++i)
+                       {
+                           currentTLog_->add(addresses[i],
+                                             locations_and_hashes[i]);
+                       }
+                       numTLogEntries_ += addresses.size();
+                       sp->addCurrentBackendSize(addresses.size() *
+                                                 getVolume()->getClusterSize());
+                   },
+                   "add cluster entries");
+}
+
+// Discards don't take up backend space and don't count towards the TLog
+// rollover (which only happens on SCO boundaries anyway).
+void
+SnapshotManagement::addDiscardEntry(const ClusterAddress address)
+{
+    LOCKSNAP;
+    LOCKTLOG;
+    REQUIRE_CURRENT_TLOG;
+
+    halt_on_error_([&]()
+                   {
+                       currentTLog_->addDiscard(address);
+                   },
+                   "add discard entry");
+}
+
 void
 SnapshotManagement::sync(const MaybeCheckSum& maybe_sco_crc)
 {
@@ -749,6 +849,22 @@ SnapshotManagement::sync(const MaybeCheckSum& maybe_sco_crc)
     syncTLog_(maybe_sco_crc);
 }
 
+bool
+SnapshotManagement::tlogs_queued_after_(const TLogId& tlog_id) const
+{
+    ASSERT_SNAP_LOCKED;
+
+    OrderedTLogIds tlog_ids;
+    sp->getTLogsNotWrittenToBackend(tlog_ids);
+
+    // the last one is the current TLog, which is still open
+    auto it = std::find(tlog_ids.begin(),
+                        tlog_ids.end(),
+                        tlog_id);
+    return it != tlog_ids.end() and
+        std::distance(it, tlog_ids.end()) > 2;
+}
+
 void
 SnapshotManagement::tlogWrittenToBackendCallback(const TLogId& tlog_id,
                                                  const SCO sconame)
@@ -772,14 +888,55 @@ SnapshotManagement::tlogWrittenToBackendCallback(const TLogId& tlog_id,
                                                     std::uncaught_exception());
                                      }));
 
+    // A retry after a failed snapshots.xml upload brings us here again.
+    if (tlogs_pending_upload_.empty() or
+        tlogs_pending_upload_.back().first != tlog_id)
+    {
+        tlogs_pending_upload_.emplace_back(tlog_id,
+                                           sconame);
+    }
+
+    try
+    {
+        // The SCOs are on the backend already, so there's no need to keep
+        // them around until the TLog shows up in the backend's snapshots.xml.
+        if(sconame.asBool())
+        {
+            getVolume()->getDataStore()->writtenToBackendUpTo(sconame);
+        }
+    }
+    CATCH_STD_ALL_VLOG_HALT_RETHROW("problem setting SCOs up to " << sconame <<
+                                    " written to backend")
+
     {
         LOCKSNAP;
+
+        // Uploading snapshots.xml for every TLog gets expensive as the volume's
+        // history grows. If more TLogs are queued already, leave it to the last
+        // of those (or the one that hits the limit). Until then these TLogs
+        // are not set written to backend locally either, so the DTL and the
+        // metadata store corks still cover them.
+        const uint32_t max_pending =
+            VolManager::get()->snapshots_upload_max_tlogs.value();
+
+        if (tlogs_pending_upload_.size() < max_pending and
+            tlogs_queued_after_(tlog_id))
+        {
+            LOG_DEBUG(nspace_ << ": deferring the snapshots upload for TLog " <<
+                      tlog_id << ", " << tlogs_pending_upload_.size() <<
+                      " TLogs pending");
+            return;
+        }
+
         tmp = std::make_unique<SnapshotPersistor>(*sp);
     }
 
     try
     {
-        tmp->setTLogWrittenToBackend(tlog_id);
+        for (const auto& p : tlogs_pending_upload_)
+        {
+            tmp->setTLogWrittenToBackend(p.first);
+        }
 
         const fs::path tmp_file(FileUtils::create_temp_file(tlogPath_,
                                                             "snapshots"));
@@ -794,54 +951,53 @@ SnapshotManagement::tlogWrittenToBackendCallback(const TLogId& tlog_id,
     CATCH_STD_ALL_VLOG_ADDERROR_RETHROW("snapshots file could not be written to backend",
                                         events::VolumeDriverErrorCode::PutSnapshotsToBackend);
 
+    const std::vector<std::pair<TLogId, SCO>> tlogs(std::move(tlogs_pending_upload_));
+    tlogs_pending_upload_.clear();
+
     try
     {
+        LOCKSNAP;
+        for (const auto& p : tlogs)
         {
-            LOCKSNAP;
-            sp->setTLogWrittenToBackend(tlog_id);
-            tmp = std::make_unique<SnapshotPersistor>(*sp);
+            sp->setTLogWrittenToBackend(p.first);
         }
 
-        tmp->saveToFile(snapshots_file_path_(),
-                        SyncAndRename::T);
+        persist_([&](SnapshotJournal& j)
+                 {
+                     for (const auto& p : tlogs)
+                     {
+                         j.tlog_written_to_backend(p.first);
+                     }
+                 });
     }
     CATCH_STD_ALL_VLOG_HALT_RETHROW("problem setting TLog " << tlog_id <<
                                     " written to backend");
 
-    try
+    for (const auto& p : tlogs)
     {
-        if(sconame.asBool())
+        try
         {
-            // First notify the DataStore and only then set the tlog written to
-            // backend?
-            getVolume()->getDataStore()->writtenToBackendUpTo(sconame);
+            getVolume()->unCorkAndTrySync(p.first);
         }
-    }
-    CATCH_STD_ALL_VLOG_HALT_RETHROW("problem setting SCOs up to " << sconame <<
-                                    " written to backend")
-
-    try
-    {
-        getVolume()->unCorkAndTrySync(tlog_id);
-    }
-    CATCH_STD_ALL_VLOG_HALT_RETHROW("problem unCorking tlog " << tlog_id)
+        CATCH_STD_ALL_VLOG_HALT_RETHROW("problem unCorking tlog " << p.first)
 
-    try
-    {
-        // This seems to give problems with snapshotrestore.
-        // but that should be solved now because tlog are automatically
-        // fetched again from the backend as needed --
-        fs::remove(tlogPathPrepender(tlog_id));
-        if(sconame.asBool())
+        try
         {
-            getVolume()->removeUpToFromFailOverCache(sconame);
+            // This seems to give problems with snapshotrestore.
+            // but that should be solved now because tlog are automatically
+            // fetched again from the backend as needed --
+            fs::remove(tlogPathPrepender(p.first));
+            if(p.second.asBool())
+            {
+                getVolume()->removeUpToFromFailOverCache(p.second);
+            }
+            // This has to happen *after* setting the tlog written to backend as it might
+            // otherwise race with the setFailOver on Volume.
+            getVolume()->checkState(p.first);
         }
-        // This has to happen *after* setting the tlog written to backend as it might
-        // otherwise race with the setFailOver on Volume.
-        getVolume()->checkState(tlog_id);
+        CATCH_STD_ALL_VLOGLEVEL_IGNORE("problem after setting TLog written to backend",
+                                       WARN);
     }
-    CATCH_STD_ALL_VLOGLEVEL_IGNORE("problem after setting TLog written to backend",
-                                   WARN);
 
     ASSERT(isTLogWrittenToBackend(tlog_id));
 }
@@ -913,8 +1069,7 @@ SnapshotManagement::new_scrub_id()
     {
         LOCKSNAP;
         scrub_id = std::move(sp->new_scrub_id());
-        sp->saveToFile(snapshots_file_path_(),
-                       SyncAndRename::T);
+        checkpoint_();
     }
 
     scheduleWriteSnapshotToBackend();
@@ -935,8 +1090,7 @@ SnapshotManagement::replaceTLogsWithScrubbedOnes(const OrderedTLogIds &in,
                                num);
         sp->setSnapshotScrubbed(num,
                                 true);
-        sp->saveToFile(snapshots_file_path_(),
-                       SyncAndRename::T);
+        checkpoint_();
     }
 
     scheduleWriteSnapshotToBackend();
@@ -1033,7 +1187,7 @@ SnapshotManagement::isSyncedToBackend()
     syncTLog_(boost::none);
     TLogReader r(getCurrentTLogPath());
 
-    return r.nextLocation() == 0;
+    return r.nextLocationOrDiscard() == 0;
 }
 
 uint64_t
@@ -20,6 +20,7 @@
 #include "ClusterLocationAndHash.h"
 #include "RestartContext.h"
 #include "ScrubId.h"
+#include "SnapshotJournal.h"
 #include "SnapshotName.h"
 #include "SnapshotPersistor.h"
 #include "VolumeBackPointer.h"
@@ -32,6 +33,7 @@
 #include <list>
 #include <memory>
 #include <stdexcept>
+#include <vector>
 
 #include <boost/thread/mutex.hpp>
 
@@ -50,7 +52,8 @@ class TLogBackendWriter;
 class WriteOnlyVolume;
 
 /**
- * service for managing the snapshots. It is backed by a /snapshots.xml file.
+ * service for managing the snapshots. It is backed by a /snapshots.xml file
+ * and a SnapshotJournal for the TLog rollovers since its last rewrite.
  */
 
 class SnapshotManagement
@@ -188,9 +191,17 @@ public:
     addClusterEntry(const ClusterAddress address,
                     const ClusterLocationAndHash& location_and_hash);
 
+    // Like addClusterEntry for each of them, but taking the locks only once.
+    void
+    addClusterEntries(const std::vector<ClusterAddress>& addresses,
+                      const std::vector<ClusterLocationAndHash>& locations_and_hashes);
+
     void
     addSCOCRC(const CheckSum& t);
 
+    void
+    addDiscardEntry(const ClusterAddress address);
+
     ScrubId
     replaceTLogsWithScrubbedOnes(const OrderedTLogIds& /*in*/,
                                  const std::vector<TLog>& /*out*/,
@@ -319,9 +330,35 @@ private:
     boost::filesystem::path tlogPath_;
     const backend::Namespace nspace_;
 
+    // protected by snapshot_lock_; only set up by the first checkpoint
+    std::unique_ptr<SnapshotJournal> journal_;
+
+    // TLogs (and their last SCO) that made it to the backend but are not
+    // accounted for in the backend's snapshots.xml yet, oldest first. Only
+    // touched by tlogWrittenToBackendCallback (TLog write tasks are barriers).
+    std::vector<std::pair<TLogId, SCO>> tlogs_pending_upload_;
+
     boost::filesystem::path
     snapshots_file_path_() const;
 
+    // Rewrites the snapshots file and starts a new journal.
+    void
+    checkpoint_();
+
+    // Journals the change to sp, or checkpoints if the journal is full (or
+    // disabled).
+    template<typename F>
+    void
+    persist_(F&& journal_fun);
+
+    void
+    persist_new_tlog_();
+
+    // Whether TLogs that were closed after `tlog_id' still await being
+    // written to the backend.
+    bool
+    tlogs_queued_after_(const TLogId& tlog_id) const;
+
     // To be called by Volume on local restart
     void
     scheduleTLogsToBeWrittenToBackend();
@@ -13,6 +13,7 @@
 // Open vStorage is distributed in the hope that it will be useful,
 // but WITHOUT ANY WARRANTY of any kind.
 
+#include "SnapshotJournal.h"
 #include "SnapshotPersistor.h"
 #include "TracePoints_tp.h"
 #include "VolumeDriverError.h"
@@ -23,6 +24,7 @@
 #include <algorithm>
 #include <cstring>
 #include <limits>
+#include <sstream>
 
 #include <boost/filesystem/fstream.hpp>
 #include <boost/archive/archive_exception.hpp>
@@ -55,10 +57,29 @@ SnapshotPersistor::SnapshotPersistor(const fs::path& path)
     {
         try
         {
-            fs::ifstream ifs(path);
-            boost::archive::xml_iarchive ia(ifs);
+            std::string str;
+
+            {
+                fs::ifstream ifs(path,
+                                 std::ios::binary);
+                std::stringstream ss;
+                ss << ifs.rdbuf();
+                str = ss.str();
+            }
+
+            std::istringstream iss(str);
+            boost::archive::xml_iarchive ia(iss);
             ia >> boost::serialization::make_nvp(nvp_name,
                                                  *this);
+
+            const yt::Weed digest(reinterpret_cast<const uint8_t*>(str.data()),
+                                  str.size());
+            if (SnapshotJournal::replay(path,
+                                        digest,
+                                        *this))
+            {
+                verifySanity_();
+            }
         }
         CATCH_STD_ALL_EWHAT({
                 VolumeDriverError::report(events::VolumeDriverErrorCode::ReadSnapshots,
@@ -218,6 +239,29 @@ SnapshotPersistor::newTLog()
     LOG_INFO("Starting new TLog " << current.back().id());
 }
 
+void
+SnapshotPersistor::newTLog(const TLogId& prev,
+                           uint64_t prev_backend_size,
+                           const TLogId& next)
+{
+    VERIFY(not current.empty());
+    TLog& last = current.back();
+
+    if (last.id() != prev or
+        last.backend_size() > prev_backend_size)
+    {
+        LOG_ERROR("Cannot close TLog " << prev << " with backend size " <<
+                  prev_backend_size << " - current TLog is " << last.id() <<
+                  " with backend size " << last.backend_size());
+        throw SnapshotPersistorException("TLog rollover does not match the current TLog");
+    }
+
+    last.add_to_backend_size(prev_backend_size - last.backend_size());
+    current.emplace_back(TLog(next));
+
+    LOG_INFO("Starting new TLog " << current.back().id());
+}
+
 void
 SnapshotPersistor::setTLogWrittenToBackend(const TLogId& tlogid,
                                            bool on_backend)
@@ -86,6 +86,13 @@ public:
     void
     newTLog();
 
+    // Replays a TLog rollover from the SnapshotJournal: `prev' (the current
+    // TLog) was closed with the given backend size, `next' is the new one.
+    void
+    newTLog(const TLogId& prev,
+            uint64_t prev_backend_size,
+            const TLogId& next);
+
     std::unique_ptr<SnapshotPersistor>
     parentSnapshotPersistor(BackendInterfacePtr& bi) const;
 
@@ -0,0 +1,206 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+#include "SCOCacheMountPoint.h"
+#include "SparseSCO.h"
+
+#include <algorithm>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+#include <youtils/Assert.h>
+#include <youtils/Catchers.h>
+#include <youtils/IOException.h>
+
+namespace volumedriver
+{
+
+namespace ba = boost::algorithm;
+namespace fs = boost::filesystem;
+namespace yt = youtils;
+
+#define LOCK()                                  \
+    boost::lock_guard<decltype(lock_)> lg__(lock_)
+
+const std::string SparseSCO::suffix_(".sparse");
+
+SparseSCO::SparseSCO(SCOCacheMountPointPtr mp,
+                     const fs::path& path,
+                     SCO sco,
+                     uint64_t size,
+                     size_t chunk_size)
+    : mp_(mp)
+    , path_(path)
+    , sco_(sco)
+    , size_(size)
+    , chunk_size_(chunk_size)
+    , present_((size + chunk_size - 1) / chunk_size,
+               false)
+    , num_present_(0)
+    , used_(0)
+{
+    VERIFY(mp_);
+    VERIFY(chunk_size_ > 0);
+    VERIFY(is_sparse_sco_path(path_));
+
+    if (size_ == 0)
+    {
+        LOG_ERROR("attempt to create sparse SCO " << path_ << " of size 0");
+        throw fungi::IOException("attempt to create sparse SCO of size 0",
+                                 path_.string().c_str(),
+                                 EINVAL);
+    }
+
+    if (mp_->isOffline())
+    {
+        throw fungi::IOException("mountpoint is offline",
+                                 path_.string().c_str());
+    }
+
+    fd_ = std::make_unique<yt::FileDescriptor>(path_,
+                                               yt::FDMode::ReadWrite,
+                                               CreateIfNecessary::T,
+                                               SyncOnCloseAndDestructor::F);
+    // no space is allocated for the holes
+    fd_->truncate(size_);
+
+    LOG_INFO(path_ << ": created, size " << size_ << ", chunk size " <<
+             chunk_size_);
+}
+
+SparseSCO::~SparseSCO()
+{
+    LOG_INFO(path_ << ": removing, " << num_present_ << '/' << present_.size() <<
+             " chunks present");
+
+    fd_.reset();
+
+    try
+    {
+        fs::remove(path_);
+    }
+    CATCH_STD_ALL_LOG_IGNORE("Failed to remove " << path_);
+
+    mp_->updateUsedSize(-static_cast<int64_t>(used_));
+}
+
+fs::path
+SparseSCO::make_path(const fs::path& nspace_dir,
+                     SCO sco)
+{
+    return nspace_dir / (sco.str() + suffix_);
+}
+
+bool
+SparseSCO::is_sparse_sco_path(const fs::path& p)
+{
+    const std::string s(p.filename().string());
+    return
+        ba::ends_with(s,
+                      suffix_) and
+        SCO::isSCOString(s.substr(0, s.size() - suffix_.size()));
+}
+
+bool
+SparseSCO::read(uint8_t* buf,
+                size_t size,
+                uint64_t off)
+{
+    VERIFY(off + size <= size_);
+
+    if (size == 0)
+    {
+        return true;
+    }
+
+    {
+        LOCK();
+        for (uint64_t c = off / chunk_size_; c <= (off + size - 1) / chunk_size_; ++c)
+        {
+            if (not present_[c])
+            {
+                return false;
+            }
+        }
+    }
+
+    if (mp_->isOffline())
+    {
+        throw fungi::IOException("mountpoint is offline",
+                                 path_.string().c_str());
+    }
+
+    const size_t r = fd_->pread(buf,
+                                size,
+                                off);
+    if (r != size)
+    {
+        LOG_ERROR(path_ << ": short read, expected " << size << ", got " << r);
+        throw fungi::IOException("short read from sparse SCO",
+                                 path_.string().c_str());
+    }
+
+    return true;
+}
+
+void
+SparseSCO::write(const uint8_t* buf,
+                 size_t size,
+                 uint64_t off)
+{
+    VERIFY(off % chunk_size_ == 0);
+    VERIFY(off + size <= size_);
+    VERIFY(size % chunk_size_ == 0 or off + size == size_);
+
+    if (mp_->isOffline())
+    {
+        throw fungi::IOException("mountpoint is offline",
+                                 path_.string().c_str());
+    }
+
+    fd_->pwrite(buf,
+                size,
+                off);
+
+    LOCK();
+
+    for (uint64_t c = off / chunk_size_; c * chunk_size_ < off + size; ++c)
+    {
+        if (not present_[c])
+        {
+            present_[c] = true;
+            ++num_present_;
+
+            const uint64_t len = std::min<uint64_t>(chunk_size_,
+                                                    size_ - c * chunk_size_);
+            used_ += len;
+            mp_->updateUsedSize(len);
+        }
+    }
+}
+
+bool
+SparseSCO::dense() const
+{
+    LOCK();
+    return num_present_ * 2 >= present_.size();
+}
+
+}
+
+// Local Variables: **
+// mode: c++ **
+// End: **
@@ -0,0 +1,133 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+#ifndef SPARSE_SCO_H_
+#define SPARSE_SCO_H_
+
+#include "CachedSCO.h"
+#include "SCO.h"
+
+#include <memory>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <youtils/FileDescriptor.h>
+#include <youtils/Logging.h>
+
+namespace volumedriver
+{
+
+// A partially cached backend SCO: a (sparse) file of the SCO's size on a
+// SCOCache mountpoint plus a bitmap of the fixed size chunks that were filled
+// in by ranged reads from the backend. It lets random reads on a cold volume
+// be served from the cache without fetching whole SCOs for a few clusters.
+// Sparse SCOs are not tracked by the SCOCache (hence the non-SCO file name);
+// they do count against the mountpoint's used size though and are removed on
+// destruction or by the next scan of their namespace after a restart.
+class SparseSCO
+{
+public:
+    SparseSCO(SCOCacheMountPointPtr mp,
+              const boost::filesystem::path& path,
+              SCO sco,
+              uint64_t size,
+              size_t chunk_size);
+
+    ~SparseSCO();
+
+    SparseSCO(const SparseSCO&) = delete;
+
+    SparseSCO&
+    operator=(const SparseSCO&) = delete;
+
+    // Returns false without touching `buf' unless all chunks covering the
+    // range are present.
+    bool
+    read(uint8_t* buf,
+         size_t size,
+         uint64_t off);
+
+    // The range must be chunk aligned; only the SCO's last chunk may be short.
+    void
+    write(const uint8_t* buf,
+          size_t size,
+          uint64_t off);
+
+    // Whether enough of it is present to rather fetch the whole SCO.
+    bool
+    dense() const;
+
+    SCO
+    getSCO() const
+    {
+        return sco_;
+    }
+
+    uint64_t
+    size() const
+    {
+        return size_;
+    }
+
+    size_t
+    chunk_size() const
+    {
+        return chunk_size_;
+    }
+
+    const boost::filesystem::path&
+    path() const
+    {
+        return path_;
+    }
+
+    static boost::filesystem::path
+    make_path(const boost::filesystem::path& nspace_dir,
+              SCO sco);
+
+    static bool
+    is_sparse_sco_path(const boost::filesystem::path&);
+
+private:
+    DECLARE_LOGGER("SparseSCO");
+
+    SCOCacheMountPointPtr mp_;
+    const boost::filesystem::path path_;
+    const SCO sco_;
+    const uint64_t size_;
+    const size_t chunk_size_;
+
+    std::unique_ptr<youtils::FileDescriptor> fd_;
+
+    // protects present_, num_present_ and used_
+    mutable boost::mutex lock_;
+    std::vector<bool> present_;
+    size_t num_present_;
+    uint64_t used_;
+
+    static const std::string suffix_;
+};
+
+using SparseSCOPtr = std::shared_ptr<SparseSCO>;
+
+}
+
+#endif // !SPARSE_SCO_H_
+
+// Local Variables: **
+// mode: c++ **
+// End: **
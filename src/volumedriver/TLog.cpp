@@ -30,6 +30,12 @@ TLog::TLog()
     , size(0)
 {}
 
+TLog::TLog(const TLogId& id)
+    : uuid(id)
+    , written_to_backend(false)
+    , size(0)
+{}
+
 void
 TLog::writtenToBackend(bool in_backend)
 {
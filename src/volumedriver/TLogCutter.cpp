@@ -71,7 +71,7 @@ TLogCutter::writeTLogToBackend()
 }
 
 std::vector<TLog>
-TLogCutter::operator()()
+TLogCutter::operator()(const std::vector<fs::path>& discard_tlogs)
 {
     uint64_t entries_written = 0;
     makeNewTLog();
@@ -98,6 +98,18 @@ TLogCutter::operator()()
         prev_sco_num = current_sco_num;
     }
 
+    // There's at most one entry per cluster address in a scrubbed tlog, so
+    // where the discards end up does not matter.
+    for (const auto& p : discard_tlogs)
+    {
+        TLogReader discard_reader(p);
+        while((e = discard_reader.nextLocationOrDiscard()))
+        {
+            VERIFY(e->isDiscard());
+            tlog_writer->addDiscard(e->clusterAddress());
+        }
+    }
+
     writeTLogToBackend();
 
     return tlogs_;
@@ -51,8 +51,10 @@ public:
     TLogCutter&
     operator=(const TLogCutter&) = delete;
 
+    // The entries of the discard tlogs are appended to the last tlog.
     std::vector<TLog>
-    operator()();
+    operator()(const std::vector<boost::filesystem::path>& discard_tlogs =
+               std::vector<boost::filesystem::path>());
 
 private:
     DECLARE_LOGGER("TLogCutter");
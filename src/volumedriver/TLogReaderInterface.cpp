@@ -83,6 +83,17 @@ TLogReaderInterface::nextLocation()
     return e;
 }
 
+const Entry*
+TLogReaderInterface::nextLocationOrDiscard()
+{
+    const Entry* e;
+    do {
+        e = nextAny();
+    }
+    while (e and not (e->isLocation() or e->isDiscard()));
+    return e;
+}
+
 
 }
 // Local Variables: **
@@ -39,6 +39,10 @@ public:
     const Entry*
     nextLocation();
 
+    // LOC or Discard entries, i.e. the ones that change the metadata.
+    const Entry*
+    nextLocationOrDiscard();
+
     void
     SCONames(std::vector<SCO>& out);
 
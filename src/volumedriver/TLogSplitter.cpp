@@ -64,6 +64,12 @@ TLogSplitter::doEntry(const Entry* e)
         tlog_writer = it->second;
     }
 
+    if(e->isDiscard())
+    {
+        tlog_writer->addDiscard(cluster_address);
+        return;
+    }
+
     tlog_writer->add(e->clusterAddress(),
                      e->clusterLocationAndHash());
 
@@ -86,7 +92,7 @@ TLogSplitter::operator()()
 {
     const Entry* e;
 
-    while((e = reader_->nextLocation()))
+    while((e = reader_->nextLocationOrDiscard()))
     {
         doEntry(e);
     }
@@ -136,6 +136,12 @@ TLogWriter::add(const ClusterAddress address,
                  loc_and_hash);
 }
 
+void
+TLogWriter::addDiscard(const ClusterAddress address)
+{
+    place<false>(address);
+}
+
 void
 TLogWriter::add(const CheckSum& cs)
 {
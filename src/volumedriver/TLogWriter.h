@@ -64,6 +64,10 @@ public:
     void
     add(const CheckSum& cs);
 
+    // Discard Entry
+    void
+    addDiscard(const ClusterAddress address);
+
     // SyncTC Entry
     void
     add();
@@ -59,6 +59,10 @@ EntryToolCut::str() const
     case volumedriver::Entry::Type::LOC:
         ss << "clusterAddress: " << clusterAddress();
         ss << "clusterLocation: " << entry_->clusterLocation();
+        break;
+    case volumedriver::Entry::Type::Discard:
+        ss << "clusterAddress: " << clusterAddress();
+        break;
     }
     return ss.str();
 
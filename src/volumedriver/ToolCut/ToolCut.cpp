@@ -94,11 +94,12 @@ BOOST_PYTHON_MODULE(ToolCut)
 
     enum_<volumedriver::Entry::Type>("EntryType",
                                      "Type entries in a TLog.\n"
-                                     "Values are SyncTC, TLogCRC, SCOCRC or CLoc")
+                                     "Values are SyncTC, TLogCRC, SCOCRC, CLoc or Discard")
         .value("SyncTC", volumedriver::Entry::Type::SyncTC)
         .value("TLogCRC", volumedriver::Entry::Type::TLogCRC)
         .value("SCOCRC", volumedriver::Entry::Type::SCOCRC)
-        .value("CLoc", volumedriver::Entry::Type::LOC);
+        .value("CLoc", volumedriver::Entry::Type::LOC)
+        .value("Discard", volumedriver::Entry::Type::Discard);
 
 #include <youtils/LoggerToolCut.incl>
 
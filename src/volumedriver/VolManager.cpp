@@ -154,9 +154,19 @@ try
           , non_disposable_scos_factor(pt)
           , default_cluster_size(pt)
           , metadata_cache_capacity(pt)
+          , default_weed_type(pt)
           , debug_metadata_path(pt)
           , arakoon_metadata_sequence_size(pt)
           , allow_inconsistent_partial_reads(pt)
+          , partial_read_threads(pt)
+          , partial_read_pool_size(pt)
+          , metadata_cache_readahead_pages(pt)
+          , compress_tlogs_on_backend(pt)
+          , sparse_sco_chunk_size(pt)
+          , elide_zero_clusters(pt)
+          , enable_discard(pt)
+          , snapshots_journal_max_entries(pt)
+          , snapshots_upload_max_tlogs(pt)
           , volume_nullio(pt)
 {
     THROW_UNLESS((default_cluster_size.value() % VolumeConfig::default_lba_size()) == 0);
@@ -926,6 +936,13 @@ VolManager::createClone(const CloneVolumeConfigParameters& clone_params,
         }
     }
 
+    // The parent's cluster cache entries are only shared if both use the same
+    // keys.
+    if (not params.get_weed_type())
+    {
+        params.weed_type(cfg_old->weed_type());
+    }
+
     const VolumeConfig config(params,
                               *cfg_old);
 
@@ -1046,7 +1063,13 @@ VolManager::createNewVolume(const VanillaVolumeConfigParameters& params,
 
     ensure_volume_size_(size);
 
-    const VolumeConfig cfg(params);
+    VanillaVolumeConfigParameters p(params);
+    if (not p.get_weed_type())
+    {
+        p.weed_type(default_weed_type.value());
+    }
+
+    const VolumeConfig cfg(p);
     ensureResourceLimits(cfg);
 
     SharedVolumePtr vol = VolumeFactory::createNewVolume(cfg);
@@ -1788,9 +1811,19 @@ VolManager::update(const boost::property_tree::ptree& pt,
     non_disposable_scos_factor.update(pt, report);
     default_cluster_size.update(pt, report);
     metadata_cache_capacity.update(pt, report);
+    default_weed_type.update(pt, report);
     debug_metadata_path.update(pt, report);
     arakoon_metadata_sequence_size.update(pt, report);
     allow_inconsistent_partial_reads.update(pt, report);
+    partial_read_threads.update(pt, report);
+    partial_read_pool_size.update(pt, report);
+    metadata_cache_readahead_pages.update(pt, report);
+    compress_tlogs_on_backend.update(pt, report);
+    sparse_sco_chunk_size.update(pt, report);
+    elide_zero_clusters.update(pt, report);
+    enable_discard.update(pt, report);
+    snapshots_journal_max_entries.update(pt, report);
+    snapshots_upload_max_tlogs.update(pt, report);
     volume_nullio.update(pt, report);
 }
 
@@ -1822,9 +1855,19 @@ VolManager::persist(boost::property_tree::ptree& pt,
     non_disposable_scos_factor.persist(pt, reportDefault);
     default_cluster_size.persist(pt, reportDefault);
     metadata_cache_capacity.persist(pt, reportDefault);
+    default_weed_type.persist(pt, reportDefault);
     debug_metadata_path.persist(pt, reportDefault);
     arakoon_metadata_sequence_size.persist(pt, reportDefault);
     allow_inconsistent_partial_reads.persist(pt, reportDefault);
+    partial_read_threads.persist(pt, reportDefault);
+    partial_read_pool_size.persist(pt, reportDefault);
+    metadata_cache_readahead_pages.persist(pt, reportDefault);
+    compress_tlogs_on_backend.persist(pt, reportDefault);
+    sparse_sco_chunk_size.persist(pt, reportDefault);
+    elide_zero_clusters.persist(pt, reportDefault);
+    enable_discard.persist(pt, reportDefault);
+    snapshots_journal_max_entries.persist(pt, reportDefault);
+    snapshots_upload_max_tlogs.persist(pt, reportDefault);
     volume_nullio.persist(pt, reportDefault);
 }
 
@@ -1860,6 +1903,21 @@ VolManager::get_sco_written_to_backend_action() const
     return sco_written_to_backend_action.value();
 }
 
+yt::WorkerPool&
+VolManager::partial_read_pool()
+{
+    boost::lock_guard<decltype(partial_read_pool_lock_)> g(partial_read_pool_lock_);
+
+    if (not partial_read_pool_)
+    {
+        partial_read_pool_ =
+            std::make_unique<yt::WorkerPool>("PartialReadPool",
+                                             partial_read_pool_size.value());
+    }
+
+    return *partial_read_pool_;
+}
+
 }
 
 // Local Variables: **
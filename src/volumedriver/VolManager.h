@@ -37,11 +37,13 @@
 #include <boost/optional.hpp>
 #include <boost/property_tree/ptree_fwd.hpp>
 #include <boost/ptr_container/ptr_vector.hpp>
+#include <boost/thread/mutex.hpp>
 #include <boost/variant.hpp>
 
 #include <youtils/Notifier.h>
 #include <youtils/PeriodicAction.h>
 #include <youtils/VolumeDriverComponent.h>
+#include <youtils/WorkerPool.h>
 
 #include <backend/BackendConfig.h>
 //TODO [BDV] find out why forward decl doesn't work while following include does
@@ -465,6 +467,10 @@ public:
     SCOWrittenToBackendAction
     get_sco_written_to_backend_action() const;
 
+    // Only set up on first use, i.e. once partial_read_threads > 1.
+    youtils::WorkerPool&
+    partial_read_pool();
+
     size_t
     effective_metadata_cache_capacity(const VolumeConfig&) const;
 
@@ -524,6 +530,8 @@ private:
 
     events::PublisherPtr event_publisher_;
     VolPool backend_thread_pool_;
+    boost::mutex partial_read_pool_lock_;
+    std::unique_ptr<youtils::WorkerPool> partial_read_pool_;
 
     VolumeMap volMap_;
 
@@ -580,9 +588,19 @@ public:
     DECLARE_PARAMETER(non_disposable_scos_factor);
     DECLARE_PARAMETER(default_cluster_size);
     DECLARE_PARAMETER(metadata_cache_capacity);
+    DECLARE_PARAMETER(default_weed_type);
     DECLARE_PARAMETER(debug_metadata_path);
     DECLARE_PARAMETER(arakoon_metadata_sequence_size);
     DECLARE_PARAMETER(allow_inconsistent_partial_reads);
+    DECLARE_PARAMETER(partial_read_threads);
+    DECLARE_PARAMETER(partial_read_pool_size);
+    DECLARE_PARAMETER(metadata_cache_readahead_pages);
+    DECLARE_PARAMETER(compress_tlogs_on_backend);
+    DECLARE_PARAMETER(sparse_sco_chunk_size);
+    DECLARE_PARAMETER(elide_zero_clusters);
+    DECLARE_PARAMETER(enable_discard);
+    DECLARE_PARAMETER(snapshots_journal_max_entries);
+    DECLARE_PARAMETER(snapshots_upload_max_tlogs);
     DECLARE_PARAMETER(volume_nullio);
 
 private:
@@ -148,6 +148,10 @@ Volume::Volume(const VolumeConfig& vCfg,
     , has_dumped_debug_data(false)
     , number_of_syncs_(0)
     , total_number_of_syncs_(0)
+    , next_sync_batch_(1)
+    , done_sync_batch_(0)
+    , sync_in_progress_(false)
+    , last_sync_result_(DtlInSync::F)
 {
     WLOCK();
 
@@ -729,6 +733,31 @@ Volume::writeClusterMetaData_(ClusterAddress ca,
         });
 }
 
+void
+Volume::writeClustersMetaData_(const std::vector<ClusterAddress>& cas,
+                               const std::vector<ClusterLocationAndHash>& locs)
+{
+    ASSERT_WRITES_SERIALIZED();
+    ASSERT_RLOCKED();
+    VERIFY(cas.size() == locs.size());
+
+    snapshotManagement_->addClusterEntries(cas,
+                                           locs);
+    try
+    {
+        metaDataStore_->writeClusters(cas.data(),
+                                      locs.data(),
+                                      cas.size());
+    }
+    CATCH_STD_ALL_EWHAT({
+            VolumeDriverError::report(events::VolumeDriverErrorCode::MetaDataStore,
+                                      EWHAT,
+                                      getName());
+            halt();
+            throw;
+        });
+}
+
 void
 Volume::setAsTemplate()
 {
@@ -928,11 +957,166 @@ Volume::write(uint64_t lba,
     return dtl_in_sync;
 }
 
+void
+Volume::discard(uint64_t lba,
+                uint64_t buflen)
+{
+    if (VolManager::get()->volume_nullio.value())
+    {
+        return;
+    }
+
+    if (T(isVolumeTemplate()))
+    {
+        LOG_ERROR("Volume " << getName() << " has been templated, discard is not allowed.");
+        throw VolumeIsTemplateException("Templated Volume, discard forbidden");
+    }
+
+    LOG_VTRACE("lba " << lba << ", len " << buflen);
+
+    checkNotHalted_();
+    checkNotReadOnly_();
+
+    validateIOLength(lba, buflen);
+
+    const uint64_t start = lba * getLBASize();
+    const uint64_t end = start + buflen;
+    const uint64_t cstart = intCeiling(start, getClusterSize());
+    const uint64_t cend = end - end % getClusterSize();
+
+    auto zero([&](uint64_t from, uint64_t to)
+              {
+                  if (from < to)
+                  {
+                      const std::vector<uint8_t> zeroes(to - from, 0);
+                      write(from / getLBASize(),
+                            zeroes.data(),
+                            zeroes.size());
+                  }
+              });
+
+    if (cstart >= cend)
+    {
+        zero(start, end);
+        return;
+    }
+
+    zero(start, cstart);
+    zero(cend, end);
+
+    // Limit the time writes are held up by a large discard (and the size of
+    // the zero buffer if it has to be written out).
+    const uint64_t max_batch = 1024;
+
+    ClusterAddress ca = addr2CA(cstart);
+    const ClusterAddress ca_end = addr2CA(cend);
+
+    while (ca < ca_end)
+    {
+        const ClusterAddress batch_end = std::min(ca_end,
+                                                  ca + max_batch);
+        bool discarded = false;
+
+        {
+            SERIALIZE_WRITES();
+            RLOCK();
+
+            // Discard TLog entries are opt-in as older versions cannot read
+            // them. The DTL has no notion of discards either, so a failover
+            // would bring back the old data - zero the clusters instead.
+            if (VolManager::get()->enable_discard.value() and
+                not failover_->backup())
+            {
+                for (ClusterAddress c = ca; c < batch_end; ++c)
+                {
+                    discardCluster_(c);
+                }
+                discarded = true;
+            }
+        }
+
+        if (not discarded)
+        {
+            zero(ca * getClusterSize(),
+                 batch_end * getClusterSize());
+        }
+
+        ca = batch_end;
+    }
+}
+
+void
+Volume::discardCluster_(ClusterAddress ca)
+{
+    ASSERT_WRITES_SERIALIZED();
+    ASSERT_RLOCKED();
+
+    const ClusterLocationAndHash&
+        discarded(ClusterLocationAndHash::discarded_location_and_hash());
+
+    snapshotManagement_->addDiscardEntry(ca);
+    try
+    {
+        metaDataStore_->writeCluster(ca,
+                                     discarded);
+    }
+    CATCH_STD_ALL_EWHAT({
+            VolumeDriverError::report(events::VolumeDriverErrorCode::MetaDataStore,
+                                      EWHAT,
+                                      getName());
+            halt();
+            throw;
+        });
+
+    purge_from_cluster_cache_(ca,
+                              discarded.weed());
+}
+
 namespace
 {
+
+// Checks 64 bytes at a time so the compiler can vectorise the loop; non-zero
+// data is typically detected in the first block.
+bool
+is_zero_cluster(const uint8_t* buf,
+                const size_t size)
+{
+    const size_t words_per_block = 8;
+    const size_t block_size = words_per_block * sizeof(uint64_t);
+
+    size_t off = 0;
+    for (; off + block_size <= size; off += block_size)
+    {
+        uint64_t w[words_per_block];
+        memcpy(w, buf + off, block_size);
+
+        uint64_t acc = 0;
+        for (size_t i = 0; i < words_per_block; ++i)
+        {
+            acc |= w[i];
+        }
+
+        if (acc != 0)
+        {
+            return false;
+        }
+    }
+
+    for (; off < size; ++off)
+    {
+        if (buf[off] != 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 ClusterLocationAndHash
 make_cluster_location_and_hash(const ClusterLocation& loc,
                                const ClusterCacheMode ccmode,
+                               const yt::WeedType weed_type,
                                const uint8_t* buf,
                                const size_t bufsize)
 {
@@ -940,7 +1124,8 @@ make_cluster_location_and_hash(const ClusterLocation& loc,
     {
         return ClusterLocationAndHash(loc,
                                       buf,
-                                      bufsize);
+                                      bufsize,
+                                      weed_type);
     }
     else
     {
@@ -960,7 +1145,8 @@ Volume::writeClusters_(uint64_t addr,
 
     VERIFY(bufsize % getClusterSize() == 0);
 
-    size_t num_locs = bufsize / getClusterSize();
+    const size_t num_locs = bufsize / getClusterSize();
+    size_t num_data_locs = num_locs;
     unsigned throttle_usecs = 0;
     uint32_t ds_throttle = 0;
 
@@ -970,69 +1156,59 @@ Volume::writeClusters_(uint64_t addr,
         // prevent tlog rollover interfering with snapshotting and friends
         RLOCK();
 
-        TODO("ArneT: reserve/clear vector \"cluster_locations\" so the nr of clusters can be derived in the failover_->addEntries call");
-
-        dataStore_->writeClusters(buf,
-                                  cluster_locations_,
-                                  num_locs,
-                                  ds_throttle);
-
-        const ClusterCacheMode ccmode = effective_cluster_cache_mode();
-
-        for (size_t i = 0; i < num_locs; ++i)
+        // Zero clusters are only elided without a DTL as they would not be
+        // part of a DTL replay.
+        if (VolManager::get()->elide_zero_clusters.value() and
+            not failover_->backup())
         {
-            const uint8_t* data = buf + i * getClusterSize();
-            uint64_t clusteraddr = addr + i * getClusterSize();
-            ClusterAddress ca = addr2CA(clusteraddr);
-            ClusterLocationAndHash
-                loc_and_hash(make_cluster_location_and_hash(cluster_locations_[i],
-                                                            ccmode,
-                                                            data,
-                                                            getClusterSize()));
+            num_data_locs = 0;
+            size_t i = 0;
 
-            writeClusterMetaData_(ca,
-                                  loc_and_hash);
-
-            if (isCacheOnWrite())
+            while (i < num_locs)
             {
-                add_to_cluster_cache_(ccmode,
-                                      ca,
-                                      loc_and_hash.weed(),
-                                      data);
-            }
-            else if (ccmode == ClusterCacheMode::LocationBased)
-            {
-                purge_from_cluster_cache_(ca,
-                                          loc_and_hash.weed());
-            }
-        }
-
-        yt::SteadyTimer t;
-        dtl_in_sync = writeClustersToFailOverCache_(cluster_locations_,
-                                                    num_locs,
-                                                    addr >> volOffset_,
-                                                    buf);
+                size_t j = i;
+                while (j < num_locs and
+                       not is_zero_cluster(buf + j * getClusterSize(),
+                                           getClusterSize()))
+                {
+                    ++j;
+                }
 
-        throttle_usecs += bc::duration_cast<bc::microseconds>(t.elapsed()).count();
+                if (j > i)
+                {
+                    uint32_t t = 0;
+                    writeDataClusters_(addr + i * getClusterSize(),
+                                       buf + i * getClusterSize(),
+                                       j - i,
+                                       t,
+                                       throttle_usecs);
+                    ds_throttle = std::max(ds_throttle, t);
+                    num_data_locs += j - i;
+                }
 
-        const ssize_t sco_cap = dataStore_->getRemainingSCOCapacity();
-        VERIFY(sco_cap >= 0);
+                if (j < num_locs)
+                {
+                    LOG_VTRACE("eliding zero cluster at " << addr + j * getClusterSize());
+                    discardCluster_(addr2CA(addr + j * getClusterSize()));
+                    ++j;
+                }
 
-        if (sco_cap == 0)
+                i = j;
+            }
+        }
+        else
         {
-            LOG_VDEBUG(getName() << ": requesting SCO rollover, adding CRC to tlog");
-            MaybeCheckSum cs = dataStore_->finalizeCurrentSCO();
-            VERIFY(cs);
-            snapshotManagement_->addSCOCRC(*cs);
+            dtl_in_sync = writeDataClusters_(addr,
+                                             buf,
+                                             num_locs,
+                                             ds_throttle,
+                                             throttle_usecs);
         }
     }
 
-    LOG_VTRACE("start_address " << addr <<
-               " CA " << cluster_locations_[0]);
-
     if (ds_throttle > 0)
     {
-        const unsigned ds_throttle_usecs = ds_throttle * num_locs;
+        const unsigned ds_throttle_usecs = ds_throttle * num_data_locs;
         throttle_usecs =
             ds_throttle_usecs - std::min(ds_throttle_usecs,
                                          throttle_usecs);
@@ -1043,6 +1219,81 @@ Volume::writeClusters_(uint64_t addr,
     return dtl_in_sync;
 }
 
+DtlInSync
+Volume::writeDataClusters_(uint64_t addr,
+                           const uint8_t* buf,
+                           size_t num_locs,
+                           uint32_t& ds_throttle,
+                           unsigned& throttle_usecs)
+{
+    ASSERT_WRITES_SERIALIZED();
+    ASSERT_RLOCKED();
+
+    DtlInSync dtl_in_sync = DtlInSync::F;
+
+    TODO("ArneT: reserve/clear vector \"cluster_locations\" so the nr of clusters can be derived in the failover_->addEntries call");
+
+    dataStore_->writeClusters(buf,
+                              cluster_locations_,
+                              num_locs,
+                              ds_throttle);
+
+    const ClusterCacheMode ccmode = effective_cluster_cache_mode();
+
+    for (size_t i = 0; i < num_locs; ++i)
+    {
+        const uint8_t* data = buf + i * getClusterSize();
+        uint64_t clusteraddr = addr + i * getClusterSize();
+        ClusterAddress ca = addr2CA(clusteraddr);
+        ClusterLocationAndHash
+            loc_and_hash(make_cluster_location_and_hash(cluster_locations_[i],
+                                                        ccmode,
+                                                        config_.weed_type(),
+                                                        data,
+                                                        getClusterSize()));
+
+        writeClusterMetaData_(ca,
+                              loc_and_hash);
+
+        if (isCacheOnWrite())
+        {
+            add_to_cluster_cache_(ccmode,
+                                  ca,
+                                  loc_and_hash.weed(),
+                                  data);
+        }
+        else if (ccmode == ClusterCacheMode::LocationBased)
+        {
+            purge_from_cluster_cache_(ca,
+                                      loc_and_hash.weed());
+        }
+    }
+
+    yt::SteadyTimer t;
+    dtl_in_sync = writeClustersToFailOverCache_(cluster_locations_,
+                                                num_locs,
+                                                addr >> volOffset_,
+                                                buf);
+
+    throttle_usecs += bc::duration_cast<bc::microseconds>(t.elapsed()).count();
+
+    const ssize_t sco_cap = dataStore_->getRemainingSCOCapacity();
+    VERIFY(sco_cap >= 0);
+
+    if (sco_cap == 0)
+    {
+        LOG_VDEBUG(getName() << ": requesting SCO rollover, adding CRC to tlog");
+        MaybeCheckSum cs = dataStore_->finalizeCurrentSCO();
+        VERIFY(cs);
+        snapshotManagement_->addSCOCRC(*cs);
+    }
+
+    LOG_VTRACE("start_address " << addr <<
+               " CA " << cluster_locations_[0]);
+
+    return dtl_in_sync;
+}
+
 void
 Volume::read(uint64_t lba,
              uint8_t *buf,
@@ -1135,29 +1386,44 @@ Volume::readClusters_(uint64_t addr,
 
     // Z42: Move this to the caller or make it thread local storage to
     // avoid allocations
+    const size_t count = bufsize / getClusterSize();
+    const ClusterAddress start = addr2CA(addr);
+
     std::vector<ClusterReadDescriptor> read_descriptors;
-    read_descriptors.reserve(bufsize / getClusterSize());
+    read_descriptors.reserve(count);
     const ClusterCacheMode ccmode = effective_cluster_cache_mode();
 
-    for (uint64_t off = 0; off < bufsize; off += getClusterSize())
+    // Metadata lookups are done in one go so the mdstore can resolve all
+    // clusters of a page at once.
+    std::vector<ClusterLocationAndHash> md_locs(count);
+    readcounter_ += count;
+
+    try
     {
-        TODO("AR: go to the cluster cache immediately when LocationBased?");
+        metaDataStore_->readClusters(start,
+                                     count,
+                                     md_locs.data());
+    }
+    CATCH_STD_ALL_EWHAT({
+            VolumeDriverError::report(events::VolumeDriverErrorCode::MetaDataStore,
+                                      EWHAT,
+                                      getName());
+            halt();
+            throw;
+        });
 
-        ClusterLocationAndHash loc_and_hash;
-        ClusterAddress ca = addr2CA(addr + off);
-        ++readcounter_;
+    std::vector<ClusterLocationAndHash> locs;
+    std::vector<ClusterCacheIODescriptor> cc_descs;
+    locs.reserve(count);
+    cc_descs.reserve(count);
 
-        try
-        {
-            metaDataStore_->readCluster(ca, loc_and_hash);
-        }
-        CATCH_STD_ALL_EWHAT({
-                VolumeDriverError::report(events::VolumeDriverErrorCode::MetaDataStore,
-                                          EWHAT,
-                                          getName());
-                halt();
-                throw;
-            });
+    for (size_t i = 0; i < count; ++i)
+    {
+        TODO("AR: go to the cluster cache immediately when LocationBased?");
+
+        const uint64_t off = i * getClusterSize();
+        const ClusterLocationAndHash& loc_and_hash = md_locs[i];
+        const ClusterAddress ca = start + i;
 
         LOG_VTRACE("lba " << ((addr + off) / getLBASize()) <<
                    " CA " << loc_and_hash);
@@ -1167,46 +1433,61 @@ Volume::readClusters_(uint64_t addr,
             // read of cluster that has not been written
             // TRACE?
             LOG_VTRACE("read lba " << addr / getLBASize() << " + " << bufsize <<
-                       ", off " << off << ", CA " <<
-                       addr2CA(addr + off) <<
+                       ", off " << off << ", CA " << ca <<
                        " - CA not previously written to");
             memset(buf + off, 0x0, getClusterSize());
         }
         else
         {
-            const bool in_cache = find_in_cluster_cache_(ccmode,
-                                                         ca,
-                                                         loc_and_hash.weed(),
-                                                         buf + off);
+            cc_descs.emplace_back(ca,
+                                  loc_and_hash.weed(),
+                                  buf + off);
+            locs.emplace_back(loc_and_hash);
+        }
+    }
 
-            if (in_cache)
-            {
-                ++readCacheHits_;
-                dataStore_->touchCluster(loc_and_hash.clusterLocation);
-            }
-            else
-            {
-                ++readCacheMisses_;
-                read_descriptors.
-                    push_back(ClusterReadDescriptor(loc_and_hash,
-                                                    ca,
-                                                    buf + off,
-                                                    getBackendInterface(loc_and_hash.clusterLocation.cloneID())->clone()));
-            }
+    // All cluster cache lookups are done in one go to allow the cache to
+    // coalesce the device reads.
+    find_in_cluster_cache_(ccmode,
+                           cc_descs);
+
+    for (size_t i = 0; i < cc_descs.size(); ++i)
+    {
+        const ClusterCacheIODescriptor& desc = cc_descs[i];
+        const ClusterLocationAndHash& loc_and_hash = locs[i];
+
+        if (desc.hit)
+        {
+            ++readCacheHits_;
+            dataStore_->touchCluster(loc_and_hash.clusterLocation);
+        }
+        else
+        {
+            ++readCacheMisses_;
+            read_descriptors.
+                push_back(ClusterReadDescriptor(loc_and_hash,
+                                                desc.ca,
+                                                desc.buf,
+                                                getBackendInterface(loc_and_hash.clusterLocation.cloneID())->clone()));
         }
     }
 
     dataStore_->readClusters(read_descriptors);
 
-    if (effective_cluster_cache_behaviour() != ClusterCacheBehaviour::NoCache)
+    if (effective_cluster_cache_behaviour() != ClusterCacheBehaviour::NoCache and
+        not read_descriptors.empty())
     {
+        cc_descs.clear();
+
         for (const ClusterReadDescriptor& clrd : read_descriptors)
         {
-            add_to_cluster_cache_(ccmode,
-                                  clrd.getClusterAddress(),
+            cc_descs.emplace_back(clrd.getClusterAddress(),
                                   clrd.weed(),
                                   clrd.getBuffer());
         }
+
+        add_to_cluster_cache_(ccmode,
+                              cc_descs);
     }
 }
 
@@ -2078,14 +2359,15 @@ Volume::removeUpToFromFailOverCache(const SCO sconame)
 }
 
 void
-Volume::replayClusterFromFailOverCache_(ClusterAddress ca,
-                                        const ClusterLocation& loc,
-                                        const uint8_t* buf)
+Volume::replayClustersFromFailOverCache_(const std::vector<ClusterAddress>& cas,
+                                         const ClusterLocation& loc,
+                                         const uint8_t* buf)
 {
     ASSERT_WRITES_SERIALIZED();
     ASSERT_WLOCKED();
 
-    LOG_VTRACE("ca " << ca << ", loc " << loc << ", buf " << &buf);
+    LOG_VTRACE("first ca " << cas.front() << ", loc " << loc << ", clusters " <<
+               cas.size() << ", buf " << &buf);
     checkNotHalted_();
 
     uint32_t throttle = 0;
@@ -2101,9 +2383,10 @@ Volume::replayClusterFromFailOverCache_(ClusterAddress ca,
     // than what is currently configured, i.e.
     // dataStore_->getRemainingSCOCapacity() could return values < 0.
     // So no sanity check here!
-    dataStore_->writeClusterToLocation(buf,
-                                       loc,
-                                       throttle);
+    dataStore_->writeClustersToLocation(buf,
+                                        loc,
+                                        cas.size(),
+                                        throttle);
 
     // if the SCO is filled up at this stage it will be either rolled over on
     // the next cluster replay or - if there is no next cluster - as part of
@@ -2113,11 +2396,21 @@ Volume::replayClusterFromFailOverCache_(ClusterAddress ca,
         snapshotManagement_->addSCOCRC(*forced_rollover);
     }
 
-    ClusterLocationAndHash loc_and_hash(loc,
-                                        buf,
-                                        getClusterSize());
-    writeClusterMetaData_(ca,
-                          loc_and_hash);
+    std::vector<ClusterLocationAndHash> locs;
+    locs.reserve(cas.size());
+
+    for (size_t i = 0; i < cas.size(); ++i)
+    {
+        const ClusterLocation l(loc.sco(),
+                                loc.offset() + i);
+        locs.emplace_back(l,
+                          buf + i * getClusterSize(),
+                          getClusterSize(),
+                          config_.weed_type());
+    }
+
+    writeClustersMetaData_(cas,
+                           locs);
 
     if(throttle > 0)
     {
@@ -2479,7 +2772,7 @@ Volume::sync()
     uint64_t number_of_syncs_to_ignore, maximum_time_to_ignore_syncs_in_seconds;
     std::tie(number_of_syncs_to_ignore, maximum_time_to_ignore_syncs_in_seconds) = getSyncSettings();
 
-    WLOCK();
+    boost::unique_lock<decltype(sync_lock_)> l(sync_lock_);
 
     ++total_number_of_syncs_;
 
@@ -2490,9 +2783,60 @@ Volume::sync()
     {
         number_of_syncs_ = 0;
         sync_wall_timer_.restart();
-        dtl_in_sync = sync_(AppendCheckSum::F);
+
+        // A batch that is already in flight might have missed writes that
+        // completed before this request - wait for the next one.
+        const uint64_t batch = next_sync_batch_;
+
+        while (done_sync_batch_ < batch)
+        {
+            if (sync_in_progress_)
+            {
+                sync_cond_.wait(l);
+            }
+            else
+            {
+                sync_in_progress_ = true;
+                const uint64_t b = next_sync_batch_++;
+
+                l.unlock();
+
+                DtlInSync res = DtlInSync::F;
+                std::exception_ptr err;
+
+                try
+                {
+                    // Writers are only held off by the DataStore and TLog
+                    // syncs themselves, snapshotting & friends by the rwlock.
+                    RLOCK();
+                    res = do_sync_(AppendCheckSum::F);
+                }
+                catch (...)
+                {
+                    err = std::current_exception();
+                }
+
+                l.lock();
+
+                done_sync_batch_ = b;
+                last_sync_result_ = res;
+                last_sync_error_ = err;
+                sync_in_progress_ = false;
+
+                sync_cond_.notify_all();
+            }
+        }
+
+        if (last_sync_error_)
+        {
+            std::rethrow_exception(last_sync_error_);
+        }
+
+        dtl_in_sync = last_sync_result_;
     }
 
+    l.unlock();
+
     const auto duration_us(bc::duration_cast<bc::microseconds>(t.elapsed()));
     performance_counters().sync_request_usecs.count(duration_us.count());
 
@@ -2503,7 +2847,12 @@ DtlInSync
 Volume::sync_(AppendCheckSum append_chksum)
 {
     ASSERT_WLOCKED();
+    return do_sync_(append_chksum);
+}
 
+DtlInSync
+Volume::do_sync_(AppendCheckSum append_chksum)
+{
     LOG_VTRACE("syncing volume");
 
     checkNotHalted_();
@@ -2693,42 +3042,84 @@ Volume::replayFOC_(FailOverCacheProxy& foc)
     ASSERT_WRITES_SERIALIZED();
     ASSERT_WLOCKED();
 
+    // Consecutive entries of a SCO are gathered and replayed with a single
+    // datastore write. The batch size is bounded to keep the buffer small.
+    const size_t max_batch_size = 256;
+
+    std::vector<ClusterAddress> batch_cas;
+    std::vector<uint8_t> batch_buf;
+    ClusterLocation batch_loc;
+
+    batch_cas.reserve(max_batch_size);
+    batch_buf.reserve(max_batch_size * clusterSize_);
+
+    auto replay_batch([&]
+                      {
+                          if (batch_cas.empty())
+                          {
+                              return;
+                          }
+
+                          uint32_t counter = 0;
+
+                          while (true)
+                          {
+                              try
+                              {
+                                  replayClustersFromFailOverCache_(batch_cas,
+                                                                   batch_loc,
+                                                                   batch_buf.data());
+                                  break;
+                              }
+                              catch (TransientException& e)
+                              {
+                                  LOG_VINFO("TransientException");
+                                  if (++counter == 256)
+                                  {
+                                      throw;
+                                  }
+                                  boost::this_thread::sleep_for(bc::seconds(1));
+                              }
+                          }
+
+                          batch_cas.clear();
+                          batch_buf.clear();
+                      });
+
     auto fun([&](ClusterLocation loc,
                  uint64_t lba,
                  const byte* buf,
                  size_t size)
              {
-                 uint32_t counter = 0;
                  LOG_VTRACE("Replaying " << loc << "lba " << lba);
 
                  VERIFY(size == static_cast<size_t>(clusterSize_));
 
                  validateIOAlignment(lba, size);
 
-                 while (true)
+                 if (not batch_cas.empty() and
+                     (batch_cas.size() == max_batch_size or
+                      loc.sco() != batch_loc.sco() or
+                      static_cast<size_t>(loc.offset()) != batch_loc.offset() + batch_cas.size()))
                  {
-                     try
-                     {
-                         replayClusterFromFailOverCache_(addr2CA(LBA2Addr(lba)),
-                                                         loc,
-                                                         buf);
-                         return;
-                     }
-                     catch (TransientException& e)
-                     {
-                         LOG_VINFO("TransientException");
-                         if (++counter == 256)
-                         {
-                             throw;
-                         }
-                         boost::this_thread::sleep_for(bc::seconds(1));
-                     }
+                     replay_batch();
                  }
+
+                 if (batch_cas.empty())
+                 {
+                     batch_loc = loc;
+                 }
+
+                 batch_cas.push_back(addr2CA(LBA2Addr(lba)));
+                 batch_buf.insert(batch_buf.end(),
+                                  buf,
+                                  buf + size);
              });
 
     try
     {
         foc.getEntries(std::move(fun));
+        replay_batch();
 
         MaybeCheckSum cs = dataStore_->finalizeCurrentSCO();
 
@@ -3372,14 +3763,9 @@ Volume::add_to_cluster_cache_(const ClusterCacheMode ccmode,
                               const youtils::Weed& weed,
                               const uint8_t* buf)
 {
-    // For now we only use the cache if it has the same cluster size. We could
-    // try harder and split volume clusters into smaller cache clusters.
-    ClusterCache& cache = VolManager::get()->getClusterCache();
-
-    if ((ClusterLocationAndHash::use_hash() or
-         ccmode != ClusterCacheMode::ContentBased) and
-        cache.cluster_size() == getClusterSize())
+    if (use_cluster_cache_(ccmode))
     {
+        ClusterCache& cache = VolManager::get()->getClusterCache();
         cache.add(getClusterCacheHandle(),
                   ca,
                   weed,
@@ -3388,6 +3774,18 @@ Volume::add_to_cluster_cache_(const ClusterCacheMode ccmode,
     }
 }
 
+void
+Volume::add_to_cluster_cache_(const ClusterCacheMode ccmode,
+                              const std::vector<ClusterCacheIODescriptor>& descs)
+{
+    if (use_cluster_cache_(ccmode))
+    {
+        ClusterCache& cache = VolManager::get()->getClusterCache();
+        cache.add(getClusterCacheHandle(),
+                  descs);
+    }
+}
+
 void
 Volume::purge_from_cluster_cache_(const ClusterAddress ca,
                                   const youtils::Weed& weed)
@@ -3404,32 +3802,31 @@ Volume::purge_from_cluster_cache_(const ClusterAddress ca,
     }
 }
 
-bool
+void
 Volume::find_in_cluster_cache_(const ClusterCacheMode ccmode,
-                               const ClusterAddress ca,
-                               const youtils::Weed& weed,
-                               uint8_t* buf)
+                               std::vector<ClusterCacheIODescriptor>& descs)
 {
-    // For now we only use the cache if it has the same cluster size. We could
-    // try harder and split volume clusters into smaller cache clusters.
-    ClusterCache& cache = VolManager::get()->getClusterCache();
-
-    if ((ClusterLocationAndHash::use_hash() or
-         ccmode != ClusterCacheMode::ContentBased) and
-        cache.cluster_size() == getClusterSize())
-    {
-        return cache.read(getClusterCacheHandle(),
-                          ca,
-                          weed,
-                          buf,
-                          static_cast<size_t>(getClusterSize()));
-    }
-    else
+    if (not descs.empty() and
+        use_cluster_cache_(ccmode))
     {
-        return false;
+        ClusterCache& cache = VolManager::get()->getClusterCache();
+        cache.read(getClusterCacheHandle(),
+                   descs);
     }
 }
 
+bool
+Volume::use_cluster_cache_(const ClusterCacheMode ccmode) const
+{
+    const ClusterCache& cache = VolManager::get()->getClusterCache();
+
+    // For now we only use the cache if it has the same cluster size. We could
+    // try harder and split volume clusters into smaller cache clusters.
+    return (ClusterLocationAndHash::use_hash() or
+            ccmode != ClusterCacheMode::ContentBased) and
+        cache.cluster_size() == getClusterSize();
+}
+
 PrefetchData&
 Volume::get_prefetch_data_()
 {
@@ -36,11 +36,13 @@
 #include "VolumeException.h"
 
 #include <atomic>
+#include <exception>
 #include <memory>
 #include <mutex>
 #include <set>
 
 #include <boost/circular_buffer.hpp>
+#include <boost/thread/condition_variable.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/utility.hpp>
 
@@ -64,6 +66,7 @@ namespace volumedriver
 {
 VD_BOOLEAN_ENUM(DeleteFailOverCache);
 
+struct ClusterCacheIODescriptor;
 class ClusterReadDescriptor;
 class DataStoreNG;
 class FailOverCacheAsyncBridge;
@@ -168,6 +171,15 @@ public:
     void
     read(uint64_t lba, uint8_t *buf, uint64_t len);
 
+    // Unmaps the range: whole clusters are recorded as discarded in the TLog
+    // and the metadata (which frees their data for the scrubber), partially
+    // covered ones are overwritten with zeroes. Whole clusters are overwritten
+    // with zeroes as well unless enable_discard is set and there's no DTL.
+    // Reads return zeroes afterwards.
+    /** @exception IOException, MetaDataStoreException */
+    void
+    discard(uint64_t lba, uint64_t len);
+
     /** @exception IOException */
     DtlInSync
     sync();
@@ -588,10 +600,23 @@ private:
     std::atomic<uint64_t> readCacheMisses_;
     bool has_dumped_debug_data;
 
+    boost::optional<ClusterCacheHandle> cluster_cache_handle_;
+
+    // Group commit of sync() requests: syncs are carried out in numbered
+    // batches, one at a time. A request waits for the first batch that starts
+    // after it came in, so requests arriving while a batch is in flight are
+    // served together by the next one. Also protects the sync ignore state.
+    boost::mutex sync_lock_;
+    boost::condition_variable sync_cond_;
     uint64_t number_of_syncs_;
     uint64_t total_number_of_syncs_;
-    boost::optional<ClusterCacheHandle> cluster_cache_handle_;
     youtils::wall_timer2 sync_wall_timer_;
+    // the batch that has not started yet
+    uint64_t next_sync_batch_;
+    uint64_t done_sync_batch_;
+    bool sync_in_progress_;
+    DtlInSync last_sync_result_;
+    std::exception_ptr last_sync_error_;
 
     std::unique_ptr<PrefetchData> prefetch_data_;
 
@@ -606,6 +631,18 @@ private:
                    const uint8_t* buf,
                    uint64_t bufsize);
 
+    // num_locs clusters to the current SCO, the metadata and the DTL
+    DtlInSync
+    writeDataClusters_(uint64_t addr,
+                       const uint8_t* buf,
+                       size_t num_locs,
+                       uint32_t& ds_throttle,
+                       unsigned& throttle_usecs);
+
+    // metadata only: recorded as discarded in the TLog and the mdstore
+    void
+    discardCluster_(ClusterAddress ca);
+
     void
     readClusters_(uint64_t addr,
                   uint8_t* buf,
@@ -646,9 +683,14 @@ private:
                           const ClusterLocationAndHash& loc);
 
     void
-    replayClusterFromFailOverCache_(ClusterAddress ca,
-                                    const ClusterLocation& loc,
-                                    const uint8_t* buf);
+    writeClustersMetaData_(const std::vector<ClusterAddress>& cas,
+                           const std::vector<ClusterLocationAndHash>& locs);
+
+    // cas.size() consecutive clusters starting at loc
+    void
+    replayClustersFromFailOverCache_(const std::vector<ClusterAddress>& cas,
+                                     const ClusterLocation& loc,
+                                     const uint8_t* buf);
 
     DtlInSync
     writeClustersToFailOverCache_(const std::vector<ClusterLocation>& locs,
@@ -665,6 +707,10 @@ private:
     DtlInSync
     sync_(AppendCheckSum append_chksum);
 
+    // requires the rwlock_ to be held (shared or exclusive)
+    DtlInSync
+    do_sync_(AppendCheckSum append_chksum);
+
     void
     cleanupScrubbingOnError_(const backend::Namespace&,
                              const scrubbing::ScrubberResult&,
@@ -735,11 +781,16 @@ private:
     purge_from_cluster_cache_(const ClusterAddress,
                               const youtils::Weed&);
 
-    bool
+    void
+    add_to_cluster_cache_(const ClusterCacheMode,
+                          const std::vector<ClusterCacheIODescriptor>&);
+
+    void
     find_in_cluster_cache_(const ClusterCacheMode,
-                           const ClusterAddress,
-                           const youtils::Weed&,
-                           uint8_t*);
+                           std::vector<ClusterCacheIODescriptor>&);
+
+    bool
+    use_cluster_cache_(const ClusterCacheMode) const;
 
     PrefetchData&
     get_prefetch_data_();
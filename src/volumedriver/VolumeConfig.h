@@ -49,6 +49,7 @@
 #include <youtils/Assert.h>
 #include <youtils/EnumUtils.h>
 #include <youtils/Serialization.h>
+#include <youtils/WeedType.h>
 
 namespace volumedriver
 {
@@ -87,6 +88,7 @@ public:
         , cluster_cache_mode_(t.get_cluster_cache_mode())
         , cluster_cache_limit_(t.get_cluster_cache_limit())
         , metadata_cache_capacity_(t.get_metadata_cache_capacity())
+        , weed_type_(t.get_weed_type())
         , metadata_backend_config_(t.get_metadata_backend_config() ?
                                    t.get_metadata_backend_config()->clone().release() :
                                    new TCBTMetaDataBackendConfig())
@@ -187,6 +189,16 @@ public:
 
     boost::optional<size_t> metadata_cache_capacity_;
 
+    // How ContentBased cluster cache keys are computed. Not set for volumes
+    // created before this was configurable - these use MD5.
+    const boost::optional<youtils::WeedType> weed_type_;
+
+    youtils::WeedType
+    weed_type() const
+    {
+        return weed_type_ ? *weed_type_ : youtils::WeedType::Md5;
+    }
+
     using MetaDataBackendConfigPtr = std::unique_ptr<MetaDataBackendConfig>;
     MetaDataBackendConfigPtr metadata_backend_config_;
 
@@ -317,7 +329,7 @@ private:
             // No backward compatibility for now.
             // The below checks are left in place in case we ever want to change that
             // and serve as documentation.
-            THROW_SERIALIZATION_ERROR(version, 11, 15);
+            THROW_SERIALIZATION_ERROR(version, 11, 16);
         }
 
         if(version == 4)
@@ -427,6 +439,11 @@ private:
             ar & metadata_cache_capacity_;
         }
 
+        if (version >= 16)
+        {
+            ar & const_cast<boost::optional<youtils::WeedType>&>(weed_type_);
+        }
+
         // cf. comment in constructor.
 
         Namespace tmp = backend::Namespace(ns_);
@@ -436,9 +453,9 @@ private:
     void
     save(Archive& ar, const unsigned int version) const
     {
-        if (version != 15)
+        if (version != 16)
         {
-            THROW_SERIALIZATION_ERROR(version, 15, 15);
+            THROW_SERIALIZATION_ERROR(version, 16, 16);
         }
 
         ar & id_;
@@ -462,6 +479,7 @@ private:
         ar & owner_tag_;
         ar & cluster_cache_limit_;
         ar & metadata_cache_capacity_;
+        ar & weed_type_;
     }
 };
 
@@ -487,7 +505,7 @@ struct EnumTraits<volumedriver::VolumeConfig::WanBackupVolumeRole>
 
 }
 
-BOOST_CLASS_VERSION(volumedriver::VolumeConfig, 15);
+BOOST_CLASS_VERSION(volumedriver::VolumeConfig, 16);
 
 #endif /* !VOLUMECONFIG_H_ */
 
@@ -83,6 +83,7 @@ public:
         , C(cluster_cache_mode_)
         , C(cluster_cache_limit_)
         , C(metadata_cache_capacity_)
+        , C(weed_type_)
     {}
 
     VolumeConfigParameters(VolumeConfigParameters&& other)
@@ -104,6 +105,7 @@ public:
         , M(cluster_cache_mode_)
         , M(cluster_cache_limit_)
         , M(metadata_cache_capacity_)
+        , M(weed_type_)
     {}
 
 #undef M
@@ -147,6 +149,7 @@ private:                                        \
     OPTIONAL_PARAM(ClusterCacheMode, cluster_cache_mode);
     OPTIONAL_PARAM(ClusterCount, cluster_cache_limit);
     OPTIONAL_PARAM(uint32_t, metadata_cache_capacity);
+    OPTIONAL_PARAM(youtils::WeedType, weed_type);
 
 #undef OPTIONAL_PARAM
 #undef PARAM
@@ -209,6 +212,7 @@ struct VanillaVolumeConfigParameters
     SETTER(max_non_disposable_factor);
     SETTER(metadata_cache_capacity);
     SETTER(metadata_backend_config);
+    SETTER(weed_type);
 };
 
 struct CloneVolumeConfigParameters
@@ -245,6 +249,7 @@ struct CloneVolumeConfigParameters
     SETTER(cluster_cache_limit);
     SETTER(metadata_cache_capacity);
     SETTER(metadata_backend_config);
+    SETTER(weed_type);
 };
 
 struct WriteOnlyVolumeConfigParameters
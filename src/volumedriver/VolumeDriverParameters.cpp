@@ -168,6 +168,69 @@ DEFINE_INITIALIZED_PARAM_WITH_DEFAULT(allow_inconsistent_partial_reads,
                                       ShowDocumentation::F,
                                       true);
 
+DEFINE_INITIALIZED_PARAM_WITH_DEFAULT(partial_read_threads,
+                                      volmanager_component_name,
+                                      "partial_read_threads",
+                                      "Max number of threads per read request issuing partial reads to the backend concurrently (one per clone and SCO), the calling thread included - 1: sequential",
+                                      ShowDocumentation::T,
+                                      1);
+
+DEFINE_INITIALIZED_PARAM_WITH_DEFAULT(partial_read_pool_size,
+                                      volmanager_component_name,
+                                      "partial_read_pool_size",
+                                      "Number of threads shared by all volumes to help out read requests with concurrent partial reads (cf. partial_read_threads), only started once partial_read_threads > 1",
+                                      ShowDocumentation::T,
+                                      16);
+
+DEFINE_INITIALIZED_PARAM_WITH_DEFAULT(metadata_cache_readahead_pages,
+                                      volmanager_component_name,
+                                      "metadata_cache_readahead_pages",
+                                      "Number of metadata pages to fetch ahead in one go on sequential metadata cache misses - 0: no readahead",
+                                      ShowDocumentation::T,
+                                      0);
+
+DEFINE_INITIALIZED_PARAM_WITH_DEFAULT(compress_tlogs_on_backend,
+                                      volmanager_component_name,
+                                      "compress_tlogs_on_backend",
+                                      "Whether to store TLogs in the compressed (delta encoded) format on the backend - older versions cannot read these",
+                                      ShowDocumentation::T,
+                                      false);
+
+DEFINE_INITIALIZED_PARAM_WITH_DEFAULT(sparse_sco_chunk_size,
+                                      volmanager_component_name,
+                                      "sparse_sco_chunk_size",
+                                      "Size of the chunks fetched from the backend into sparsely cached SCOs on read misses (e.g. 262144) - 0: fetch whole SCOs / use plain partial reads",
+                                      ShowDocumentation::T,
+                                      0);
+
+DEFINE_INITIALIZED_PARAM_WITH_DEFAULT(elide_zero_clusters,
+                                      volmanager_component_name,
+                                      "elide_zero_clusters",
+                                      "Whether to store written all-zero clusters as discarded in the metadata instead of in SCOs - only applies to volumes without a DTL, older versions cannot read the resulting TLogs",
+                                      ShowDocumentation::T,
+                                      false);
+
+DEFINE_INITIALIZED_PARAM_WITH_DEFAULT(enable_discard,
+                                      volmanager_component_name,
+                                      "enable_discard",
+                                      "Whether to record discards (TRIM / UNMAP, hole punching) as discard entries in the TLogs - older versions cannot read these. If disabled or while a volume has a DTL (which does not know about discards) the discarded range is overwritten with zeroes instead",
+                                      ShowDocumentation::T,
+                                      false);
+
+DEFINE_INITIALIZED_PARAM_WITH_DEFAULT(snapshots_journal_max_entries,
+                                      volmanager_component_name,
+                                      "snapshots_journal_max_entries",
+                                      "Max number of TLog rollover records to append to a volume's snapshots journal before rewriting its snapshots.xml - 0: rewrite snapshots.xml on every rollover",
+                                      ShowDocumentation::T,
+                                      1024);
+
+DEFINE_INITIALIZED_PARAM_WITH_DEFAULT(snapshots_upload_max_tlogs,
+                                      volmanager_component_name,
+                                      "snapshots_upload_max_tlogs",
+                                      "Max number of TLogs written to the backend to account for with a single upload of the volume's snapshots.xml while more TLogs are queued for the backend - 0 or 1: upload snapshots.xml for every TLog",
+                                      ShowDocumentation::T,
+                                      16);
+
 DEFINE_INITIALIZED_PARAM_WITH_DEFAULT(freespace_check_interval,
                                       volmanager_component_name,
                                       "freespace_check_interval",
@@ -203,6 +266,13 @@ DEFINE_INITIALIZED_PARAM_WITH_DEFAULT(metadata_cache_capacity,
                                       ShowDocumentation::T,
                                       8192);
 
+DEFINE_INITIALIZED_PARAM_WITH_DEFAULT(default_weed_type,
+                                      volmanager_component_name,
+                                      "default_weed_type",
+                                      "Algorithm to compute the ContentBased read cache keys of new volumes with, Md5 or Murmur3_128. Murmur3_128 is faster but allows a volume to plant colliding clusters in the cache shared with other volumes, so only use it if all volumes on the node are trusted. It is recorded per volume, existing volumes and clones of them keep theirs",
+                                      ShowDocumentation::T,
+                                      youtils::WeedType::Md5);
+
 DEFINE_INITIALIZED_PARAM_WITH_DEFAULT(debug_metadata_path,
                                       volmanager_component_name,
                                       "no_python_name",
@@ -25,6 +25,7 @@
 
 #include <youtils/ArakoonNodeConfig.h>
 #include <youtils/InitializedParam.h>
+#include <youtils/WeedType.h>
 
 namespace initialized_params
 {
@@ -70,6 +71,23 @@ DECLARE_RESETTABLE_INITIALIZED_PARAM_WITH_DEFAULT(max_volume_size,
                                                   std::atomic<uint64_t>);
 DECLARE_RESETTABLE_INITIALIZED_PARAM_WITH_DEFAULT(allow_inconsistent_partial_reads,
                                                   std::atomic<bool>);
+DECLARE_RESETTABLE_INITIALIZED_PARAM_WITH_DEFAULT(partial_read_threads,
+                                                  std::atomic<uint32_t>);
+DECLARE_INITIALIZED_PARAM_WITH_DEFAULT(partial_read_pool_size, uint32_t);
+DECLARE_RESETTABLE_INITIALIZED_PARAM_WITH_DEFAULT(metadata_cache_readahead_pages,
+                                                  std::atomic<uint32_t>);
+DECLARE_RESETTABLE_INITIALIZED_PARAM_WITH_DEFAULT(compress_tlogs_on_backend,
+                                                  std::atomic<bool>);
+DECLARE_RESETTABLE_INITIALIZED_PARAM_WITH_DEFAULT(sparse_sco_chunk_size,
+                                                  std::atomic<uint32_t>);
+DECLARE_RESETTABLE_INITIALIZED_PARAM_WITH_DEFAULT(elide_zero_clusters,
+                                                  std::atomic<bool>);
+DECLARE_RESETTABLE_INITIALIZED_PARAM_WITH_DEFAULT(enable_discard,
+                                                  std::atomic<bool>);
+DECLARE_RESETTABLE_INITIALIZED_PARAM_WITH_DEFAULT(snapshots_journal_max_entries,
+                                                  std::atomic<uint32_t>);
+DECLARE_RESETTABLE_INITIALIZED_PARAM_WITH_DEFAULT(snapshots_upload_max_tlogs,
+                                                  std::atomic<uint32_t>);
 
 DECLARE_INITIALIZED_PARAM_WITH_DEFAULT(number_of_scos_in_tlog,
                                        uint32_t);
@@ -79,6 +97,8 @@ DECLARE_INITIALIZED_PARAM_WITH_DEFAULT(default_cluster_size,
                                        uint32_t);
 DECLARE_INITIALIZED_PARAM_WITH_DEFAULT(metadata_cache_capacity,
                                        uint32_t);
+DECLARE_RESETTABLE_INITIALIZED_PARAM_WITH_DEFAULT(default_weed_type,
+                                                  youtils::WeedType);
 
 DECLARE_INITIALIZED_PARAM_WITH_DEFAULT(debug_metadata_path, std::string);
 DECLARE_INITIALIZED_PARAM_WITH_DEFAULT(arakoon_metadata_sequence_size, uint32_t);
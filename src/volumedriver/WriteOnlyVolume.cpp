@@ -324,6 +324,49 @@ WriteOnlyVolume::write(uint64_t lba,
     VERIFY(off == len);
 }
 
+void
+WriteOnlyVolume::discard(uint64_t lba,
+                         uint64_t buflen)
+{
+    LOG_DEBUG("lba " << lba << ", len " << buflen);
+
+    checkNotHalted_();
+    validateIOLength(lba, buflen);
+
+    if ((lba & ~caMask_) != 0 or
+        buflen % getClusterSize() != 0)
+    {
+        LOG_ERROR("Write Only volumes don't do unaligned discards");
+        throw UnalignedWriteException("Unaligned discard on write only volume");
+    }
+
+    if (not VolManager::get()->enable_discard.value())
+    {
+        // Discard TLog entries are opt-in as older versions cannot read them.
+        const uint64_t max_chunk = 1024 * getClusterSize();
+        const std::vector<uint8_t> zeroes(std::min(buflen, max_chunk), 0);
+
+        for (uint64_t off = 0; off < buflen; off += zeroes.size())
+        {
+            write(lba + off / getLBASize(),
+                  zeroes.data(),
+                  std::min<uint64_t>(zeroes.size(), buflen - off));
+        }
+        return;
+    }
+
+    const ClusterAddress start = addr2CA(LBA2Addr(lba));
+    const ClusterAddress end = start + buflen / getClusterSize();
+
+    SERIALIZE_WRITES();
+    WLOCK();
+
+    for (ClusterAddress ca = start; ca < end; ++ca)
+    {
+        snapshotManagement_->addDiscardEntry(ca);
+    }
+}
+
 void
 WriteOnlyVolume::writeClusters_(uint64_t addr,
                                 const uint8_t* buf,
@@ -353,7 +396,8 @@ WriteOnlyVolume::writeClusters_(uint64_t addr,
             ClusterAddress ca = addr2CA(clusteraddr);
             ClusterLocationAndHash loc_and_hash(cluster_locations_[i],
                                                 data,
-                                                getClusterSize());
+                                                getClusterSize(),
+                                                cfg_.weed_type());
 
             writeClusterMetaData_(ca,
                                   loc_and_hash);
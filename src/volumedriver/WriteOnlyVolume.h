@@ -128,6 +128,11 @@ public:
     void
     write(uint64_t lba, const uint8_t *buf, uint64_t len);
 
+    // Only whole clusters can be discarded.
+    /** @exception IOException */
+    void
+    discard(uint64_t lba, uint64_t len);
+
     /** @exception IOException */
     void
     sync();
@@ -90,7 +90,7 @@ Backend::removeUpTo(const SCO sconame)
 
 void
 Backend::addEntries(std::vector<FailOverCacheEntry> entries,
-                    std::unique_ptr<uint8_t[]> buf)
+                    ReceiveBuffer buf)
 {
     VERIFY(not entries.empty());
 
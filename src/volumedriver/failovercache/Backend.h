@@ -22,6 +22,7 @@
 #include "../ClusterLocation.h"
 #include "../FailOverCacheStreamers.h"
 #include "../Types.h"
+#include "ReceiveBufferPool.h"
 
 namespace failovercache
 {
@@ -43,7 +44,7 @@ public:
 
     void
     addEntries(std::vector<volumedriver::FailOverCacheEntry>,
-               std::unique_ptr<uint8_t[]>);
+               ReceiveBuffer);
 
     void
     removeUpTo(const volumedriver::SCO);
@@ -108,7 +109,7 @@ protected:
 
     virtual void
     add_entries(std::vector<volumedriver::FailOverCacheEntry>,
-                std::unique_ptr<uint8_t[]>) = 0;
+                ReceiveBuffer) = 0;
 
     virtual void
     get_entries(const volumedriver::SCO,
@@ -15,6 +15,7 @@
 
 #include "BackendFactory.h"
 #include "FileBackend.h"
+#include "LogBackend.h"
 #include "MemoryBackend.h"
 
 namespace failovercache
@@ -43,9 +44,11 @@ maybe_make_dir(const boost::optional<fs::path>& p)
 }
 
 BackendFactory::BackendFactory(const boost::optional<fs::path>& path,
-                               const boost::optional<size_t> file_backend_buffer_size)
+                               const boost::optional<size_t> file_backend_buffer_size,
+                               const boost::optional<size_t> log_segment_size)
     : root_(maybe_make_dir(path))
     , file_backend_buffer_size_(file_backend_buffer_size)
+    , log_segment_size_(log_segment_size)
 {
     if (root_)
     {
@@ -108,7 +111,15 @@ std::unique_ptr<Backend>
 BackendFactory::make_backend(const std::string& nspace,
                              const vd::ClusterSize csize)
 {
-    if (root_)
+    if (root_ and log_segment_size_)
+    {
+        return std::make_unique<LogBackend>(*root_,
+                                            nspace,
+                                            csize,
+                                            *log_segment_size_,
+                                            file_backend_buffer_size_);
+    }
+    else if (root_)
     {
         return std::make_unique<FileBackend>(*root_,
                                              nspace,
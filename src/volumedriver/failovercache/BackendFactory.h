@@ -26,8 +26,10 @@ namespace failovercache
 class BackendFactory
 {
 public:
+    // With a log_segment_size, LogBackends are used instead of FileBackends.
     BackendFactory(const boost::optional<boost::filesystem::path>&,
-                   const boost::optional<size_t> file_backend_buffer_size);
+                   const boost::optional<size_t> file_backend_buffer_size,
+                   const boost::optional<size_t> log_segment_size = boost::none);
 
     ~BackendFactory();
 
@@ -48,6 +50,7 @@ private:
 
     const boost::optional<boost::filesystem::path> root_;
     const boost::optional<size_t> file_backend_buffer_size_;
+    const boost::optional<size_t> log_segment_size_;
 };
 
 }
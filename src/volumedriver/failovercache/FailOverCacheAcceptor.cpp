@@ -33,13 +33,27 @@ using namespace fungi;
 
 FailOverCacheAcceptor::FailOverCacheAcceptor(const boost::optional<fs::path>& path,
                                              const boost::optional<size_t> file_backend_buffer_size,
-                                             const boost::chrono::microseconds busy_loop_duration)
-    : factory_(path, file_backend_buffer_size)
+                                             const boost::chrono::microseconds busy_loop_duration,
+                                             const size_t reactor_threads,
+                                             const boost::optional<size_t> log_segment_size)
+    : factory_(path,
+               file_backend_buffer_size,
+               log_segment_size)
     , busy_loop_duration_(busy_loop_duration)
-{}
+    , receive_buffer_pool_(ReceiveBufferPool::create())
+{
+    if (reactor_threads > 0)
+    {
+        reactor_ = std::make_unique<FailOverCacheReactor>(reactor_threads);
+    }
+}
 
 FailOverCacheAcceptor::~FailOverCacheAcceptor()
 {
+    // Drops the connections served by the reactor - it must not be called with
+    // mutex_ held as the protocols deregister themselves on destruction.
+    reactor_.reset();
+
     int count = 0;
     {
         LOCK();
@@ -65,6 +79,16 @@ Protocol*
 FailOverCacheAcceptor::createProtocol(std::unique_ptr<fungi::Socket> s,
                                       fungi::SocketServer& parentServer)
 {
+    if (reactor_ and not s->isRdma())
+    {
+        // FailOverCacheProtocol::start() hands it over to the reactor.
+        return new FailOverCacheProtocol(std::move(s),
+                                         parentServer,
+                                         *this,
+                                         busy_loop_duration_,
+                                         reactor_.get());
+    }
+
     LOCK();
     protocols.push_back(new FailOverCacheProtocol(std::move(s),
                                                   parentServer,
@@ -17,7 +17,9 @@
 #define FAILOVERCACHEACCEPTOR_H
 
 #include "FailOverCacheProtocol.h"
+#include "FailOverCacheReactor.h"
 #include "BackendFactory.h"
+#include "ReceiveBufferPool.h"
 
 #include "../FailOverCacheStreamers.h"
 
@@ -45,9 +47,14 @@ class FailOverCacheAcceptor
     friend class volumedrivertest::FailOverCacheTestContext;
 
 public:
+    // reactor_threads == 0: each connection is served by a thread of its own,
+    // otherwise (TCP) connections are multiplexed over a FailOverCacheReactor
+    // with that many threads.
     FailOverCacheAcceptor(const boost::optional<boost::filesystem::path>& root,
                           const boost::optional<size_t> file_backend_buffer_size,
-                          const boost::chrono::microseconds busy_loop_duration);
+                          const boost::chrono::microseconds busy_loop_duration,
+                          const size_t reactor_threads = 0,
+                          const boost::optional<size_t> log_segment_size = boost::none);
 
     virtual ~FailOverCacheAcceptor();
 
@@ -69,6 +76,12 @@ public:
     BackendPtr
     lookup(const volumedriver::CommandData<volumedriver::Register>&);
 
+    const std::shared_ptr<ReceiveBufferPool>&
+    receive_buffer_pool() const
+    {
+        return receive_buffer_pool_;
+    }
+
     void
     removeProtocol(FailOverCacheProtocol* prot)
     {
@@ -88,6 +101,8 @@ private:
     std::list<FailOverCacheProtocol*> protocols;
     BackendFactory factory_;
     const boost::chrono::microseconds busy_loop_duration_;
+    std::shared_ptr<ReceiveBufferPool> receive_buffer_pool_;
+    std::unique_ptr<FailOverCacheReactor> reactor_;
 
     // for use by testers
     BackendPtr
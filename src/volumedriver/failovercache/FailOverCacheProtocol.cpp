@@ -15,6 +15,7 @@
 
 #include "FailOverCacheAcceptor.h"
 #include "FailOverCacheProtocol.h"
+#include "FailOverCacheReactor.h"
 #include "FailOverCacheStreamers.h"
 #include "fungilib/WrapByteArray.h"
 #include "fungilib/use_rs.h"
@@ -42,30 +43,53 @@ using namespace volumedriver;
 FailOverCacheProtocol::FailOverCacheProtocol(std::unique_ptr<fungi::Socket> sock,
                                              fungi::SocketServer& /*parentServer*/,
                                              FailOverCacheAcceptor& fact,
-                                             const boost::chrono::microseconds busy_loop_duration)
+                                             const boost::chrono::microseconds busy_loop_duration,
+                                             FailOverCacheReactor* reactor)
     : sock_(std::move(sock))
     , stream_(*sock_)
+    , thread_(nullptr)
+    , reactor_(reactor)
     , fact_(fact)
     , use_rs_(sock_->isRdma())
     , stop_(false)
     , busy_loop_duration_(busy_loop_duration)
 {
+    VERIFY(not (reactor_ and use_rs_));
+
     sock_->setNonBlocking();
-    if(pipe(pipes_) != 0)
+
+    if (reactor_)
     {
-        stream_.close();
-        throw fungi::IOException("could not not open pipe");
+        pipes_[0] = -1;
+        pipes_[1] = -1;
+
+        // A reactor thread only starts reading once (a part of) a command
+        // arrived - don't let clients that stall halfway through tie it up.
+        const boost::chrono::seconds timeout(reactor_->command_timeout());
+        sock_->setRequestTimeout(timeout.count());
     }
+    else
+    {
+        if(pipe(pipes_) != 0)
+        {
+            stream_.close();
+            throw fungi::IOException("could not not open pipe");
+        }
 
-    thread_ = new fungi::Thread(*this,
-                                true);
+        thread_ = new fungi::Thread(*this,
+                                    true);
+    }
 };
 
 FailOverCacheProtocol::~FailOverCacheProtocol()
 {
     fact_.removeProtocol(this);
-    close(pipes_[0]);
-    close(pipes_[1]);
+
+    if (not reactor_)
+    {
+        close(pipes_[0]);
+        close(pipes_[1]);
+    }
 
     // if(cache_)
     // {
@@ -75,19 +99,35 @@ FailOverCacheProtocol::~FailOverCacheProtocol()
     try
     {
         stream_.close();
-        thread_->destroy(); // Yuck: this call does a "delete this" ...
+        if (thread_)
+        {
+            thread_->destroy(); // Yuck: this call does a "delete this" ...
+        }
     }
     CATCH_STD_ALL_LOG_IGNORE("Problem shutting down the FailOverCacheProtocol");
 }
 
 void FailOverCacheProtocol::start()
 {
-    thread_->start();
+    if (reactor_)
+    {
+        // hands over ownership
+        reactor_->add(this);
+    }
+    else
+    {
+        thread_->start();
+    }
 }
 
 void FailOverCacheProtocol::stop()
 {
     stop_ = true;
+    if (reactor_)
+    {
+        return;
+    }
+
     ssize_t ret;
     ret = write(pipes_[1],"a",1);
     if(ret < 0) {
@@ -179,63 +219,7 @@ FailOverCacheProtocol::run()
                     break;
                 });
 
-            switch (com)
-            {
-            case volumedriver::Register:
-                LOG_TRACE("Executing Register");
-                register_();
-                LOG_TRACE("Finished Register");
-                break;
-
-            case volumedriver::Unregister:
-                LOG_TRACE("Executing Unregister");
-                unregister_();
-                LOG_TRACE("Finished Unregister");
-                break;
-
-            case volumedriver::AddEntries:
-                LOG_TRACE("Executing AddEntries");
-                addEntries_();
-                LOG_TRACE("Finished AddEntries");
-                break;
-            case volumedriver::GetEntries:
-                LOG_TRACE("Executing GetEntries");
-                getEntries_();
-                LOG_TRACE("Finished GetEntries");
-                break;
-            case volumedriver::Flush:
-                LOG_TRACE("Executing Flush");
-                Flush_();
-                LOG_TRACE("Finished Flush");
-                break;
-
-            case volumedriver::Clear:
-                LOG_TRACE("Executing Clear");
-                Clear_();
-                LOG_TRACE("Finished Clear");
-                break;
-
-            case volumedriver::GetSCORange:
-                LOG_TRACE("Executing GetSCORange");
-                getSCORange_();
-                LOG_TRACE("Finished GetSCORange");
-                break;
-
-            case volumedriver::GetSCO:
-                LOG_TRACE("Executing GetSCO");
-                getSCO_();
-                LOG_TRACE("Finished GetSCO");
-                break;
-            case volumedriver::RemoveUpTo:
-                LOG_TRACE("Executing RemoveUpTo");
-                removeUpTo_();
-                LOG_TRACE("Finished RemoveUpTo");
-
-                break;
-            default:
-                LOG_ERROR("DEFAULT BRANCH IN SWITCH...");
-                throw fungi :: IOException("no valid command");
-            }
+            dispatch_(com);
         }
     }
     CATCH_STD_ALL_EWHAT({
@@ -253,6 +237,127 @@ FailOverCacheProtocol::run()
     }
 }
 
+void
+FailOverCacheProtocol::dispatch_(int32_t com)
+{
+    switch (com)
+    {
+    case volumedriver::Register:
+        LOG_TRACE("Executing Register");
+        register_();
+        LOG_TRACE("Finished Register");
+        break;
+
+    case volumedriver::Unregister:
+        LOG_TRACE("Executing Unregister");
+        unregister_();
+        LOG_TRACE("Finished Unregister");
+        break;
+
+    case volumedriver::AddEntries:
+        LOG_TRACE("Executing AddEntries");
+        addEntries_();
+        LOG_TRACE("Finished AddEntries");
+        break;
+    case volumedriver::GetEntries:
+        LOG_TRACE("Executing GetEntries");
+        getEntries_();
+        LOG_TRACE("Finished GetEntries");
+        break;
+    case volumedriver::Flush:
+        LOG_TRACE("Executing Flush");
+        Flush_();
+        LOG_TRACE("Finished Flush");
+        break;
+
+    case volumedriver::Clear:
+        LOG_TRACE("Executing Clear");
+        Clear_();
+        LOG_TRACE("Finished Clear");
+        break;
+
+    case volumedriver::GetSCORange:
+        LOG_TRACE("Executing GetSCORange");
+        getSCORange_();
+        LOG_TRACE("Finished GetSCORange");
+        break;
+
+    case volumedriver::GetSCO:
+        LOG_TRACE("Executing GetSCO");
+        getSCO_();
+        LOG_TRACE("Finished GetSCO");
+        break;
+    case volumedriver::RemoveUpTo:
+        LOG_TRACE("Executing RemoveUpTo");
+        removeUpTo_();
+        LOG_TRACE("Finished RemoveUpTo");
+
+        break;
+    default:
+        LOG_ERROR("DEFAULT BRANCH IN SWITCH...");
+        throw fungi :: IOException("no valid command");
+    }
+}
+
+FailOverCacheProtocol::EventResult
+FailOverCacheProtocol::handle_event()
+{
+    VERIFY(reactor_);
+
+    int32_t com = 0;
+
+    try
+    {
+        stream_ >> fungi::IOBaseStream::cork;
+        stream_ >> com;
+    }
+    CATCH_STD_ALL_EWHAT({
+            LOG_INFO("Reading command from socket failed, dropping connection: " << EWHAT);
+            return EventResult::Drop;
+        });
+
+    switch (com)
+    {
+    case volumedriver::GetEntries:
+    case volumedriver::GetSCO:
+        // These stream back a lot of data at the pace of the client.
+        reactor_->defer(*this,
+                        com);
+        return EventResult::Deferred;
+    default:
+        return run_command_(com) ?
+            EventResult::Keep :
+            EventResult::Drop;
+    }
+}
+
+bool
+FailOverCacheProtocol::handle_deferred(int32_t com)
+{
+    VERIFY(reactor_);
+    return run_command_(com);
+}
+
+bool
+FailOverCacheProtocol::run_command_(int32_t com)
+{
+    try
+    {
+        dispatch_(com);
+    }
+    CATCH_STD_ALL_EWHAT({
+            LOG_ERROR("Exception processing command " << com << ": " << EWHAT);
+            try
+            {
+                returnNotOk();
+            }
+            CATCH_STD_ALL_LOG_IGNORE("Failed to send error reply");
+            return false;
+        });
+
+    return not stop_;
+}
+
 void
 FailOverCacheProtocol::register_()
 {
@@ -301,6 +406,7 @@ FailOverCacheProtocol::addEntries_()
     VERIFY(cache_);
 
     volumedriver::CommandData<volumedriver::AddEntries> data;
+    data.pool_ = fact_.receive_buffer_pool();
     stream_ >> data;
 
     // TODO: consider preventing empty AddEntries requests
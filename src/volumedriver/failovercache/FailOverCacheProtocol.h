@@ -28,16 +28,20 @@
 namespace failovercache
 {
 class FailOverCacheAcceptor;
+class FailOverCacheReactor;
 class Backend;
 
 class FailOverCacheProtocol
     : public fungi::Protocol
 {
 public:
+    // If a reactor is passed, the connection is served by it instead of by a
+    // thread of its own.
     FailOverCacheProtocol(std::unique_ptr<fungi::Socket>,
                           fungi::SocketServer&,
                           FailOverCacheAcceptor&,
-                          const boost::chrono::microseconds busy_loop_duration);
+                          const boost::chrono::microseconds busy_loop_duration,
+                          FailOverCacheReactor* reactor = nullptr);
 
     ~FailOverCacheProtocol();
 
@@ -50,6 +54,30 @@ public:
     void
     stop();
 
+    enum class EventResult
+    {
+        Keep,
+        Drop,
+        // handed off to the reactor's streaming threads (cf.
+        // FailOverCacheReactor::defer) which take care of the connection
+        Deferred,
+    };
+
+    // Reactor mode: processes the command the socket became readable for.
+    EventResult
+    handle_event();
+
+    // Reactor mode: runs a command deferred by handle_event.
+    // Returns false if the connection is to be dropped.
+    bool
+    handle_deferred(int32_t cmd);
+
+    int
+    fileno() const
+    {
+        return sock_->fileno();
+    }
+
     virtual const char*
     getName() const override final
     {
@@ -63,12 +91,19 @@ private:
     std::unique_ptr<fungi::Socket> sock_;
     fungi::IOBaseStream stream_;
     fungi::Thread* thread_;
+    FailOverCacheReactor* reactor_;
     FailOverCacheAcceptor& fact_;
     bool use_rs_;
     std::atomic<bool> stop_;
     int pipes_[2];
     boost::chrono::microseconds busy_loop_duration_;
 
+    void
+    dispatch_(int32_t cmd);
+
+    bool
+    run_command_(int32_t cmd);
+
     void
     addEntries_();
 
@@ -0,0 +1,378 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+#include "FailOverCacheProtocol.h"
+#include "FailOverCacheReactor.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include <boost/bind.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+#include <youtils/Assert.h>
+#include <youtils/Catchers.h>
+#include <youtils/IOException.h>
+
+namespace failovercache
+{
+
+#define LOCK()                                  \
+    boost::lock_guard<decltype(lock_)> lg__(lock_)
+
+FailOverCacheReactor::FailOverCacheReactor(size_t num_threads,
+                                           const boost::chrono::seconds command_timeout)
+    : epoll_fd_(::epoll_create1(EPOLL_CLOEXEC))
+    , event_fd_(-1)
+    , command_timeout_(command_timeout)
+    , stream_work_(std::make_unique<boost::asio::io_service::work>(stream_service_))
+{
+    VERIFY(num_threads > 0);
+
+    if (epoll_fd_ < 0)
+    {
+        const int err = errno;
+        LOG_ERROR("Failed to create epoll instance: " << strerror(err));
+        throw fungi::IOException("Failed to create epoll instance",
+                                 "",
+                                 err);
+    }
+
+    try
+    {
+        event_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (event_fd_ < 0)
+        {
+            const int err = errno;
+            LOG_ERROR("Failed to create eventfd: " << strerror(err));
+            throw fungi::IOException("Failed to create eventfd",
+                                     "",
+                                     err);
+        }
+
+        // Not one-shot: once signalled it wakes up all threads, which is
+        // exactly what we want for stopping.
+        epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.ptr = nullptr;
+
+        if (::epoll_ctl(epoll_fd_,
+                        EPOLL_CTL_ADD,
+                        event_fd_,
+                        &ev) != 0)
+        {
+            const int err = errno;
+            LOG_ERROR("Failed to add eventfd to epoll instance: " << strerror(err));
+            throw fungi::IOException("Failed to add eventfd to epoll instance",
+                                     "",
+                                     err);
+        }
+
+        for (size_t i = 0; i < num_threads; ++i)
+        {
+            stream_threads_.create_thread(boost::bind(&FailOverCacheReactor::run_stream_,
+                                                      this));
+        }
+
+        threads_.reserve(num_threads);
+        for (size_t i = 0; i < num_threads; ++i)
+        {
+            threads_.emplace_back(boost::bind(&FailOverCacheReactor::run_,
+                                              this));
+        }
+    }
+    catch (...)
+    {
+        stop_streams_();
+
+        if (event_fd_ >= 0)
+        {
+            eventfd_write(event_fd_, 1);
+        }
+
+        for (auto& t : threads_)
+        {
+            t.join();
+        }
+
+        if (event_fd_ >= 0)
+        {
+            ::close(event_fd_);
+        }
+
+        ::close(epoll_fd_);
+        throw;
+    }
+
+    LOG_INFO("Started " << num_threads << " reactor threads");
+}
+
+FailOverCacheReactor::~FailOverCacheReactor()
+{
+    try
+    {
+        int ret;
+        do
+        {
+            ret = eventfd_write(event_fd_, 1);
+        }
+        while (ret < 0 and errno == EINTR);
+
+        VERIFY(ret == 0);
+
+        {
+            // Commands in progress that are blocked on their socket need to be
+            // kicked out.
+            LOCK();
+            for (auto& p : protocols_)
+            {
+                p.second->stop();
+                ::shutdown(p.second->fileno(),
+                           SHUT_RDWR);
+            }
+        }
+
+        for (auto& t : threads_)
+        {
+            t.join();
+        }
+
+        // Deferred commands that did not start yet are dropped along with
+        // their connections.
+        stop_streams_();
+
+        LOCK();
+        LOG_INFO("Dropping " << protocols_.size() << " connections");
+        protocols_.clear();
+    }
+    CATCH_STD_ALL_LOG_IGNORE("Failed to shut down reactor");
+
+    ::close(event_fd_);
+    ::close(epoll_fd_);
+}
+
+size_t
+FailOverCacheReactor::size() const
+{
+    LOCK();
+    return protocols_.size();
+}
+
+void
+FailOverCacheReactor::arm_(FailOverCacheProtocol& prot,
+                           int op)
+{
+    epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN | EPOLLPRI | EPOLLRDHUP | EPOLLONESHOT;
+    ev.data.ptr = &prot;
+
+    if (::epoll_ctl(epoll_fd_,
+                    op,
+                    prot.fileno(),
+                    &ev) != 0)
+    {
+        const int err = errno;
+        LOG_ERROR("Failed to (re)arm connection " << prot.fileno() << ": " <<
+                  strerror(err));
+        throw fungi::IOException("Failed to (re)arm connection",
+                                 "",
+                                 err);
+    }
+}
+
+void
+FailOverCacheReactor::add(FailOverCacheProtocol* prot)
+{
+    std::unique_ptr<FailOverCacheProtocol> p(prot);
+
+    LOCK();
+
+    // Register before arming - a reactor thread might pick it up right away.
+    auto res(protocols_.emplace(prot,
+                                std::move(p)));
+    VERIFY(res.second);
+
+    try
+    {
+        arm_(*prot,
+             EPOLL_CTL_ADD);
+    }
+    catch (...)
+    {
+        protocols_.erase(res.first);
+        throw;
+    }
+}
+
+void
+FailOverCacheReactor::drop_(FailOverCacheProtocol& prot)
+{
+    // Closing the socket (in the protocol's dtor) would remove it from the
+    // epoll set as well, but only if there are no other references to the
+    // file description.
+    if (::epoll_ctl(epoll_fd_,
+                    EPOLL_CTL_DEL,
+                    prot.fileno(),
+                    nullptr) != 0)
+    {
+        LOG_WARN("Failed to remove connection " << prot.fileno() <<
+                 " from epoll instance: " << strerror(errno));
+    }
+
+    std::unique_ptr<FailOverCacheProtocol> p;
+
+    {
+        LOCK();
+        auto it = protocols_.find(&prot);
+        VERIFY(it != protocols_.end());
+        p = std::move(it->second);
+        protocols_.erase(it);
+    }
+
+    // p goes out of scope here, outside the lock.
+}
+
+void
+FailOverCacheReactor::done_(FailOverCacheProtocol& prot,
+                            bool keep)
+{
+    if (keep)
+    {
+        try
+        {
+            arm_(prot,
+                 EPOLL_CTL_MOD);
+        }
+        CATCH_STD_ALL_EWHAT({
+                LOG_ERROR("Failed to rearm connection: " << EWHAT);
+                keep = false;
+            });
+    }
+
+    if (not keep)
+    {
+        drop_(prot);
+    }
+}
+
+void
+FailOverCacheReactor::defer(FailOverCacheProtocol& prot,
+                            int32_t cmd)
+{
+    stream_service_.post([this, &prot, cmd]
+                         {
+                             done_(prot,
+                                   prot.handle_deferred(cmd));
+                         });
+}
+
+void
+FailOverCacheReactor::stop_streams_()
+{
+    stream_work_.reset();
+    stream_service_.stop();
+    stream_threads_.join_all();
+}
+
+void
+FailOverCacheReactor::run_stream_()
+{
+    while (true)
+    {
+        try
+        {
+            stream_service_.run();
+            return;
+        }
+        CATCH_STD_ALL_LOG_IGNORE("Exception in streaming thread");
+    }
+}
+
+void
+FailOverCacheReactor::run_()
+{
+    try
+    {
+        while (true)
+        {
+            // One event at a time: with one-shot events a thread would otherwise
+            // sit on connections that another, idle thread could serve.
+            epoll_event ev;
+            const int ret = ::epoll_wait(epoll_fd_,
+                                         &ev,
+                                         1,
+                                         -1);
+            if (ret < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                else
+                {
+                    const int err = errno;
+                    LOG_ERROR("epoll_wait failed: " << strerror(err));
+                    throw fungi::IOException("epoll_wait failed",
+                                             "",
+                                             err);
+                }
+            }
+            else if (ret == 0)
+            {
+                continue;
+            }
+            else if (ev.data.ptr == nullptr)
+            {
+                LOG_INFO("Stop requested");
+                break;
+            }
+
+            FailOverCacheProtocol& prot =
+                *static_cast<FailOverCacheProtocol*>(ev.data.ptr);
+
+            FailOverCacheProtocol::EventResult res =
+                FailOverCacheProtocol::EventResult::Drop;
+
+            // A hangup with pending input is still served - the command will
+            // run into the EOF and fail.
+            if (ev.events & (EPOLLIN | EPOLLPRI))
+            {
+                res = prot.handle_event();
+            }
+
+            // A deferred connection must not be touched anymore - it's up to
+            // the streaming thread now.
+            if (res != FailOverCacheProtocol::EventResult::Deferred)
+            {
+                done_(prot,
+                      res == FailOverCacheProtocol::EventResult::Keep);
+            }
+        }
+    }
+    CATCH_STD_ALL_LOG_IGNORE("Reactor thread bailing out");
+}
+
+}
+
+// Local Variables: **
+// mode: c++ **
+// End: **
@@ -0,0 +1,128 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+#ifndef FAILOVERCACHE_REACTOR_H_
+#define FAILOVERCACHE_REACTOR_H_
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/chrono.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <youtils/Logging.h>
+
+namespace failovercache
+{
+
+class FailOverCacheProtocol;
+
+// Serves the commands of many FailOverCacheProtocol connections from a small,
+// fixed set of threads instead of a thread per connection.
+// The connection sockets are registered with an epoll instance in one-shot mode:
+// whichever reactor thread picks up a readable connection processes one command
+// on it (using the regular, blocking protocol code) and then re-arms it. Hence a
+// connection is never served by two threads at the same time and idle
+// connections don't cost a thread. Clients stalling in the middle of a command
+// are dropped after command_timeout. The commands streaming data back to the
+// client (GetEntries, GetSCO) are handed off to a separate set of threads, so
+// DTL replays don't hold up the AddEntries of other connections.
+// Only for TCP - rsockets cannot be used with epoll.
+class FailOverCacheReactor
+{
+public:
+    // num_threads reactor threads and as many streaming threads.
+    explicit FailOverCacheReactor(size_t num_threads,
+                                  const boost::chrono::seconds command_timeout =
+                                  boost::chrono::seconds(30));
+
+    // Stops the threads and drops all connections.
+    ~FailOverCacheReactor();
+
+    FailOverCacheReactor(const FailOverCacheReactor&) = delete;
+
+    FailOverCacheReactor&
+    operator=(const FailOverCacheReactor&) = delete;
+
+    // Takes ownership of the protocol - it's deleted once its connection is
+    // closed or failed, or when the reactor is destroyed.
+    void
+    add(FailOverCacheProtocol*);
+
+    size_t
+    size() const;
+
+    const boost::chrono::seconds&
+    command_timeout() const
+    {
+        return command_timeout_;
+    }
+
+    // Has one of the streaming threads run the command on the (disarmed)
+    // connection, which is rearmed or dropped afterwards.
+    void
+    defer(FailOverCacheProtocol&,
+          int32_t cmd);
+
+private:
+    DECLARE_LOGGER("FailOverCacheReactor");
+
+    int epoll_fd_;
+    int event_fd_;
+
+    // protects protocols_
+    mutable boost::mutex lock_;
+    std::unordered_map<FailOverCacheProtocol*,
+                       std::unique_ptr<FailOverCacheProtocol>> protocols_;
+
+    std::vector<boost::thread> threads_;
+
+    const boost::chrono::seconds command_timeout_;
+
+    boost::asio::io_service stream_service_;
+    std::unique_ptr<boost::asio::io_service::work> stream_work_;
+    boost::thread_group stream_threads_;
+
+    void
+    run_();
+
+    void
+    run_stream_();
+
+    void
+    stop_streams_();
+
+    void
+    arm_(FailOverCacheProtocol&,
+         int op);
+
+    void
+    done_(FailOverCacheProtocol&,
+          bool keep);
+
+    void
+    drop_(FailOverCacheProtocol&);
+};
+
+}
+
+#endif // !FAILOVERCACHE_REACTOR_H_
+
+// Local Variables: **
+// mode: c++ **
+// End: **
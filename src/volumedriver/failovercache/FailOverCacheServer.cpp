@@ -33,6 +33,8 @@ FailOverCacheServer::FailOverCacheServer(const constructor_type& c)
     , transport_(vd::FailOverCacheTransport::TCP)
     , busy_loop_usecs_(0)
     , file_backend_buffer_size_(failovercache::FileBackend::default_stream_buffer_size())
+    , reactor_threads_(0)
+    , log_segment_size_(0)
     , running_(false)
 {
     logger_ = &MainHelper::getLogger__();
@@ -55,7 +57,13 @@ FailOverCacheServer::FailOverCacheServer(const constructor_type& c)
          "usecs to try a busy loop read on a socket before falling back to poll()")
         ("file-backend-buffer-size",
          po::value<size_t>(&file_backend_buffer_size_)->default_value(file_backend_buffer_size_),
-         "stream buffer size for the file backend")
+         "stream buffer size for the file backend (bytes staged before writing them out for the log structured one)")
+        ("log-segment-size",
+         po::value<size_t>(&log_segment_size_)->default_value(log_segment_size_),
+         "segment size for the log structured file backend - 0 selects the file per SCO backend")
+        ("reactor-threads",
+         po::value<size_t>(&reactor_threads_)->default_value(reactor_threads_),
+         "number of threads multiplexing the (TCP) client connections - 0 selects a thread per connection")
         ("daemonize,D",
          "run as a daemon");
 }
@@ -130,11 +138,17 @@ FailOverCacheServer::run()
               ", port: " << port_ <<
               ", transport type: " << transport_ <<
               ", busy-loop usecs: " << busy_loop_usecs_ <<
-              ", file backend stream buffer size: " << file_backend_buffer_size_);
+              ", file backend stream buffer size: " << file_backend_buffer_size_ <<
+              ", reactor threads: " << reactor_threads_ <<
+              ", log segment size: " << log_segment_size_);
 
     acceptor = std::make_unique<failovercache::FailOverCacheAcceptor>(path,
                                                                       file_backend_buffer_size_,
-                                                                      boost::chrono::microseconds(busy_loop_usecs_));
+                                                                      boost::chrono::microseconds(busy_loop_usecs_),
+                                                                      reactor_threads_,
+                                                                      log_segment_size_ ?
+                                                                      boost::make_optional(log_segment_size_) :
+                                                                      boost::none);
 
     LOG_INFO("Running the SocketServer");
 
@@ -79,6 +79,8 @@ private:
     volumedriver::FailOverCacheTransport transport_;
     unsigned busy_loop_usecs_;
     size_t file_backend_buffer_size_;
+    size_t reactor_threads_;
+    size_t log_segment_size_;
 
     bool running_;
 
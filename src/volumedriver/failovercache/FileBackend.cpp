@@ -14,11 +14,18 @@
 // but WITHOUT ANY WARRANTY of any kind.
 
 #include "FileBackend.h"
+#include "fungilib/Streamable.h"
 #include "fungilib/WrapByteArray.h"
 
+#include <limits.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+
 #include <boost/scoped_array.hpp>
 
 #include <youtils/Assert.h>
+#include <youtils/IOException.h>
 #include <youtils/ScopeExit.h>
 
 namespace failovercache
@@ -28,6 +35,96 @@ namespace fs = boost::filesystem;
 namespace vd = volumedriver;
 namespace yt = youtils;
 
+namespace
+{
+
+// Collects what an IOBaseStream writes to it - used to serialize the entry
+// headers in the on-disk format without going through the file's stream
+// buffer.
+class HeaderBuffer
+    : public fungi::Streamable
+{
+public:
+    std::vector<uint8_t> buf;
+
+    int32_t
+    read(byte*, int32_t) override final
+    {
+        VERIFY(0 == "HeaderBuffer does not support reading");
+        return 0;
+    }
+
+    int32_t
+    write(const byte* p, int32_t n) override final
+    {
+        buf.insert(buf.end(),
+                   p,
+                   p + n);
+        return n;
+    }
+
+    void setCork() override final {}
+    void clearCork() override final {}
+    void getCork() override final {}
+    void setRequestTimeout(double) override final {}
+    void close() override final {}
+    void closeNoThrow() override final {}
+
+    bool
+    isClosed() const override final
+    {
+        return false;
+    }
+};
+
+void
+writev_all(int fd,
+           std::vector<iovec>& iov,
+           const fs::path& path)
+{
+    size_t i = 0;
+
+    while (i < iov.size())
+    {
+        const int n = std::min<size_t>(iov.size() - i,
+                                       IOV_MAX);
+        const ssize_t ret = ::writev(fd,
+                                     iov.data() + i,
+                                     n);
+        if (ret < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            throw fungi::IOException("writev",
+                                     path.string().c_str(),
+                                     errno);
+        }
+
+        size_t done = ret;
+        while (done > 0)
+        {
+            VERIFY(i < iov.size());
+
+            if (done >= iov[i].iov_len)
+            {
+                done -= iov[i].iov_len;
+                ++i;
+            }
+            else
+            {
+                iov[i].iov_base = static_cast<uint8_t*>(iov[i].iov_base) + done;
+                iov[i].iov_len -= done;
+                done = 0;
+            }
+        }
+    }
+}
+
+}
+
 FileBackend::FileBackend(const fs::path& root,
                          const std::string& nspace,
                          const vd::ClusterSize cluster_size,
@@ -94,27 +191,58 @@ FileBackend::open(const vd::SCO sco)
 
 void
 FileBackend::add_entries(std::vector<vd::FailOverCacheEntry> entries,
-                         std::unique_ptr<uint8_t[]> buf)
+                         ReceiveBuffer buf)
 {
     VERIFY(file_);
 
-    if (not entries.empty())
+    if (entries.empty())
     {
-        VERIFY(buf);
+        return;
     }
 
-    for (const auto& e : entries)
+    VERIFY(buf);
+
+    // The headers are serialized into a buffer of their own and written out
+    // together with the cluster data (straight from the receive buffer) with
+    // writev, instead of copying everything through the stream buffer.
+    HeaderBuffer hdrs;
+    hdrs.buf.reserve(entries.size() * 32);
+
     {
-        const vd::ClusterLocation& loc = e.cli_;
+        fungi::IOBaseStream os(hdrs);
+        for (const auto& e : entries)
+        {
+            const vd::ClusterLocation& loc = e.cli_;
+
+            VERIFY(loc.version() == 0);
+            VERIFY(loc.cloneID() == 0);
+
+            // cf. IOBaseStream::operator<<(const ByteArray&)
+            os << loc << e.lba_ << static_cast<int64_t>(e.size_);
+        }
+    }
 
-        VERIFY(loc.version() == 0);
-        VERIFY(loc.cloneID() == 0);
+    VERIFY(hdrs.buf.size() % entries.size() == 0);
+    const size_t hdr_size = hdrs.buf.size() / entries.size();
 
-        fungi::IOBaseStream os(*file_);
-        // TODO: fix WrapByteArray or better yet get rid of it.
-        os << loc << e.lba_ << fungi::WrapByteArray(const_cast<uint8_t*>(e.buffer_),
-                                                    e.size_);
+    std::vector<iovec> iov;
+    iov.reserve(2 * entries.size());
+
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        iov.push_back(iovec{ hdrs.buf.data() + i * hdr_size,
+                             hdr_size });
+        iov.push_back(iovec{ const_cast<uint8_t*>(entries[i].buffer_),
+                             entries[i].size_ });
     }
+
+    // nothing should be buffered as all writes go through writev, but better
+    // safe than sorry
+    file_->flush();
+
+    writev_all(file_->fileno(),
+               iov,
+               make_path_(entries.front().cli_.sco()));
 }
 
 void
@@ -50,7 +50,7 @@ public:
 
     virtual void
     add_entries(std::vector<volumedriver::FailOverCacheEntry>,
-                std::unique_ptr<uint8_t[]>) override final;
+                ReceiveBuffer) override final;
 
     virtual void
     flush() override final;
@@ -0,0 +1,395 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+#include "LogBackend.h"
+
+#include <algorithm>
+#include <climits>
+
+#include <boost/lexical_cast.hpp>
+
+#include <youtils/Assert.h>
+#include <youtils/Catchers.h>
+#include <youtils/IOException.h>
+
+namespace failovercache
+{
+
+namespace fs = boost::filesystem;
+namespace vd = volumedriver;
+namespace yt = youtils;
+
+namespace
+{
+
+// Recycled segments kept around for reuse.
+const size_t max_spare_segments = 2;
+
+}
+
+LogBackend::LogBackend(const fs::path& root,
+                       const std::string& nspace,
+                       const vd::ClusterSize cluster_size,
+                       const size_t segment_size,
+                       const boost::optional<size_t> staging_buffer_size)
+    : Backend(nspace,
+              cluster_size)
+    , root_(root / nspace)
+    , segment_size_(segment_size)
+    , staging_limit_(staging_buffer_size ?
+                     *staging_buffer_size :
+                     1ULL << 20)
+    , next_segment_id_(0)
+    , staged_bytes_(0)
+{
+    LOG_INFO("creating " << root_ << ", segment size: " << segment_size_ <<
+             ", staging limit: " << staging_limit_);
+
+    if (segment_size_ < cluster_size)
+    {
+        LOG_ERROR(nspace << ": segment size " << segment_size_ <<
+                  " is smaller than the cluster size " << cluster_size);
+        throw fungi::IOException("DTL log segment size too small");
+    }
+
+    fs::create_directories(root_);
+}
+
+LogBackend::~LogBackend()
+{
+    LOG_INFO("removing " << root_);
+
+    segments_.clear();
+    spare_segments_.clear();
+
+    try
+    {
+        fs::remove_all(root_);
+    }
+    CATCH_STD_ALL_LOG_IGNORE(getNamespace() << ": failed to remove " << root_);
+}
+
+size_t
+LogBackend::default_segment_size()
+{
+    return 64ULL << 20;
+}
+
+LogBackend::Segment&
+LogBackend::segment_(uint64_t id)
+{
+    VERIFY(not segments_.empty());
+    VERIFY(id >= segments_.front().id);
+    VERIFY(id - segments_.front().id < segments_.size());
+
+    Segment& seg = segments_[id - segments_.front().id];
+    ASSERT(seg.id == id);
+    return seg;
+}
+
+void
+LogBackend::new_segment_()
+{
+    VERIFY(staged_iov_.empty());
+
+    std::unique_ptr<yt::FileDescriptor> fd;
+
+    if (not spare_segments_.empty())
+    {
+        fd = std::move(spare_segments_.back());
+        spare_segments_.pop_back();
+    }
+    else
+    {
+        const fs::path p(root_ /
+                         ("segment_" + boost::lexical_cast<std::string>(next_segment_id_)));
+        LOG_INFO(getNamespace() << ": creating " << p);
+
+        fd = std::make_unique<yt::FileDescriptor>(p,
+                                                  yt::FDMode::ReadWrite,
+                                                  CreateIfNecessary::T,
+                                                  SyncOnCloseAndDestructor::F);
+        fd->fallocate(segment_size_);
+    }
+
+    segments_.emplace_back(Segment{ next_segment_id_++,
+                                    std::move(fd),
+                                    0,
+                                    0,
+                                    false });
+}
+
+void
+LogBackend::write_staging_()
+{
+    if (not staged_iov_.empty())
+    {
+        VERIFY(not segments_.empty());
+
+        Segment& seg = segments_.back();
+        VERIFY(seg.size >= staged_bytes_);
+
+        uint64_t off = seg.size - staged_bytes_;
+        size_t i = 0;
+
+        while (i < staged_iov_.size())
+        {
+            size_t done = seg.fd->pwritev(staged_iov_.data() + i,
+                                          std::min<size_t>(staged_iov_.size() - i,
+                                                           IOV_MAX),
+                                          off);
+            off += done;
+
+            while (done > 0)
+            {
+                VERIFY(i < staged_iov_.size());
+
+                iovec& iov = staged_iov_[i];
+                if (done >= iov.iov_len)
+                {
+                    done -= iov.iov_len;
+                    ++i;
+                }
+                else
+                {
+                    iov.iov_base = static_cast<uint8_t*>(iov.iov_base) + done;
+                    iov.iov_len -= done;
+                    done = 0;
+                }
+            }
+        }
+
+        VERIFY(off == seg.size);
+
+        seg.dirty = true;
+        staged_iov_.clear();
+        staged_bufs_.clear();
+        staged_bytes_ = 0;
+    }
+}
+
+void
+LogBackend::recycle_segments_()
+{
+    // Data is removed in append order, so free segments are at the front.
+    while (not segments_.empty() and
+           segments_.front().live == 0)
+    {
+        if (segments_.size() == 1)
+        {
+            // the one we're appending to: simply start over
+            VERIFY(staged_iov_.empty());
+            segments_.front().size = 0;
+            break;
+        }
+
+        std::unique_ptr<yt::FileDescriptor> fd(std::move(segments_.front().fd));
+        segments_.pop_front();
+
+        if (spare_segments_.size() < max_spare_segments)
+        {
+            spare_segments_.emplace_back(std::move(fd));
+        }
+        else
+        {
+            const fs::path p(fd->path());
+            fd.reset();
+            LOG_INFO(getNamespace() << ": removing " << p);
+            fs::remove(p);
+        }
+    }
+}
+
+LogBackend::Index::iterator
+LogBackend::find_(const vd::SCO sco)
+{
+    return std::find_if(index_.begin(),
+                        index_.end(),
+                        [&](const Index::value_type& v)
+                        {
+                            return v.first == sco;
+                        });
+}
+
+void
+LogBackend::open(const vd::SCO sco)
+{
+    LOG_INFO(getNamespace() << ": opening " << sco);
+
+    VERIFY(find_(sco) == index_.end());
+    index_.emplace_back(sco,
+                        std::vector<Batch>());
+}
+
+void
+LogBackend::close()
+{}
+
+void
+LogBackend::flush()
+{
+    write_staging_();
+
+    for (auto& seg : segments_)
+    {
+        if (seg.dirty)
+        {
+            seg.fd->sync();
+            seg.dirty = false;
+        }
+    }
+}
+
+void
+LogBackend::add_entries(std::vector<vd::FailOverCacheEntry> entries,
+                        ReceiveBuffer buf)
+{
+    VERIFY(buf);
+    VERIFY(not index_.empty());
+
+    std::vector<Batch>& batches = index_.back().second;
+    auto it = entries.begin();
+
+    while (it != entries.end())
+    {
+        if (segments_.empty() or
+            segments_.back().size + cluster_size() > segment_size_)
+        {
+            write_staging_();
+            new_segment_();
+        }
+
+        Segment& seg = segments_.back();
+
+        // A batch that does not fit into the rest of the segment is split up.
+        const size_t room = (segment_size_ - seg.size) / cluster_size();
+        const size_t count = std::min<size_t>(room,
+                                              entries.end() - it);
+
+        Batch batch;
+        batch.segment = seg.id;
+        batch.offset = seg.size;
+        batch.entries.reserve(count);
+
+        // The entries' data is laid out back to back in the receive buffer,
+        // just like it's going to end up in the segment.
+        const uint8_t* const data = it->buffer_;
+
+        for (size_t i = 0; i < count; ++i, ++it)
+        {
+            const vd::FailOverCacheEntry& e = *it;
+
+            VERIFY(e.cli_.sco() == index_.back().first);
+            VERIFY(e.cli_.version() == 0);
+            VERIFY(e.cli_.cloneID() == 0);
+            VERIFY(e.size_ == cluster_size());
+            VERIFY(e.buffer_ == data + i * cluster_size());
+
+            batch.entries.emplace_back(e.cli_,
+                                       e.lba_);
+        }
+
+        const size_t size = count * cluster_size();
+
+        staged_iov_.push_back(iovec{ const_cast<uint8_t*>(data),
+                                     size });
+        staged_bytes_ += size;
+
+        seg.size += size;
+        ++seg.live;
+
+        batches.emplace_back(std::move(batch));
+
+        if (staged_bytes_ >= staging_limit_)
+        {
+            write_staging_();
+        }
+    }
+
+    // still referenced by the staged iovecs?
+    if (not staged_iov_.empty())
+    {
+        staged_bufs_.emplace_back(std::move(buf));
+    }
+}
+
+void
+LogBackend::remove(const vd::SCO sco)
+{
+    LOG_INFO(getNamespace() << ": removing " << sco);
+
+    auto it = find_(sco);
+    if (it == index_.end())
+    {
+        LOG_WARN(getNamespace() << ": " << sco << " not present");
+        return;
+    }
+
+    // Its data might still be staged - get it out of the way before the
+    // segment is possibly recycled.
+    write_staging_();
+
+    for (const auto& b : it->second)
+    {
+        Segment& seg = segment_(b.segment);
+        VERIFY(seg.live > 0);
+        --seg.live;
+    }
+
+    index_.erase(it);
+    recycle_segments_();
+}
+
+void
+LogBackend::get_entries(const vd::SCO sco,
+                        Backend::EntryProcessorFun& fun)
+{
+    LOG_INFO(getNamespace() << ": processing SCO " << sco);
+
+    auto it = find_(sco);
+    VERIFY(it != index_.end());
+
+    write_staging_();
+
+    std::vector<uint8_t> buf;
+
+    for (const auto& b : it->second)
+    {
+        Segment& seg = segment_(b.segment);
+
+        buf.resize(b.entries.size() * cluster_size());
+        const size_t r = seg.fd->pread(buf.data(),
+                                       buf.size(),
+                                       b.offset);
+        VERIFY(r == buf.size());
+
+        for (size_t i = 0; i < b.entries.size(); ++i)
+        {
+            LOG_DEBUG(getNamespace() << ": sending entry " << b.entries[i].first
+                      << ", lba " << b.entries[i].second);
+
+            fun(b.entries[i].first,
+                b.entries[i].second,
+                buf.data() + i * cluster_size(),
+                cluster_size());
+        }
+    }
+}
+
+}
+
+// Local Variables: **
+// mode: c++ **
+// End: **
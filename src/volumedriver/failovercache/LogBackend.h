@@ -0,0 +1,160 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+#ifndef DTL_LOG_BACKEND_H_
+#define DTL_LOG_BACKEND_H_
+
+#include "Backend.h"
+
+#include <sys/uio.h>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
+
+#include <youtils/FileDescriptor.h>
+
+namespace failovercache
+{
+
+// Log structured alternative to the FileBackend: instead of a file per SCO
+// that is written entry by entry through an IOBaseStream, the cluster data is
+// appended to preallocated, fixed size segment files. The batches added between
+// two flushes are written out straight from their receive buffers (which are
+// retained until then) with a single pwritev, followed by one fdatasync (group
+// commit). Locations and LBAs are only kept in an in-memory index - the DTL
+// directory does not survive a restart anyway.
+// Since the data is removed in SCO (i.e. append) order, segments are freed from
+// the front and recycled for later appends, so in steady state no files are
+// created, allocated or removed on the write path.
+class LogBackend
+    : public Backend
+{
+public:
+    LogBackend(const boost::filesystem::path&,
+               const std::string&,
+               const volumedriver::ClusterSize,
+               const size_t segment_size,
+               const boost::optional<size_t> staging_buffer_size);
+
+    ~LogBackend();
+
+    LogBackend(const LogBackend&) = delete;
+
+    LogBackend&
+    operator=(const LogBackend&) = delete;
+
+    virtual void
+    open(const volumedriver::SCO) override final;
+
+    virtual void
+    close() override final;
+
+    virtual void
+    add_entries(std::vector<volumedriver::FailOverCacheEntry>,
+                ReceiveBuffer) override final;
+
+    virtual void
+    flush() override final;
+
+    virtual void
+    remove(const volumedriver::SCO) override final;
+
+    virtual void
+    get_entries(const volumedriver::SCO,
+                Backend::EntryProcessorFun&) override final;
+
+    const boost::filesystem::path&
+    root() const
+    {
+        return root_;
+    }
+
+    size_t
+    segments() const
+    {
+        return segments_.size();
+    }
+
+    static size_t
+    default_segment_size();
+
+private:
+    DECLARE_LOGGER("DtlLogBackend");
+
+    struct Segment
+    {
+        uint64_t id;
+        std::unique_ptr<youtils::FileDescriptor> fd;
+        // bytes appended, including the staged ones
+        uint64_t size;
+        // batches not removed yet
+        size_t live;
+        // written to since the last sync
+        bool dirty;
+    };
+
+    struct Batch
+    {
+        uint64_t segment;
+        uint64_t offset;
+        std::vector<std::pair<volumedriver::ClusterLocation, uint64_t>> entries;
+    };
+
+    using Index = std::deque<std::pair<volumedriver::SCO, std::vector<Batch>>>;
+
+    const boost::filesystem::path root_;
+    const uint64_t segment_size_;
+    const size_t staging_limit_;
+
+    // oldest first, appends go to the last one
+    std::deque<Segment> segments_;
+    std::vector<std::unique_ptr<youtils::FileDescriptor>> spare_segments_;
+    uint64_t next_segment_id_;
+
+    Index index_;
+
+    // The tail of segments_.back() that has not been written out yet: iovecs
+    // pointing into the retained receive buffers.
+    std::vector<ReceiveBuffer> staged_bufs_;
+    std::vector<iovec> staged_iov_;
+    uint64_t staged_bytes_;
+
+    Segment&
+    segment_(uint64_t id);
+
+    void
+    new_segment_();
+
+    void
+    write_staging_();
+
+    void
+    recycle_segments_();
+
+    Index::iterator
+    find_(const volumedriver::SCO);
+};
+
+}
+
+#endif // !DTL_LOG_BACKEND_H_
+
+// Local Variables: **
+// mode: c++ **
+// End: **
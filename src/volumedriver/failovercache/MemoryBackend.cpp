@@ -45,7 +45,7 @@ MemoryBackend::close()
 
 void
 MemoryBackend::add_entries(std::vector<vd::FailOverCacheEntry> entries,
-                           std::unique_ptr<uint8_t[]> buf)
+                           ReceiveBuffer buf)
 {
     VERIFY(current_);
 
@@ -45,7 +45,7 @@ public:
 
     virtual void
     add_entries(std::vector<volumedriver::FailOverCacheEntry>,
-                std::unique_ptr<uint8_t[]>) override final;
+                ReceiveBuffer) override final;
 
     virtual void
     flush() override final;
@@ -61,7 +61,7 @@ private:
     DECLARE_LOGGER("DtlMemoryBackend");
 
     using Entry = std::pair<std::vector<volumedriver::FailOverCacheEntry>,
-                            std::unique_ptr<uint8_t[]>>;
+                            ReceiveBuffer>;
 
     using SCOEntries = std::vector<Entry>;
     using SCOEntriesPtr = std::shared_ptr<SCOEntries>;
@@ -0,0 +1,138 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+#include "ReceiveBufferPool.h"
+
+#include <algorithm>
+
+#include <boost/thread/lock_guard.hpp>
+
+#include <youtils/Assert.h>
+
+namespace failovercache
+{
+
+#define LOCK()                                  \
+    boost::lock_guard<decltype(lock_)> lg__(lock_)
+
+constexpr size_t ReceiveBufferPool::granularity_;
+
+void
+ReceiveBufferDeleter::operator()(uint8_t* p) const
+{
+    if (pool)
+    {
+        pool->release_(p,
+                       capacity);
+    }
+    else
+    {
+        delete[] p;
+    }
+}
+
+std::shared_ptr<ReceiveBufferPool>
+ReceiveBufferPool::create(size_t max_cached_bytes)
+{
+    return std::shared_ptr<ReceiveBufferPool>(new ReceiveBufferPool(max_cached_bytes));
+}
+
+ReceiveBufferPool::ReceiveBufferPool(size_t max_cached_bytes)
+    : cached_bytes_(0)
+    , max_cached_bytes_(max_cached_bytes)
+{
+    LOG_INFO("max cached bytes: " << max_cached_bytes_);
+}
+
+ReceiveBufferPool::~ReceiveBufferPool()
+{
+    for (auto& v : free_)
+    {
+        for (uint8_t* p : v.second)
+        {
+            delete[] p;
+        }
+    }
+}
+
+ReceiveBuffer
+ReceiveBufferPool::get(size_t size)
+{
+    const size_t capacity =
+        std::max<size_t>(1,
+                         (size + granularity_ - 1) / granularity_) * granularity_;
+    uint8_t* p = nullptr;
+
+    {
+        LOCK();
+        auto it = free_.find(capacity);
+        if (it != free_.end())
+        {
+            VERIFY(not it->second.empty());
+            p = it->second.back();
+            it->second.pop_back();
+            if (it->second.empty())
+            {
+                free_.erase(it);
+            }
+            cached_bytes_ -= capacity;
+        }
+    }
+
+    if (p == nullptr)
+    {
+        p = new uint8_t[capacity];
+    }
+
+    return ReceiveBuffer(p,
+                         ReceiveBufferDeleter{ shared_from_this(),
+                                               capacity });
+}
+
+ReceiveBuffer
+ReceiveBufferPool::get_unpooled(size_t size)
+{
+    return ReceiveBuffer(new uint8_t[size]);
+}
+
+size_t
+ReceiveBufferPool::cached_bytes() const
+{
+    LOCK();
+    return cached_bytes_;
+}
+
+void
+ReceiveBufferPool::release_(uint8_t* p,
+                            size_t capacity)
+{
+    {
+        LOCK();
+        if (cached_bytes_ + capacity <= max_cached_bytes_)
+        {
+            free_[capacity].push_back(p);
+            cached_bytes_ += capacity;
+            return;
+        }
+    }
+
+    delete[] p;
+}
+
+}
+
+// Local Variables: **
+// mode: c++ **
+// End: **
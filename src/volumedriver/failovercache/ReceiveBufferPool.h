@@ -0,0 +1,111 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+#ifndef DTL_RECEIVE_BUFFER_POOL_H_
+#define DTL_RECEIVE_BUFFER_POOL_H_
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
+
+#include <youtils/Logging.h>
+
+namespace failovercache
+{
+
+class ReceiveBufferPool;
+
+// Hands a buffer back to the pool it came from, or simply frees it if it
+// was not obtained from a pool.
+struct ReceiveBufferDeleter
+{
+    std::shared_ptr<ReceiveBufferPool> pool;
+    size_t capacity = 0;
+
+    void
+    operator()(uint8_t*) const;
+};
+
+// The cluster data of an AddEntries request is read from the socket into a
+// ReceiveBuffer which is then handed to the Backend.
+using ReceiveBuffer = std::unique_ptr<uint8_t[], ReceiveBufferDeleter>;
+
+// Recycles the AddEntries receive buffers to get the allocator (and the
+// zeroing done by make_unique) off the per request path. Buffer sizes are
+// rounded up to a multiple of granularity_ (the smallest cluster size), so
+// the payload of an AddEntries request - a number of clusters - fits exactly
+// and the buffers retained by the MemoryBackend (until their SCO is removed)
+// don't waste memory. The file based backends release them once written.
+// At most max_cached_bytes are kept around.
+class ReceiveBufferPool
+    : public std::enable_shared_from_this<ReceiveBufferPool>
+{
+public:
+    static std::shared_ptr<ReceiveBufferPool>
+    create(size_t max_cached_bytes = default_max_cached_bytes());
+
+    ~ReceiveBufferPool();
+
+    ReceiveBufferPool(const ReceiveBufferPool&) = delete;
+
+    ReceiveBufferPool&
+    operator=(const ReceiveBufferPool&) = delete;
+
+    // The returned buffer is not initialized.
+    ReceiveBuffer
+    get(size_t size);
+
+    // A buffer that does not come from (and does not return to) a pool.
+    static ReceiveBuffer
+    get_unpooled(size_t size);
+
+    size_t
+    cached_bytes() const;
+
+    static size_t
+    default_max_cached_bytes()
+    {
+        return 64ULL << 20;
+    }
+
+private:
+    DECLARE_LOGGER("DtlReceiveBufferPool");
+
+    friend struct ReceiveBufferDeleter;
+
+    explicit ReceiveBufferPool(size_t max_cached_bytes);
+
+    static constexpr size_t granularity_ = 4096;
+
+    mutable boost::mutex lock_;
+    // keyed by capacity
+    std::unordered_map<size_t, std::vector<uint8_t*>> free_;
+    size_t cached_bytes_;
+    const size_t max_cached_bytes_;
+
+    void
+    release_(uint8_t*,
+             size_t capacity);
+};
+
+}
+
+#endif // !DTL_RECEIVE_BUFFER_POOL_H_
+
+// Local Variables: **
+// mode: c++ **
+// End: **
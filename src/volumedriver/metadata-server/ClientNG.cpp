@@ -24,6 +24,7 @@
 #include <capnp/serialize.h>
 
 #include <youtils/Assert.h>
+#include <youtils/Catchers.h>
 #include <youtils/SourceOfUncertainty.h>
 
 namespace metadata_server
@@ -332,16 +333,166 @@ ClientNG::ClientNG(const vd::MDSNodeConfig& cfg,
               force_remote)
     , mr_(shmem_size ? new yt::SharedMemoryRegion(shmem_size) : nullptr)
     , timeout_(timeout)
+    , next_tag_(0)
 {
     LOG_INFO(this << ": " << cfg << ", shmem size " << shmem_size <<
              ", is local: " << client_.is_local() << ", timeout: " <<
              (timeout_ ? boost::lexical_cast<std::string>(timeout->count()) : "--") <<
-             " secs");
+             " secs, pipelined: " << not use_shmem_());
+
+    if (not use_shmem_())
+    {
+        client_.io_service().reset();
+        io_work_ = std::make_unique<ba::io_service::work>(client_.io_service());
+        recv_header_();
+        io_thread_ = boost::thread([this]
+                                   {
+                                       run_io_();
+                                   });
+    }
 }
 
 ClientNG::~ClientNG()
 {
     LOG_INFO(this << ": terminating");
+
+    if (io_work_)
+    {
+        io_work_.reset();
+        client_.io_service().stop();
+        io_thread_.join();
+    }
+}
+
+void
+ClientNG::run_io_()
+{
+    pthread_setname_np(pthread_self(), "mds_client_io");
+
+    while (true)
+    {
+        try
+        {
+            client_.io_service().run();
+            break;
+        }
+        CATCH_STD_ALL_EWHAT({
+                LOG_ERROR(this << ": connection error: " << EWHAT <<
+                          " - failing all outstanding requests");
+                fail_pending_(std::current_exception());
+            });
+    }
+
+    LOG_INFO(this << ": io thread exiting");
+}
+
+void
+ClientNG::fail_pending_(std::exception_ptr ep)
+{
+    boost::lock_guard<decltype(pending_lock_)> g(pending_lock_);
+
+    // keep the original cause, closing the connection on timeout leads here too
+    if (not broken_)
+    {
+        broken_ = ep;
+    }
+
+    for (auto& p : pending_)
+    {
+        p.second.set_exception(ep);
+    }
+
+    pending_.clear();
+}
+
+void
+ClientNG::send_next_()
+{
+    ASSERT(not tx_queue_.empty());
+
+    const RequestPtr& req = tx_queue_.front();
+
+    const boost::array<ba::const_buffer, 2> bufs{{
+            ba::buffer(&req->hdr,
+                       sizeof(req->hdr)),
+            ba::buffer(req->data.begin(),
+                       req->data.size() * sizeof(capnp::word))
+        }};
+
+    client_.async_send(bufs,
+                       [this]
+                       {
+                           tx_queue_.pop_front();
+                           if (not tx_queue_.empty())
+                           {
+                               send_next_();
+                           }
+                       });
+}
+
+void
+ClientNG::recv_header_()
+{
+    client_.async_recv(ba::buffer(&rx_hdr_,
+                                  sizeof(rx_hdr_)),
+                       [this]
+                       {
+                           if (rx_hdr_.magic != mdsproto::magic)
+                           {
+                               LOG_ERROR("Response lacks our protocol magic, giving up");
+                               throw mdsproto::NoMagicException("no magic key in received header");
+                           }
+
+                           if (rx_hdr_.size)
+                           {
+                               THROW_WHEN(rx_hdr_.flags bitand
+                                          mdsproto::ResponseHeader::Flags::UseShmem);
+                               recv_data_();
+                           }
+                           else
+                           {
+                               complete_(Response{rx_hdr_, {}});
+                               recv_header_();
+                           }
+                       });
+}
+
+void
+ClientNG::recv_data_()
+{
+    auto rsp(std::make_shared<Response>());
+    rsp->hdr = rx_hdr_;
+    // capnp::word is not copyable, hence no resize()
+    rsp->data = std::vector<capnp::word>(rx_hdr_.size / sizeof(capnp::word));
+
+    client_.async_recv(ba::buffer(rsp->data),
+                       [rsp, this]
+                       {
+                           complete_(std::move(*rsp));
+                           recv_header_();
+                       });
+}
+
+void
+ClientNG::complete_(Response&& rsp)
+{
+    boost::lock_guard<decltype(pending_lock_)> g(pending_lock_);
+
+    ++in_counters_.messages;
+    in_counters_.data_bytes += rsp.hdr.size;
+    in_counters_.data_bytes_sqsum += rsp.hdr.size * rsp.hdr.size;
+
+    auto it = pending_.find(static_cast<uint64_t>(rsp.hdr.tag));
+    if (it == pending_.end())
+    {
+        LOG_WARN(this << ": no pending request for tag " << rsp.hdr.tag <<
+                 " (timed out?) - dropping response");
+    }
+    else
+    {
+        it->second.set_value(std::move(rsp));
+        pending_.erase(it);
+    }
 }
 
 TableInterfacePtr
@@ -557,6 +708,13 @@ void
 ClientNG::interact_(Build&& build,
                     Read&& read)
 {
+    if (not use_shmem_())
+    {
+        interact_pipelined_<T>(std::move(build),
+                               std::move(read));
+        return;
+    }
+
     boost::lock_guard<decltype(lock_)> g(lock_);
 
     const mdsproto::Tag txtag(reinterpret_cast<uint64_t>(this));
@@ -591,6 +749,98 @@ ClientNG::interact_(Build&& build,
              std::move(read));
 }
 
+template<enum mdsproto::RequestHeader::Type T,
+         typename Build,
+         typename Read>
+void
+ClientNG::interact_pipelined_(Build&& build,
+                              Read&& read)
+{
+    using Traits = mdsproto::RequestTraits<T>;
+
+    const mdsproto::Tag tag(++next_tag_);
+
+    auto req(std::make_shared<Request>());
+
+    {
+        capnp::MallocMessageBuilder builder;
+        auto root(builder.initRoot<typename Traits::Params>());
+
+        build(root);
+
+        req->data = capnp::messageToFlatArray(builder);
+        req->hdr = mdsproto::RequestHeader(Traits::request_type,
+                                           req->data.size() * sizeof(capnp::word),
+                                           tag);
+    }
+
+    std::future<Response> future;
+
+    {
+        boost::lock_guard<decltype(pending_lock_)> g(pending_lock_);
+
+        if (broken_)
+        {
+            std::rethrow_exception(broken_);
+        }
+
+        std::promise<Response> promise;
+        future = promise.get_future();
+        pending_.emplace(static_cast<uint64_t>(tag),
+                         std::move(promise));
+
+        ++out_counters_.messages;
+        out_counters_.data_bytes += req->hdr.size;
+        out_counters_.data_bytes_sqsum += req->hdr.size * req->hdr.size;
+    }
+
+    client_.io_service().post([req, this]
+                              {
+                                  tx_queue_.push_back(req);
+                                  if (tx_queue_.size() == 1)
+                                  {
+                                      send_next_();
+                                  }
+                              });
+
+    if (timeout_ and
+        future.wait_for(*timeout_) != std::future_status::ready)
+    {
+        bool timed_out;
+
+        {
+            boost::lock_guard<decltype(pending_lock_)> g(pending_lock_);
+            // the response might have arrived in the meantime
+            timed_out = pending_.find(static_cast<uint64_t>(tag)) != pending_.end();
+        }
+
+        if (timed_out)
+        {
+            // The server or the connection is stuck: fail all outstanding
+            // requests (incl. ours) right away instead of having each of them
+            // wait for its timeout, and close the connection. Further requests
+            // fail too as the client is marked broken, which gets the
+            // MDS failover going.
+            LOG_ERROR(this << ": timeout waiting for response to " <<
+                      Traits::request_type << ", tag " << tag <<
+                      " - closing the connection");
+            fail_pending_(std::make_exception_ptr(fungi::IOException("timeout waiting for MDS response")));
+            client_.async_close();
+        }
+    }
+
+    Response rsp(future.get());
+
+    if (rsp.hdr.size)
+    {
+        capnp::FlatArrayMessageReader reader(kj::arrayPtr(rsp.data.data(),
+                                                          rsp.data.size()));
+        handle_response_<T>(rsp.hdr,
+                            reader,
+                            std::move(read));
+    }
+}
+
 template<enum mdsproto::RequestHeader::Type T,
          typename Read>
 void
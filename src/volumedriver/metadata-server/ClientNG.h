@@ -19,12 +19,19 @@
 #include "Interface.h"
 #include "Protocol.h"
 
+#include <atomic>
 #include <chrono>
+#include <deque>
+#include <exception>
+#include <future>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include <boost/thread.hpp>
 
 #include <capnp/message.h>
+#include <capnp/serialize.h>
 
 #include <youtils/LocORemClient.h>
 #include <youtils/SharedMemoryRegion.h>
@@ -111,11 +118,45 @@ private:
 
     friend class TableHandle;
 
+    // Local clients using shared memory have a single request in flight, serialized
+    // by lock_, as the shmem region is used for both request and response.
+    // All others pipeline their requests: any number of callers can have one
+    // outstanding, the responses (which the server is free to send in any order)
+    // are matched by their Tag by the receiver thread and handed to the waiting
+    // callers via futures.
     boost::mutex lock_;
     youtils::LocORemClient client_;
     std::unique_ptr<youtils::SharedMemoryRegion> mr_;
     const boost::optional<std::chrono::seconds> timeout_;
 
+    struct Request
+    {
+        metadata_server_protocol::RequestHeader hdr;
+        kj::Array<capnp::word> data;
+    };
+
+    using RequestPtr = std::shared_ptr<Request>;
+
+    struct Response
+    {
+        metadata_server_protocol::ResponseHeader hdr;
+        std::vector<capnp::word> data;
+    };
+
+    std::atomic<uint64_t> next_tag_;
+
+    // protects pending_, broken_ and the counters in pipelined mode.
+    boost::mutex pending_lock_;
+    std::unordered_map<uint64_t, std::promise<Response>> pending_;
+    std::exception_ptr broken_;
+
+    // only accessed from the io thread
+    std::deque<RequestPtr> tx_queue_;
+    metadata_server_protocol::ResponseHeader rx_hdr_;
+
+    std::unique_ptr<boost::asio::io_service::work> io_work_;
+    boost::thread io_thread_;
+
     OutCounters out_counters_;
     InCounters in_counters_;
 
@@ -143,6 +184,13 @@ private:
     interact_(Build&&,
               Read&&);
 
+    template<enum metadata_server_protocol::RequestHeader::Type r,
+             typename Build,
+             typename Read>
+    void
+    interact_pipelined_(Build&&,
+                        Read&&);
+
     template<enum metadata_server_protocol::RequestHeader::Type r,
              typename Read>
     void
@@ -165,6 +213,24 @@ private:
     {
         return mr_ != nullptr and is_local();
     }
+
+    void
+    run_io_();
+
+    void
+    send_next_();
+
+    void
+    recv_header_();
+
+    void
+    recv_data_();
+
+    void
+    complete_(Response&&);
+
+    void
+    fail_pending_(std::exception_ptr);
 };
 
 }
@@ -17,6 +17,7 @@
 #include "ServerNG.h"
 #include "Utils.h"
 
+#include <deque>
 #include <map>
 
 #include <capnp/message.h>
@@ -57,8 +58,27 @@ struct ServerNG::ConnectionState
 
         return it->second;
     }
+
+    // queue of responses to pipelined requests, written out one at a time
+    struct TxMessage
+    {
+        std::shared_ptr<const mdsproto::ResponseHeader> hdr;
+        std::shared_ptr<kj::Array<capnp::word>> data;
+    };
+
+    boost::mutex tx_lock;
+    std::deque<TxMessage> tx_queue;
+    bool tx_busy = false;
 };
 
+bool
+ServerNG::pipelined_(const mdsproto::RequestHeader& hdr)
+{
+    return
+        hdr.in_region == yt::SharedMemoryRegionId(0) and
+        hdr.out_region == yt::SharedMemoryRegionId(0);
+}
+
 ServerNG::ServerNG(DataBaseInterfacePtr db,
                    const std::string& addr,
                    const uint16_t port,
@@ -251,6 +271,12 @@ ServerNG::recv_data_(const std::shared_ptr<C>& conn,
                                           vec.size() / sizeof(capnp::word)));
                  auto reader(std::make_shared<capnp::FlatArrayMessageReader>(rxdata));
 
+                 if (pipelined_(*hdr))
+                 {
+                     recv_header_(c,
+                                  state);
+                 }
+
                  dispatch_(c,
                            state,
                            hdr,
@@ -312,7 +338,7 @@ ServerNG::dispatch_(const std::shared_ptr<C>& conn,
     error_(conn,
            state,
            mdsproto::ResponseHeader::Type::UnknownRequest,
-           hdr->tag,
+           hdr,
            "unknown request");
 }
 
@@ -539,7 +565,7 @@ ServerNG::do_handle_(const std::shared_ptr<C>& conn,
     send_response_(conn,
                    state,
                    rsp,
-                   hdr->tag,
+                   hdr,
                    builder);
 }
 
@@ -548,10 +574,10 @@ void
 ServerNG::error_(const std::shared_ptr<C>& conn,
                  ConnectionStatePtr state,
                  mdsproto::ResponseHeader::Type rsp,
-                 mdsproto::Tag tag,
+                 const HeaderPtr& req,
                  const std::string& msg)
 {
-    LOG_TRACE(&conn << ": error " << rsp << ", req tag " << tag << ", msg " << msg);
+    LOG_TRACE(&conn << ": error " << rsp << ", req tag " << req->tag << ", msg " << msg);
 
     auto builder(std::make_shared<capnp::MallocMessageBuilder>());
     auto txroot(builder->initRoot<typename mdsproto::Error>());
@@ -561,7 +587,7 @@ ServerNG::error_(const std::shared_ptr<C>& conn,
     send_response_(conn,
                    state,
                    rsp,
-                   tag,
+                   req,
                    builder);
 }
 
@@ -570,7 +596,7 @@ void
 ServerNG::send_response_(const std::shared_ptr<C>& conn,
                          ConnectionStatePtr state,
                          mdsproto::ResponseHeader::Type rsp,
-                         mdsproto::Tag tag,
+                         const HeaderPtr& req,
                          const MessageBuilderPtr& builder)
 {
     auto fb_builder = std::dynamic_pointer_cast<capnp::FlatMessageBuilder>(builder);
@@ -579,7 +605,7 @@ ServerNG::send_response_(const std::shared_ptr<C>& conn,
         send_response_shmem_(conn,
                              state,
                              rsp,
-                             tag,
+                             req->tag,
                              fb_builder);
     }
     else
@@ -587,7 +613,7 @@ ServerNG::send_response_(const std::shared_ptr<C>& conn,
         send_response_inband_(conn,
                               state,
                               rsp,
-                              tag,
+                              req,
                               builder);
     }
 }
@@ -633,7 +659,7 @@ void
 ServerNG::send_response_inband_(const std::shared_ptr<C>& conn,
                                 ConnectionStatePtr state,
                                 mdsproto::ResponseHeader::Type rsp,
-                                mdsproto::Tag tag,
+                                const HeaderPtr& req,
                                 const MessageBuilderPtr& builder)
 {
     // LOG_TRACE(&conn << ": scheduling task to send response");
@@ -643,7 +669,35 @@ ServerNG::send_response_inband_(const std::shared_ptr<C>& conn,
     auto hdr(std::make_shared<const mdsproto::ResponseHeader>(rsp,
                                                               data->size() *
                                                               sizeof(capnp::word),
-                                                              tag));
+                                                              req->tag));
+
+    if (pipelined_(*req))
+    {
+        // The next request header is already being read. Responses can be
+        // produced concurrently by the io and the delayed work threads, so they're
+        // queued up and written from within the connection's strand.
+        bool start = false;
+
+        {
+            boost::lock_guard<decltype(state->tx_lock)> g(state->tx_lock);
+            state->tx_queue.push_back(ConnectionState::TxMessage{ hdr,
+                                                                  data });
+            start = not state->tx_busy;
+            state->tx_busy = true;
+        }
+
+        if (start)
+        {
+            conn->async_work([state,
+                              this](const std::shared_ptr<C>& c)
+                             {
+                                 send_next_(c,
+                                            state);
+                             });
+        }
+
+        return;
+    }
 
     const boost::array<ba::const_buffer, 2> bufs{{
             ba::buffer(&(*hdr),
@@ -670,6 +724,46 @@ ServerNG::send_response_inband_(const std::shared_ptr<C>& conn,
                       timeout_);
 }
 
+template<typename C>
+void
+ServerNG::send_next_(const std::shared_ptr<C>& conn,
+                     ConnectionStatePtr state)
+{
+    ConnectionState::TxMessage msg;
+
+    {
+        boost::lock_guard<decltype(state->tx_lock)> g(state->tx_lock);
+        if (state->tx_queue.empty())
+        {
+            state->tx_busy = false;
+            return;
+        }
+
+        msg = std::move(state->tx_queue.front());
+        state->tx_queue.pop_front();
+    }
+
+    const boost::array<ba::const_buffer, 2> bufs{{
+            ba::buffer(&(*msg.hdr),
+                       sizeof(*msg.hdr)),
+                ba::buffer(msg.data->begin(),
+                           msg.data->size() * sizeof(capnp::word))
+                }};
+
+    auto fun([msg,
+              state,
+              this](const std::shared_ptr<C>& c)
+             {
+                 // LOG_TRACE(&c << ": " << msg.hdr->tag << " send completion");
+                 send_next_(c,
+                            state);
+             });
+
+    conn->async_write(bufs,
+                      std::move(fun),
+                      timeout_);
+}
+
 void
 ServerNG::open_(mdsproto::Methods::OpenParams::Reader& reader,
                 mdsproto::Methods::OpenResults::Builder&)
@@ -95,6 +95,13 @@ private:
 
     using DataSourcePtr = std::shared_ptr<DataSource>;
 
+    // Requests that neither carry their data in nor want their response via
+    // shared memory don't tie up the connection: the next request is read
+    // while they're being processed and the responses are queued up, potentially
+    // out of order.
+    static bool
+    pipelined_(const metadata_server_protocol::RequestHeader&);
+
     template<typename Connection>
     void
     get_data_(const std::shared_ptr<Connection>&,
@@ -120,7 +127,7 @@ private:
     send_response_(const std::shared_ptr<Connection>&,
                    ConnectionStatePtr,
                    metadata_server_protocol::ResponseHeader::Type,
-                   metadata_server_protocol::Tag,
+                   const HeaderPtr&,
                    const MessageBuilderPtr&);
 
     template<typename Connection>
@@ -128,9 +135,14 @@ private:
     send_response_inband_(const std::shared_ptr<Connection>&,
                           ConnectionStatePtr,
                           metadata_server_protocol::ResponseHeader::Type,
-                          metadata_server_protocol::Tag,
+                          const HeaderPtr&,
                           const MessageBuilderPtr&);
 
+    template<typename Connection>
+    void
+    send_next_(const std::shared_ptr<Connection>&,
+               ConnectionStatePtr);
+
     template<typename Connection>
     void
     send_response_shmem_(const std::shared_ptr<Connection>&,
@@ -144,7 +156,7 @@ private:
     error_(const std::shared_ptr<Connection>&,
            ConnectionStatePtr,
            const metadata_server_protocol::ResponseHeader::Type,
-           const metadata_server_protocol::Tag,
+           const HeaderPtr&,
            const std::string&);
 
     template<enum metadata_server_protocol::RequestHeader::Type r,
@@ -219,7 +219,7 @@ Table::apply_relocations(const vd::ScrubId& scrub_id,
                 vd::RelocationReaderFactory factory(relocs,
                                                     scratch_dir_,
                                                     get_nsid_map_().get(cid)->clone(),
-                                                    vd::CombinedTLogReader::FetchStrategy::Concurrent);
+                                                    vd::CombinedTLogReader::FetchStrategy::Parallel);
                 mdstore->applyRelocs(factory,
                                      cid,
                                      scrub_id);
@@ -46,6 +46,7 @@ class Main
         scrubbing::ScrubberAdapter::region_size_exponent_default;
     float fill_ratio_ = scrubbing::ScrubberAdapter::fill_ratio_default;
     bool verbose_ = scrubbing::ScrubberAdapter::verbose_scrubbing_default;
+    uint32_t num_threads_ = scrubbing::ScrubberAdapter::num_threads_default;
 
 public:
     Main(int argc,
@@ -70,6 +71,9 @@ public:
             ("verbose",
              po::value<bool>(&verbose_)->default_value(verbose_),
              "verbose logging during scrubbing")
+            ("threads",
+             po::value<uint32_t>(&num_threads_)->default_value(num_threads_),
+             "number of regions that are metadata scrubbed concurrently")
              ;
     }
 
@@ -131,7 +135,8 @@ public:
                                                       region_size_exponent_,
                                                       fill_ratio_,
                                                       false,
-                                                      verbose_));
+                                                      verbose_,
+                                                      num_threads_));
 
         std::cout << reply.str() << std::endl;
 
@@ -0,0 +1,217 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+#include "VolumeDriverTestConfig.h"
+
+#include <atomic>
+#include <map>
+
+#include <volumedriver/BackupSCOReadCache.h>
+
+namespace volumedrivertest
+{
+
+using namespace volumedriver;
+using namespace volumedriver_backup;
+
+class BackupSCOReadCacheTest
+    : public testing::TestWithParam<VolumeDriverTestConfig>
+{
+protected:
+    using Key = BackupSCOReadCache::Key;
+    using Data = BackupSCOReadCache::Data;
+
+    static Key
+    key(SCONumber num)
+    {
+        return Key(SCOCloneID(0),
+                   SCO(num,
+                       SCOCloneID(0),
+                       SCOVersion(0)));
+    }
+
+    // The data of a SCO is its number, so a test can check it got the right one.
+    BackupSCOReadCache::ReadFun
+    reader(const Key& k)
+    {
+        return [this, num = k.second.number()]() -> Data
+        {
+            ++reads_;
+            ++reads_per_sco_.at(num);
+            return std::make_shared<std::vector<byte>>(1,
+                                                       static_cast<byte>(num));
+        };
+    }
+
+    // Same access pattern as Backup::replay_tlogs_on_target.
+    void
+    replay(BackupSCOReadCache& cache,
+           const std::vector<SCONumber>& scos,
+           size_t read_ahead)
+    {
+        for (size_t j = 0; j < std::min(read_ahead, scos.size()); ++j)
+        {
+            cache.prefetch(key(scos[j]),
+                           reader(key(scos[j])));
+        }
+
+        for (size_t j = 0; j < scos.size(); ++j)
+        {
+            if (j + read_ahead < scos.size())
+            {
+                cache.prefetch(key(scos[j + read_ahead]),
+                               reader(key(scos[j + read_ahead])));
+            }
+
+            const Data d(cache.get(key(scos[j]),
+                                   reader(key(scos[j]))));
+            ASSERT_EQ(1U, d->size());
+            EXPECT_EQ(static_cast<byte>(scos[j]), d->front());
+        }
+    }
+
+    // prefetched reads might still be running: only check these after a get
+    std::atomic<size_t> reads_{0};
+    // filled in upfront by the tests; the readers only look up existing entries
+    std::map<SCONumber, std::atomic<size_t>> reads_per_sco_;
+};
+
+TEST_F(BackupSCOReadCacheTest, read_ahead_reads_every_sco_once)
+{
+    const size_t read_ahead = 4;
+    const size_t capacity = 8;
+    const SCONumber num_scos = 32;
+
+    std::vector<SCONumber> scos;
+    for (SCONumber i = 1; i <= num_scos; ++i)
+    {
+        scos.push_back(i);
+        reads_per_sco_[i] = 0;
+    }
+
+    BackupSCOReadCache cache(capacity);
+    replay(cache,
+           scos,
+           read_ahead);
+
+    EXPECT_EQ(num_scos, reads_.load());
+    for (const auto& p : reads_per_sco_)
+    {
+        EXPECT_EQ(1U, p.second.load()) << "SCO " << p.first;
+    }
+
+    EXPECT_GE(capacity, cache.size());
+}
+
+TEST_F(BackupSCOReadCacheTest, consumed_scos_are_dropped_first)
+{
+    for (SCONumber i = 1; i <= 4; ++i)
+    {
+        reads_per_sco_[i] = 0;
+    }
+
+    BackupSCOReadCache cache(2);
+
+    cache.get(key(1),
+              reader(key(1)));
+    cache.prefetch(key(2),
+                   reader(key(2)));
+    // SCO 1 was gotten already and makes room, SCO 2 stays
+    cache.prefetch(key(3),
+                   reader(key(3)));
+
+    cache.get(key(2),
+              reader(key(2)));
+    cache.get(key(3),
+              reader(key(3)));
+
+    EXPECT_EQ(3U, reads_.load());
+
+    // only consumed ones left: the least recently gotten (2) is dropped
+    cache.prefetch(key(4),
+                   reader(key(4)));
+    cache.get(key(3),
+              reader(key(3)));
+    cache.get(key(4),
+              reader(key(4)));
+
+    EXPECT_EQ(4U, reads_.load());
+    EXPECT_EQ(1U, reads_per_sco_[3].load());
+    EXPECT_EQ(2U, cache.size());
+}
+
+TEST_F(BackupSCOReadCacheTest, prefetch_protects_consumed_sco)
+{
+    for (SCONumber i = 1; i <= 3; ++i)
+    {
+        reads_per_sco_[i] = 0;
+    }
+
+    BackupSCOReadCache cache(2);
+
+    cache.get(key(1),
+              reader(key(1)));
+    cache.get(key(2),
+              reader(key(2)));
+
+    // e.g. the next TLog refers to SCO 1 again
+    cache.prefetch(key(1),
+                   reader(key(1)));
+    cache.prefetch(key(3),
+                   reader(key(3)));
+
+    cache.get(key(1),
+              reader(key(1)));
+    cache.get(key(3),
+              reader(key(3)));
+
+    EXPECT_EQ(3U, reads_.load());
+    EXPECT_EQ(1U, reads_per_sco_[1].load());
+}
+
+TEST_F(BackupSCOReadCacheTest, unconsumed_oldest_dropped_if_no_choice)
+{
+    for (SCONumber i = 1; i <= 3; ++i)
+    {
+        reads_per_sco_[i] = 0;
+    }
+
+    BackupSCOReadCache cache(2);
+
+    for (SCONumber i = 1; i <= 3; ++i)
+    {
+        cache.prefetch(key(i),
+                       reader(key(i)));
+    }
+
+    EXPECT_EQ(2U, cache.size());
+
+    cache.get(key(2),
+              reader(key(2)));
+    cache.get(key(3),
+              reader(key(3)));
+    EXPECT_EQ(3U, reads_.load());
+
+    cache.get(key(1),
+              reader(key(1)));
+    EXPECT_EQ(4U, reads_.load());
+    EXPECT_EQ(2U, reads_per_sco_[1].load());
+}
+
+}
+
+// Local Variables: **
+// mode: c++ **
+// End: **
@@ -0,0 +1,119 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+#include "../CachePageIndex.h"
+
+#include <map>
+
+#include <gtest/gtest.h>
+
+#include <youtils/SourceOfUncertainty.h>
+
+namespace volumedrivertest
+{
+
+using namespace volumedriver;
+namespace yt = youtils;
+
+class CachePageIndexTest
+    : public testing::Test
+{
+protected:
+    // not odr-using CachePageIndex::npos in the EXPECT_* macros
+    const CachePageIndex::Slot npos = CachePageIndex::npos;
+};
+
+TEST_F(CachePageIndexTest, empty)
+{
+    CachePageIndex idx(0);
+    EXPECT_EQ(0U, idx.size());
+    EXPECT_EQ(npos, idx.find(0));
+    EXPECT_FALSE(idx.erase(0));
+}
+
+TEST_F(CachePageIndexTest, single_slot)
+{
+    CachePageIndex idx(1);
+
+    idx.insert(42, 0);
+    EXPECT_EQ(1U, idx.size());
+    EXPECT_EQ(0U, idx.find(42));
+    EXPECT_EQ(npos, idx.find(43));
+
+    EXPECT_TRUE(idx.erase(42));
+    EXPECT_EQ(0U, idx.size());
+    EXPECT_EQ(npos, idx.find(42));
+
+    idx.insert(43, 0);
+    EXPECT_EQ(0U, idx.find(43));
+}
+
+TEST_F(CachePageIndexTest, random)
+{
+    const size_t capacity = 4096;
+    CachePageIndex idx(capacity);
+
+    yt::SourceOfUncertainty sou;
+
+    // PageAddress -> slot
+    std::map<PageAddress, CachePageIndex::Slot> ref;
+    std::vector<CachePageIndex::Slot> free_slots;
+
+    for (size_t i = 0; i < capacity; ++i)
+    {
+        free_slots.push_back(i);
+    }
+
+    for (size_t i = 0; i < 64 * capacity; ++i)
+    {
+        // a small key space to get plenty of collisions and erasures of
+        // present keys
+        const PageAddress pa = sou(static_cast<PageAddress>(4 * capacity));
+        auto it = ref.find(pa);
+
+        if (it != ref.end())
+        {
+            ASSERT_EQ(it->second, idx.find(pa));
+            ASSERT_TRUE(idx.erase(pa));
+            free_slots.push_back(it->second);
+            ref.erase(it);
+        }
+        else if (not free_slots.empty())
+        {
+            ASSERT_EQ(npos, idx.find(pa));
+            const CachePageIndex::Slot slot = free_slots.back();
+            free_slots.pop_back();
+            idx.insert(pa, slot);
+            ref[pa] = slot;
+        }
+
+        ASSERT_EQ(ref.size(), idx.size());
+    }
+
+    for (const auto& p : ref)
+    {
+        ASSERT_EQ(p.second, idx.find(p.first));
+    }
+
+    idx.clear();
+    EXPECT_EQ(0U, idx.size());
+
+    for (const auto& p : ref)
+    {
+        EXPECT_EQ(npos, idx.find(p.first));
+    }
+}
+
+}
@@ -78,6 +78,14 @@ public:
         return cluster_size_;
     }
 
+    ssize_t
+    read(const struct iovec* /*iov*/,
+         int iovcnt,
+         uint32_t /*offset*/)
+    {
+        return iovcnt * cluster_size_;
+    }
+
     void
     check(const yt::Weed&,
          uint32_t)
@@ -91,6 +99,14 @@ public:
         return cluster_size_;
     }
 
+    ssize_t
+    write(const struct iovec* /*iov*/,
+          int iovcnt,
+          uint32_t /*entry*/)
+    {
+        return iovcnt * cluster_size_;
+    }
+
 
     uint64_t
     total_size() const
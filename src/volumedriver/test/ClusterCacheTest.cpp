@@ -1735,6 +1735,118 @@ TEST_P(ClusterCacheTest, make_limited_namespace_unlimited)
                 Entries(new_count));
 }
 
+TEST_P(ClusterCacheTest, hits_get_a_second_chance)
+{
+    const auto wrns(make_random_namespace());
+    SharedVolumePtr v = newVolume(*wrns);
+
+    v->set_cluster_cache_behaviour(ClusterCacheBehaviour::CacheOnWrite);
+    v->set_cluster_cache_mode(ClusterCacheMode::LocationBased);
+
+    auto& cc = VolManager::get()->getClusterCache();
+
+    const ClusterCacheHandle handle(v->getClusterCacheHandle());
+    const size_t count = 4;
+    cc.set_max_entries(handle,
+                       count);
+
+    const std::string s("Tied a piece of string to the end of his stick");
+    writeClusters(*v,
+                  count,
+                  s);
+
+    // cluster 0 is the least recently added one but was hit since, so cluster 1
+    // is to be evicted by the next addition
+    checkClusters(*v,
+                  0,
+                  1,
+                  s);
+
+    CHECK_STATS(Devices(2),
+                Hits(1),
+                Misses(0),
+                Entries(count));
+
+    {
+        std::stringstream ss;
+        ss << s << count;
+        writeToVolume(*v,
+                      count * v->getClusterMultiplier(),
+                      v->getClusterSize(),
+                      ss.str());
+    }
+
+    CHECK_STATS(Devices(2),
+                Hits(1),
+                Misses(0),
+                Entries(count));
+
+    checkClusters(*v,
+                  0,
+                  1,
+                  s);
+
+    CHECK_STATS(Devices(2),
+                Hits(2),
+                Misses(0),
+                Entries(count));
+
+    checkClusters(*v,
+                  1,
+                  1,
+                  s);
+
+    CHECK_STATS(Devices(2),
+                Hits(2),
+                Misses(1),
+                Entries(count));
+}
+
+TEST_P(ClusterCacheTest, multi_cluster_requests)
+{
+    const auto wrns(make_random_namespace());
+    SharedVolumePtr v = newVolume(*wrns);
+
+    v->set_cluster_cache_behaviour(ClusterCacheBehaviour::CacheOnRead);
+    v->set_cluster_cache_mode(ClusterCacheMode::LocationBased);
+
+    const size_t count = 32;
+    const size_t size = count * v->getClusterSize();
+    const std::string s("He said: \"Darling, I'm sorry but I've got to go away\"");
+
+    writeToVolume(*v,
+                  0,
+                  size,
+                  s);
+
+    CHECK_STATS(Devices(2),
+                Hits(0),
+                Misses(0),
+                Entries(0));
+
+    // the misses of a multi cluster read are added in one go ...
+    checkVolume(*v,
+                0,
+                size,
+                s);
+
+    CHECK_STATS(Devices(2),
+                Hits(0),
+                Misses(count),
+                Entries(count));
+
+    // ... and looked up in one go
+    checkVolume(*v,
+                0,
+                size,
+                s);
+
+    CHECK_STATS(Devices(2),
+                Hits(count),
+                Misses(count),
+                Entries(count));
+}
+
 TEST_P(ClusterCacheTest, tiny_location_based)
 {
     const auto wrns(make_random_namespace());
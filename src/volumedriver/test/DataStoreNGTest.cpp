@@ -765,6 +765,58 @@ TEST_P(DataStoreNGTest, writeClusterToLocation)
     }
 }
 
+TEST_P(DataStoreNGTest, writeClustersToLocation)
+{
+    ClusterLocation loc;
+    const uint32_t pattern = 0xabcd;
+
+    writeClusters(1, pattern, &loc);
+
+    const size_t count = 7;
+    const size_t csize = vol_->getClusterSize();
+
+    std::vector<byte> buf(count * csize);
+    for (size_t i = 0; i < count; ++i)
+    {
+        memset(&buf[i * csize], i + 1, csize);
+    }
+
+    const ClusterLocation loc2(loc.number(),
+                               loc.offset() + 1,
+                               loc.cloneID());
+    uint32_t throttle;
+
+    EXPECT_THROW(dStore_->writeClustersToLocation(&buf[0],
+                                                  loc,
+                                                  count,
+                                                  throttle),
+                 std::exception) <<
+        "overwriting an existing location must fail";
+
+    dStore_->writeClustersToLocation(&buf[0],
+                                     loc2,
+                                     count,
+                                     throttle);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const ClusterLocation l(loc2.number(),
+                                loc2.offset() + i,
+                                loc2.cloneID());
+        std::vector<byte> rbuf(csize);
+        readCluster(&rbuf[0], l, 0);
+        EXPECT_EQ(0, memcmp(&rbuf[0], &buf[i * csize], csize));
+    }
+
+    const ClusterLocation loc3(loc2.number(),
+                               loc2.offset() + count,
+                               loc2.cloneID());
+
+    dStore_->writeClusterToLocation(&buf[0],
+                                    loc3,
+                                    throttle);
+}
+
 TEST_P(DataStoreNGTest, writtenToBackendUpTo)
 {
     size_t numscos = 65;
@@ -54,6 +54,8 @@ FailOverCacheTestContext::FailOverCacheTestContext(FailOverCacheTestSetup& setup
                                                    const boost::optional<std::string>& addr,
                                                    const uint16_t port,
                                                    const boost::chrono::microseconds busy_retry_duration,
+                                                   const size_t reactor_threads,
+                                                   const boost::optional<size_t> log_segment_size,
                                                    const boost::optional<size_t> file_backend_buffer_size)
     : setup_(setup)
     , addr_(addr)
@@ -61,7 +63,9 @@ FailOverCacheTestContext::FailOverCacheTestContext(FailOverCacheTestSetup& setup
     , acceptor_(make_directory(setup_.path,
                                port_),
                 file_backend_buffer_size,
-                busy_retry_duration)
+                busy_retry_duration,
+                reactor_threads,
+                log_segment_size)
     , server_(fungi::SocketServer::createSocketServer(acceptor_,
                                                       addr_,
                                                       port_,
@@ -103,6 +107,12 @@ FailOverCacheTestSetup::transport_(vd::FailOverCacheTransport::TCP);
 boost::chrono::microseconds
 FailOverCacheTestSetup::busy_retry_duration_(0);
 
+size_t
+FailOverCacheTestSetup::reactor_threads_ = 0;
+
+size_t
+FailOverCacheTestSetup::log_segment_size_ = 0;
+
 FailOverCacheTestSetup::FailOverCacheTestSetup(const boost::optional<fs::path>& p)
         : path(p)
 {
@@ -137,7 +147,8 @@ FailOverCacheTestSetup::get_next_foc_port() const
 }
 
 foctest_context_ptr
-FailOverCacheTestSetup::start_one_foc()
+FailOverCacheTestSetup::start_one_foc(const size_t reactor_threads,
+                                      const size_t log_segment_size)
 {
     uint16_t port = port_base_;
 
@@ -156,7 +167,11 @@ FailOverCacheTestSetup::start_one_foc()
     foctest_context_ptr ctx(new FailOverCacheTestContext(*this,
                                                          addr,
                                                          port,
-                                                         busy_retry_duration_));
+                                                         busy_retry_duration_,
+                                                         reactor_threads,
+                                                         log_segment_size ?
+                                                         boost::make_optional(log_segment_size) :
+                                                         boost::none));
     ports_.insert(port);
 
     return ctx;
@@ -47,6 +47,8 @@ private:
                              const boost::optional<std::string>& addr,
                              const uint16_t port,
                              const boost::chrono::microseconds busy_retry_duration,
+                             const size_t reactor_threads,
+                             const boost::optional<size_t> log_segment_size,
                              const boost::optional<size_t> file_backend_buffer_size = boost::none);
 
     FailOverCacheTestContext(const FailOverCacheTestContext&) = delete;
@@ -94,7 +96,8 @@ public:
     operator=(const FailOverCacheTestSetup&) = delete;
 
     foctest_context_ptr
-    start_one_foc();
+    start_one_foc(const size_t reactor_threads = reactor_threads_,
+                  const size_t log_segment_size = log_segment_size_);
 
     static uint16_t
     port_base()
@@ -117,6 +120,12 @@ public:
         return transport_;
     }
 
+    static size_t
+    reactor_threads()
+    {
+        return reactor_threads_;
+    }
+
     const boost::optional<boost::filesystem::path> path;
 
 private:
@@ -126,6 +135,8 @@ private:
     static uint16_t port_base_;
     static volumedriver::FailOverCacheTransport transport_;
     static boost::chrono::microseconds busy_retry_duration_;
+    static size_t reactor_threads_;
+    static size_t log_segment_size_;
 
     typedef std::set<uint16_t> set_type;
     set_type ports_;
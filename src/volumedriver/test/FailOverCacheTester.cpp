@@ -20,6 +20,8 @@
 #include "../FailOverCacheAsyncBridge.h"
 #include "../FailOverCacheSyncBridge.h"
 #include "../failovercache/FileBackend.h"
+#include "../failovercache/LogBackend.h"
+#include "../failovercache/ReceiveBufferPool.h"
 
 #include <stdlib.h>
 
@@ -149,6 +151,49 @@ TEST_P(FailOverCacheTester, VolumeWithFOC)
                   RemoveVolumeCompletely::T);
 }
 
+TEST_P(FailOverCacheTester, reactor_with_more_connections_than_threads)
+{
+    auto foc_ctx(start_one_foc(2));
+
+    const size_t nvols = 8;
+    const size_t nwrites = 64;
+
+    std::vector<std::unique_ptr<be::BackendTestSetup::WithRandomNamespace>> wrns;
+    std::vector<SharedVolumePtr> vols;
+
+    for (size_t i = 0; i < nvols; ++i)
+    {
+        wrns.emplace_back(make_random_namespace());
+        vols.emplace_back(newVolume(*wrns.back()));
+        vols.back()->setFailOverCacheConfig(foc_ctx->config(GetParam().foc_mode()));
+    }
+
+    for (size_t j = 0; j < nwrites; ++j)
+    {
+        for (size_t i = 0; i < nvols; ++i)
+        {
+            writeToVolume(*vols[i],
+                          j * default_cluster_multiplier(),
+                          default_cluster_size(),
+                          boost::lexical_cast<std::string>(i));
+        }
+    }
+
+    for (size_t i = 0; i < nvols; ++i)
+    {
+        flushFailOverCache(*vols[i]);
+        check_num_entries(*vols[i],
+                          nwrites);
+    }
+
+    for (auto& v : vols)
+    {
+        destroyVolume(v,
+                      DeleteLocalData::T,
+                      RemoveVolumeCompletely::T);
+    }
+}
+
 TEST_P(FailOverCacheTester, VolumeWithoutFOC)
 {
     auto ns_ptr = make_random_namespace();
@@ -646,6 +691,12 @@ TEST_P(FailOverCacheTester, DirectoryRemovedOnUnRegister)
         {
             foc_ns_path = backend->root();
         }
+
+        auto log_backend = std::dynamic_pointer_cast<failovercache::LogBackend>(foc_ctx->backend(ns_ptr->ns()));
+        if (log_backend)
+        {
+            foc_ns_path = log_backend->root();
+        }
     }
 
     if (foc_ns_path)
@@ -744,6 +795,128 @@ TEST_P(FailOverCacheTester, adding_and_flushing)
     EXPECT_EQ(max, count);
 }
 
+TEST_P(FailOverCacheTester, log_backend)
+{
+    if (not path)
+    {
+        return;
+    }
+
+    // small segments to get batches split up and segments recycled
+    const size_t segment_size = 1ULL << 20;
+    auto foc_ctx(start_one_foc(reactor_threads(),
+                               segment_size));
+    auto wrns(make_random_namespace());
+
+    SharedVolumePtr v = newVolume(*wrns);
+    v->setFailOverCacheConfig(foc_ctx->config(GetParam().foc_mode()));
+
+    auto backend = std::dynamic_pointer_cast<failovercache::LogBackend>(foc_ctx->backend(wrns->ns()));
+    ASSERT_TRUE(backend != nullptr);
+
+    FailOverCacheClientInterface& foc = *v->getFailOver();
+
+    const size_t csize = v->getClusterSize();
+    const SCOOffset entries_per_sco = 100;
+    const size_t scos = 8 * segment_size / (entries_per_sco * csize);
+    const size_t max = scos * entries_per_sco;
+
+    std::vector<byte> buf(csize);
+    std::vector<ClusterLocation> locs(1);
+
+    for (size_t i = 0; i < max; ++i)
+    {
+        *reinterpret_cast<size_t*>(buf.data()) = i;
+        locs[0] = ClusterLocation(i / entries_per_sco + 1,
+                                  i % entries_per_sco);
+
+        while (not foc.addEntries(locs,
+                                  locs.size(),
+                                  i,
+                                  buf.data()))
+        {
+            boost::this_thread::sleep_for(bc::milliseconds(5));
+        }
+    }
+
+    foc.Flush();
+
+    EXPECT_LE(max * csize / segment_size,
+              backend->segments());
+
+    auto check([&](size_t first_sco)
+               {
+                   size_t count = (first_sco - 1) * entries_per_sco;
+
+                   for (size_t i = first_sco; i <= scos; ++i)
+                   {
+                       foc.getSCOFromFailOver(SCO(i),
+                                              [&](ClusterLocation loc,
+                                                  uint64_t lba,
+                                                  const uint8_t* buf,
+                                                  size_t bufsize)
+                                              {
+                                                  ASSERT_EQ(count / entries_per_sco + 1, loc.sco().number());
+                                                  ASSERT_EQ(count % entries_per_sco, loc.offset());
+                                                  ASSERT_EQ(count, lba);
+                                                  ASSERT_EQ(count, *reinterpret_cast<const size_t*>(buf));
+                                                  ASSERT_EQ(csize, bufsize);
+                                                  ++count;
+                                              });
+                   }
+
+                   EXPECT_EQ(max, count);
+               });
+
+    check(1);
+
+    foc.removeUpTo(SCO(scos - 1));
+
+    EXPECT_GE(2U, backend->segments());
+
+    check(scos);
+}
+
+TEST_P(FailOverCacheTester, receive_buffer_pool)
+{
+    auto pool(failovercache::ReceiveBufferPool::create(16ULL << 10));
+
+    uint8_t* p = nullptr;
+
+    {
+        failovercache::ReceiveBuffer buf(pool->get(3000));
+        p = buf.get();
+        EXPECT_EQ(0U, pool->cached_bytes());
+    }
+
+    EXPECT_EQ(4096U, pool->cached_bytes());
+
+    {
+        // same size class -> the cached buffer is handed out again
+        failovercache::ReceiveBuffer buf(pool->get(4096));
+        EXPECT_EQ(p, buf.get());
+        EXPECT_EQ(0U, pool->cached_bytes());
+
+        failovercache::ReceiveBuffer buf2(pool->get(32ULL << 10));
+    }
+
+    // the 32k buffer exceeds the limit and is freed
+    EXPECT_EQ(4096U, pool->cached_bytes());
+
+    {
+        failovercache::ReceiveBuffer buf(failovercache::ReceiveBufferPool::get_unpooled(4096));
+    }
+
+    EXPECT_EQ(4096U, pool->cached_bytes());
+
+    {
+        // sizes are not rounded up beyond the next 4k multiple
+        failovercache::ReceiveBuffer buf(pool->get(3 * 4096));
+    }
+
+    EXPECT_EQ(4U * 4096, pool->cached_bytes());
+}
+
 // OVS-3850: FailOverCacheProxy::clear threw an exception - let's see if this is
 // inherent behaviour or something else contributed.
 TEST_P(FailOverCacheTester, clear)
@@ -420,6 +420,65 @@ TEST_P(MetaDataServerTest, no_updates_on_slave)
     EXPECT_EQ(pair.second, *maybe_string);
 }
 
+TEST_P(MetaDataServerTest, concurrent_requests_on_one_client)
+{
+    be::BackendTestSetup::WithRandomNamespace wrns("",
+                                                   cm_);
+
+    auto client(make_client());
+    mds::TableInterfacePtr table(client->open(wrns.ns().str()));
+
+    const vd::OwnerTag owner_tag(1);
+    table->set_role(mds::Role::Master,
+                    owner_tag);
+
+    const size_t nthreads = 8;
+    const size_t iterations = 256;
+
+    auto fun([&](size_t t)
+             {
+                 for (size_t i = 0; i < iterations; ++i)
+                 {
+                     const std::string s("thread-"s +
+                                         boost::lexical_cast<std::string>(t) +
+                                         "-key-"s +
+                                         boost::lexical_cast<std::string>(i));
+                     const mds::Record rec(mds::Key(s),
+                                           mds::Value(s));
+                     set(table,
+                         rec,
+                         owner_tag);
+
+                     const auto maybe_string(get(table, rec.key));
+                     ASSERT_TRUE(maybe_string != boost::none);
+                     EXPECT_EQ(s, *maybe_string);
+                 }
+             });
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(nthreads);
+
+    for (size_t t = 0; t < nthreads; ++t)
+    {
+        futures.emplace_back(std::async(std::launch::async,
+                                        fun,
+                                        t));
+    }
+
+    for (auto& f : futures)
+    {
+        f.get();
+    }
+
+    mds::ClientNG::OutCounters out;
+    mds::ClientNG::InCounters in;
+    client->counters(out,
+                     in);
+
+    EXPECT_EQ(out.messages,
+              in.messages);
+}
+
 TEST_P(MetaDataServerTest, tables)
 {
     auto check_nspaces([&](mds::ClientNG& client,
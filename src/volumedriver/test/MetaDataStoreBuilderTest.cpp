@@ -20,6 +20,7 @@
 #include "../MetaDataStoreBuilder.h"
 
 #include <boost/filesystem.hpp>
+#include <boost/scope_exit.hpp>
 
 namespace volumedrivertest
 {
@@ -198,6 +199,56 @@ TEST_P(MetaDataStoreBuilderTest, clone)
           copy);
 }
 
+TEST_P(MetaDataStoreBuilderTest, bulk_load_with_multiple_runs)
+{
+    const uint64_t bulkLoadRunEntries_orig = vd::CachedMetaDataStore::bulkLoadRunEntries;
+
+    BOOST_SCOPE_EXIT((&bulkLoadRunEntries_orig))
+    {
+        vd::CachedMetaDataStore::bulkLoadRunEntries = bulkLoadRunEntries_orig;
+    }
+    BOOST_SCOPE_EXIT_END;
+
+    // several spilled runs, with overwritten clusters spread across them
+    vd::CachedMetaDataStore::bulkLoadRunEntries = 100;
+
+    auto ns(make_random_namespace());
+    vd::SharedVolumePtr v = newVolume(*ns,
+                                      vd::VolumeSize(4ULL << 20));
+
+    writeToVolume(*v,
+                  0,
+                  v->getSize() / 2,
+                  "first");
+
+    writeToVolume(*v,
+                  v->getSize() / 8 / v->getLBASize(),
+                  v->getSize() / 2,
+                  "second");
+
+    writeToVolume(*v,
+                  0,
+                  v->getClusterSize() * 3,
+                  "third");
+
+    v->createSnapshot(SnapshotName("snap"));
+    waitForThisBackendWrite(*v);
+
+    const fs::path db_dir(directory_ / "db_copy");
+    fs::create_directories(db_dir);
+
+    auto tc(std::make_shared<vd::TokyoCabinetMetaDataBackend>(db_dir,
+                                                              true));
+
+    be::BackendInterfacePtr bi(v->getBackendInterface()->clone());
+
+    vd::CachedMetaDataStore copy(tc,
+                                 "copy-of-"s + bi->getNS().str());
+
+    check(*v,
+          copy);
+}
+
 INSTANTIATE_TEST(MetaDataStoreBuilderTest);
 
 }
@@ -25,6 +25,8 @@
 
 #include <snappy.h>
 
+#include <boost/property_tree/ptree.hpp>
+
 #include <youtils/SourceOfUncertainty.h>
 #include <youtils/System.h>
 #include <youtils/UUID.h>
@@ -33,6 +35,7 @@
 
 #include <backend/BackendInterface.h>
 
+#include <../Api.h>
 #include <../CachedMetaDataPage.h>
 #include <../CachedMetaDataStore.h>
 #include <../MetaDataStoreInterface.h>
@@ -45,6 +48,7 @@ namespace volumedrivertest
 
 using namespace volumedriver;
 
+namespace bpt = boost::property_tree;
 namespace yt = youtils;
 
 class MetaDataStoreTest
@@ -201,9 +205,9 @@ protected:
         boost::unique_lock<decltype(CachedMetaDataStore::cache_lock_)>
             cachewg(md->cache_lock_);
 
-        for (CachePage& p : md->page_list_)
+        for (size_t i = 0; i < md->num_pages_; ++i)
         {
-            md->maybeWritePage_locked_context(p, false);
+            md->maybeWritePage_locked_context(md->pages_[i], false);
         }
 
         std::cout <<
@@ -1094,7 +1098,9 @@ TEST_P(MetaDataStoreTest, LRU)
 
     check_stats(Entries(npages), Hits(npages), Misses(npages + 1));
 
-    // read page N - this should've caused another miss
+    // All pages were referenced, so the CLOCK sweep went full circle and evicted
+    // the one in the first slot (page 0) to make room for M.
+    // Reading page N is a hit ...
     {
         ClusterLocationAndHash clh;
         md->readCluster((npages - 1) * page_entries, clh);
@@ -1104,7 +1110,20 @@ TEST_P(MetaDataStoreTest, LRU)
         const ClusterLocation loc(npages);
         EXPECT_EQ(loc, clh.clusterLocation);
 
-        check_stats(Entries(npages), Hits(npages), Misses(npages + 2));
+        check_stats(Entries(npages), Hits(npages + 1), Misses(npages + 1));
+    }
+
+    // ... whereas page 0 has to be fetched again
+    {
+        ClusterLocationAndHash clh;
+        md->readCluster(0, clh);
+#ifdef ENABLE_MD5_HASH
+        EXPECT_EQ(w, clh.weed());
+#endif
+        const ClusterLocation loc(1);
+        EXPECT_EQ(loc, clh.clusterLocation);
+
+        check_stats(Entries(npages), Hits(npages + 1), Misses(npages + 2));
     }
 }
 
@@ -1261,6 +1280,225 @@ TEST_P(MetaDataStoreTest, get_page)
     check();
 }
 
+TEST_P(MetaDataStoreTest, overwrites_in_several_corks)
+{
+    const uint32_t page_size = CachePage::capacity();
+    const uint32_t max_pages = 4;
+    const uint64_t locs = max_pages * page_size;
+    const size_t csize = default_lba_size() * default_cluster_multiplier();
+    const uint64_t volsize = 2 * locs * csize;
+
+    const auto wrns(make_random_namespace());
+
+    const auto params =
+        VanillaVolumeConfigParameters(VolumeId(wrns->ns().str()),
+                                      wrns->ns(),
+                                      VolumeSize(volsize),
+                                      new_owner_tag())
+        .metadata_cache_capacity(max_pages)
+        ;
+
+    SharedVolumePtr v(newVolume(params));
+    std::unique_ptr<MetaDataStoreInterface>& md = getMDStore(v);
+
+    std::vector<ClusterLocation> expected(2 * locs);
+
+    auto write([&](ClusterAddress start,
+                   ClusterAddress end,
+                   ClusterAddress stride,
+                   SCONumber sco)
+               {
+                   for (ClusterAddress ca = start; ca < end; ca += stride)
+                   {
+                       const ClusterLocation loc(sco);
+                       md->writeCluster(ca,
+                                        ClusterLocationAndHash(loc,
+                                                               growWeed()));
+                       expected[ca] = loc;
+                   }
+               });
+
+    auto check([&]
+               {
+                   for (ClusterAddress ca = 0; ca < expected.size(); ++ca)
+                   {
+                       ClusterLocationAndHash clh;
+                       md->readCluster(ca, clh);
+                       ASSERT_EQ(expected[ca],
+                                 clh.clusterLocation) << "CA " << ca;
+
+                       const std::vector<ClusterLocation>
+                           vec(md->get_page(ca));
+                       ASSERT_EQ(expected[ca],
+                                 vec.at(CachePage::offset(ca))) << "CA " << ca;
+                   }
+               });
+
+    // enough entries per cork to have the cork index grow a few times
+    write(0, 2 * locs, 1, 1);
+    md->cork(yt::UUID());
+
+    write(0, 2 * locs, 3, 2);
+    md->cork(yt::UUID());
+
+    write(1, locs, 7, 3);
+    write(1, locs, 14, 4);
+
+    check();
+
+    md->unCork();
+    check();
+
+    md->unCork();
+    check();
+}
+
+TEST_P(MetaDataStoreTest, read_clusters)
+{
+    const uint32_t page_size = CachePage::capacity();
+    const uint32_t max_pages = 2;
+    const uint64_t locs = 4 * max_pages * page_size;
+    const size_t csize = default_lba_size() * default_cluster_multiplier();
+    const uint64_t volsize = locs * csize;
+
+    const auto wrns(make_random_namespace());
+
+    const auto params =
+        VanillaVolumeConfigParameters(VolumeId(wrns->ns().str()),
+                                      wrns->ns(),
+                                      VolumeSize(volsize),
+                                      new_owner_tag())
+        .metadata_cache_capacity(max_pages)
+        ;
+
+    SharedVolumePtr v(newVolume(params));
+    std::unique_ptr<MetaDataStoreInterface>& md = getMDStore(v);
+
+    SCONumber sco_num = 1;
+
+    auto write([&](ClusterAddress start,
+                   ClusterAddress stride)
+               {
+                   for (ClusterAddress ca = start; ca < locs; ca += stride)
+                   {
+                       md->writeCluster(ca,
+                                        ClusterLocationAndHash(ClusterLocation(sco_num++),
+                                                               growWeed()));
+                   }
+               });
+
+    auto check([&](ClusterAddress start,
+                   size_t count)
+               {
+                   std::vector<ClusterLocationAndHash> vec(count);
+                   md->readClusters(start,
+                                    count,
+                                    vec.data());
+
+                   for (size_t i = 0; i < count; ++i)
+                   {
+                       ClusterLocationAndHash clh;
+                       md->readCluster(start + i, clh);
+                       ASSERT_EQ(clh.clusterLocation,
+                                 vec[i].clusterLocation) << "CA " << (start + i);
+#ifdef ENABLE_MD5_HASH
+                       ASSERT_EQ(clh.weed(),
+                                 vec[i].weed()) << "CA " << (start + i);
+#endif
+                   }
+               });
+
+    auto check_ranges([&]
+                      {
+                          check(0, locs);
+                          check(page_size - 1, 2);
+                          check(page_size / 2, 3 * page_size);
+                          check(locs - 1, 1);
+                      });
+
+    check_ranges();
+
+    // leave some clusters unwritten
+    write(0, 3);
+    md->cork(yt::UUID());
+    md->unCork();
+
+    check_ranges();
+
+    // and have some corked
+    write(1, 5);
+    md->cork(yt::UUID());
+    write(2, 7);
+
+    check_ranges();
+}
+
+TEST_P(MetaDataStoreTest, readahead)
+{
+    const uint32_t readahead = 4;
+    {
+        const PARAMETER_TYPE(metadata_cache_readahead_pages) p(readahead);
+        bpt::ptree pt;
+        api::persistConfiguration(pt, false);
+        p.persist(pt);
+        api::updateConfiguration(pt);
+    }
+
+    const uint32_t page_size = CachePage::capacity();
+    const uint32_t max_pages = 4 * readahead;
+    const uint32_t npages = 3 * (readahead + 1) + 1;
+    const uint64_t locs = npages * page_size;
+    const size_t csize = default_lba_size() * default_cluster_multiplier();
+    const uint64_t volsize = locs * csize;
+
+    const auto wrns(make_random_namespace());
+
+    const auto params =
+        VanillaVolumeConfigParameters(VolumeId(wrns->ns().str()),
+                                      wrns->ns(),
+                                      VolumeSize(volsize),
+                                      new_owner_tag())
+        .metadata_cache_capacity(max_pages)
+        ;
+
+    SharedVolumePtr v(newVolume(params));
+    std::unique_ptr<MetaDataStoreInterface>& md = getMDStore(v);
+
+    for (size_t i = 0; i < npages; ++i)
+    {
+        md->writeCluster(i * page_size,
+                         ClusterLocationAndHash(ClusterLocation(i + 1),
+                                                growWeed()));
+    }
+
+    md->cork(yt::UUID());
+    md->unCork();
+
+    // drops all pages after writing them out
+    md->set_cache_capacity(max_pages + 1);
+
+    MetaDataStoreStats before;
+    md->getStats(before);
+    EXPECT_EQ(0U, before.cached_pages);
+
+    for (size_t i = 0; i < npages; ++i)
+    {
+        ClusterLocationAndHash clh;
+        md->readCluster(i * page_size, clh);
+        EXPECT_EQ(ClusterLocation(i + 1),
+                  clh.clusterLocation);
+    }
+
+    MetaDataStoreStats after;
+    md->getStats(after);
+
+    // the first miss is not sequential, every subsequent one fetches
+    // `readahead' pages in addition
+    EXPECT_EQ(4U, after.cache_misses - before.cache_misses);
+    EXPECT_EQ(npages - 4, after.cache_hits - before.cache_hits);
+    EXPECT_EQ(npages, after.cached_pages);
+}
+
 INSTANTIATE_TEST(MetaDataStoreTest);
 
 }
@@ -21,11 +21,15 @@
 #include "SCOCacheTestSetup.h"
 #include "VolManagerTestSetup.h"
 
+#include <atomic>
 #include <fstream>
+#include <future>
 #include <iostream>
 
+#include <boost/chrono.hpp>
 #include <boost/iostreams/stream.hpp>
 #include <boost/iostreams/device/array.hpp>
+#include <boost/thread/thread.hpp>
 
 #include <backend/BackendConfig.h>
 #include <backend/BackendInterface.h>
@@ -678,6 +682,104 @@ TEST_F(SCOCacheTest, scosAgain)
     }
 }
 
+namespace
+{
+
+// Waits for the test to give the go-ahead before "fetching" the SCO.
+class BlockingSCOFetcher
+    : public SCOFetcher
+{
+public:
+    BlockingSCOFetcher(std::atomic<unsigned>& calls,
+                       std::shared_future<void> go,
+                       size_t size)
+        : calls_(calls)
+        , go_(go)
+        , size_(size)
+    {}
+
+    virtual void
+    operator()(const boost::filesystem::path& dest) override final
+    {
+        ++calls_;
+        go_.wait();
+
+        const std::vector<char> buf(size_, 'x');
+        std::ofstream ofs(dest.string().c_str());
+        ofs.write(buf.data(),
+                  buf.size());
+    }
+
+    virtual bool
+    disposable() const override final
+    {
+        return true;
+    }
+
+private:
+    std::atomic<unsigned>& calls_;
+    std::shared_future<void> go_;
+    const size_t size_;
+};
+
+}
+
+TEST_F(SCOCacheTest, concurrent_fetches_of_a_sco_are_coalesced)
+{
+    const backend::Namespace nspace;
+    addNamespace(nspace);
+
+    const SCO sco_name(ClusterLocation(1).sco());
+    const size_t size = 4 << 10;
+
+    std::atomic<unsigned> calls(0);
+    std::promise<void> promise;
+    std::shared_future<void> go(promise.get_future().share());
+
+    auto get([&]() -> CachedSCOPtr
+             {
+                 BlockingSCOFetcher fetcher(calls,
+                                            go,
+                                            size);
+                 return scoCache_->getSCO(nspace,
+                                          sco_name,
+                                          size * 2,
+                                          fetcher);
+             });
+
+    auto f1(std::async(std::launch::async,
+                       get));
+
+    while (calls == 0)
+    {
+        boost::this_thread::sleep_for(boost::chrono::milliseconds(1));
+    }
+
+    const size_t nwaiters = 4;
+    std::vector<std::future<CachedSCOPtr>> waiters;
+    for (size_t i = 0; i < nwaiters; ++i)
+    {
+        waiters.emplace_back(std::async(std::launch::async,
+                                        get));
+    }
+
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(100));
+    EXPECT_EQ(1U, calls);
+
+    promise.set_value();
+
+    CachedSCOPtr sco(f1.get());
+    ASSERT_TRUE(sco != nullptr);
+    EXPECT_TRUE(scoCache_->isSCODisposable(sco));
+
+    for (auto& w : waiters)
+    {
+        EXPECT_TRUE(sco == w.get());
+    }
+
+    EXPECT_EQ(1U, calls);
+}
+
 TEST_F(SCOCacheTest, cloneSCOs)
 {
     auto nsptr1 = make_random_namespace();
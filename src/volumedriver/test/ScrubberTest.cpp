@@ -70,7 +70,8 @@ public:
              uint64_t region_size_exponent = 5,
              float fill_ratio = 1.0,
              bool apply_immediately = false,
-             bool verbose_scrubbing = true)
+             bool verbose_scrubbing = true,
+             uint32_t num_threads = ScrubberAdapter::num_threads_default)
     {
         return ScrubberAdapter::scrub(VolManager::get()->getBackendConfig().clone(),
                                       scrub_work,
@@ -78,7 +79,8 @@ public:
                                       region_size_exponent,
                                       fill_ratio,
                                       apply_immediately,
-                                      verbose_scrubbing);
+                                      verbose_scrubbing,
+                                      num_threads);
     }
 
     void
@@ -690,6 +692,69 @@ TEST_P(ScrubberTest, SmallRegionScrub1)
                   RemoveVolumeCompletely::T);
 }
 
+TEST_P(ScrubberTest, parallel_region_scrub)
+{
+    auto ns_ptr = make_random_namespace();
+
+    const backend::Namespace& ns = ns_ptr->ns();
+
+    const VolumeId vid("volume1");
+    SharedVolumePtr v1 = newVolume(vid,
+                                   ns);
+
+    const uint64_t region_size_exponent = 2;
+    const size_t nclusters = 256;
+
+    // Overwrite every other cluster so there's something to scrub in each of
+    // the (tiny) regions.
+    for (size_t j = 0; j < 2; ++j)
+    {
+        for (size_t i = 0; i < nclusters; ++i)
+        {
+            if (j == 0 or i % 2 == 0)
+            {
+                writeToVolume(*v1,
+                              i * default_cluster_multiplier(),
+                              default_cluster_size(),
+                              boost::lexical_cast<std::string>(i + j * nclusters));
+            }
+        }
+    }
+
+    v1->createSnapshot(SnapshotName("snap1"));
+    persistXVals(v1->getName());
+    waitForThisBackendWrite(*v1);
+
+    auto scrub_work_units = getScrubbingWork(vid);
+    ASSERT_EQ(1U, scrub_work_units.size());
+
+    scrubbing::ScrubReply scrub_result;
+    ASSERT_NO_THROW(scrub_result = do_scrub(scrub_work_units.front(),
+                                            region_size_exponent,
+                                            1.0,
+                                            false,
+                                            false,
+                                            16));
+
+    ASSERT_NO_THROW(apply_scrubbing(vid,
+                                    scrub_result,
+                                    ScrubbingCleanup::OnError));
+
+    for (size_t i = 0; i < nclusters; ++i)
+    {
+        checkVolume(*v1,
+                    i * default_cluster_multiplier(),
+                    default_cluster_size(),
+                    boost::lexical_cast<std::string>(i % 2 == 0 ?
+                                                     i + nclusters :
+                                                     i));
+    }
+
+    destroyVolume(v1,
+                  DeleteLocalData::T,
+                  RemoveVolumeCompletely::T);
+}
+
 TEST_P(ScrubberTest, CloneScrubbin)
 {
     auto ns_ptr = make_random_namespace();
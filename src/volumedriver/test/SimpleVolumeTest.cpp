@@ -15,6 +15,7 @@
 
 #include "VolManagerTestSetup.h"
 
+#include <future>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -51,6 +52,74 @@ public:
         // dontCatch(); uncomment if you want an unhandled exception to cause a crash, e.g. to get a stacktrace
     }
 
+    void
+    test_discard(bool enable,
+                 bool with_foc)
+    {
+        {
+            const PARAMETER_TYPE(enable_discard) p(enable);
+            bpt::ptree pt;
+            api::persistConfiguration(pt, false);
+            p.persist(pt);
+            api::updateConfiguration(pt);
+        }
+
+        auto wrns(make_random_namespace());
+        SharedVolumePtr v = newVolume(*wrns);
+
+        foctest_context_ptr foc_ctx;
+        if (with_foc)
+        {
+            foc_ctx = start_one_foc();
+            v->setFailOverCacheConfig(foc_ctx->config(FailOverCacheMode::Asynchronous));
+        }
+
+        const uint64_t csize = v->getClusterSize();
+        const uint64_t lba_size = v->getLBASize();
+        const uint64_t lbas_per_cluster = csize / lba_size;
+        const std::string pattern("discard");
+        const std::string zeroes(1, 0);
+
+        writeToVolume(*v, 0, 4 * csize, pattern);
+
+        // the last LBA of the first cluster is zeroed, the next two clusters are
+        // discarded as a whole - or overwritten with zeroes if discards are
+        // disabled or could not make it to the DTL
+        v->discard(lbas_per_cluster - 1,
+                   2 * csize + lba_size);
+
+        const bool discarded = enable and not with_foc;
+        EXPECT_EQ((discarded ? 5 : 7) * csize,
+                  v->getCurrentBackendSize());
+
+        auto check([&]
+                   {
+                       checkVolume(*v, 0, csize - lba_size, pattern);
+                       checkVolume(*v, lbas_per_cluster - 1, lba_size, zeroes);
+                       checkVolume(*v, lbas_per_cluster, 2 * csize, zeroes);
+                       checkVolume(*v, 3 * lbas_per_cluster, csize, pattern);
+                   });
+
+        check();
+
+        EXPECT_THROW(v->discard(v->getSize() / lba_size,
+                                csize),
+                     std::exception);
+
+        v->createSnapshot(SnapshotName("snap"));
+        waitForThisBackendWrite(*v);
+
+        destroyVolume(v,
+                      DeleteLocalData::F,
+                      RemoveVolumeCompletely::F);
+        v = nullptr;
+
+        ASSERT_NO_THROW(v = localRestart(wrns->ns()));
+        ASSERT_TRUE(v != nullptr);
+
+        check();
+    }
+
     void
     with_snapshot_not_in_backend(std::function<void(Volume&,
                                                     const SnapshotName& snap)> fun)
@@ -2339,6 +2408,81 @@ TEST_P(SimpleVolumeTest, clones_and_location_based_caching)
                 pattern);
 }
 
+TEST_P(SimpleVolumeTest, weed_types)
+{
+    auto set_default([](yt::WeedType t)
+                     {
+                         const PARAMETER_TYPE(default_weed_type) p(t);
+                         bpt::ptree pt;
+                         api::persistConfiguration(pt, false);
+                         p.persist(pt);
+                         api::updateConfiguration(pt);
+                     });
+
+    set_default(yt::WeedType::Md5);
+
+    const auto parent_ns(make_random_namespace());
+    SharedVolumePtr parent = newVolume(*parent_ns);
+
+    EXPECT_EQ(yt::WeedType::Md5,
+              parent->get_config().weed_type());
+
+    const std::string pattern("written-to-parent");
+    writeToVolume(*parent,
+                  0,
+                  4096,
+                  pattern);
+
+    const SnapshotName snap("snap");
+    createSnapshot(*parent,
+                   snap);
+
+    waitForThisBackendWrite(*parent);
+
+    set_default(yt::WeedType::Murmur3_128);
+
+    const auto clone_ns(make_random_namespace());
+    SharedVolumePtr clone = createClone(*clone_ns,
+                                        parent_ns->ns(),
+                                        snap);
+
+    EXPECT_EQ(yt::WeedType::Md5,
+              clone->get_config().weed_type());
+
+    const auto ns(make_random_namespace());
+    SharedVolumePtr v = newVolume(*ns);
+
+    EXPECT_EQ(yt::WeedType::Murmur3_128,
+              v->get_config().weed_type());
+
+    writeToVolume(*v,
+                  0,
+                  4096,
+                  pattern);
+
+    destroyVolume(v,
+                  DeleteLocalData::F,
+                  RemoveVolumeCompletely::F);
+
+    set_default(yt::WeedType::Md5);
+
+    localRestart(ns->ns());
+    v = getVolume(VolumeId(ns->ns().str()));
+
+    EXPECT_EQ(yt::WeedType::Murmur3_128,
+              v->get_config().weed_type());
+
+    checkVolume(*v,
+                0,
+                4096,
+                pattern);
+
+    checkVolume(*clone,
+                0,
+                4096,
+                pattern);
+}
+
 TEST_P(SimpleVolumeTest, cluster_cache_limit)
 {
     auto ns(make_random_namespace());
@@ -2715,6 +2859,292 @@ TEST_P(SimpleVolumeTest, partial_read_counters)
     EXPECT_LT(0UL, prc.fast + prc.slow);
 }
 
+TEST_P(SimpleVolumeTest, parallel_partial_reads)
+{
+    const uint32_t nthreads = 4;
+    {
+        const PARAMETER_TYPE(partial_read_threads) prt(nthreads);
+        bpt::ptree pt;
+        api::persistConfiguration(pt, false);
+        prt.persist(pt);
+        api::updateConfiguration(pt);
+    }
+
+    {
+        bpt::ptree pt;
+        api::persistConfiguration(pt, false);
+        const PARAMETER_TYPE(partial_read_threads) prt(pt);
+        ASSERT_EQ(nthreads, prt.value());
+    }
+
+    auto wrns(make_random_namespace());
+    SharedVolumePtr v = newVolume(*wrns);
+
+    // spread the data over a number of SCOs so the read below is split up
+    const uint64_t size = 3 * v->getSCOSize();
+    const std::string pattern("partial reads, in parallel");
+
+    writeToVolume(*v, 0, size, pattern);
+
+    const VolumeConfig cfg(v->get_config());
+    v->scheduleBackendSync();
+    waitForThisBackendWrite(*v);
+
+    destroyVolume(v,
+                  DeleteLocalData::T,
+                  RemoveVolumeCompletely::F);
+
+    v = nullptr;
+    restartVolume(cfg);
+    v = getVolume(cfg.id_);
+    ASSERT_NE(nullptr, v);
+
+    checkVolume(*v, 0, size, pattern);
+
+    const be::PartialReadCounter prc(v->getDataStore()->partial_read_counter());
+    EXPECT_LT(0UL, prc.fast + prc.slow);
+}
+
+TEST_P(SimpleVolumeTest, sparse_scos)
+{
+    auto wrns(make_random_namespace());
+    SharedVolumePtr v = newVolume(*wrns);
+
+    const uint64_t csize = v->getClusterSize();
+    const uint64_t lba_size = v->getLBASize();
+    const uint64_t chunk_size = 4 * csize;
+
+    {
+        const PARAMETER_TYPE(sparse_sco_chunk_size) p(chunk_size);
+        bpt::ptree pt;
+        api::persistConfiguration(pt, false);
+        p.persist(pt);
+        api::updateConfiguration(pt);
+    }
+
+    const uint64_t sco_size = v->getSCOSize();
+    // 16 bytes, so reads at cluster boundaries see it at offset 0
+    const std::string pattern("sparse SCO cache");
+
+    writeToVolume(*v, 0, sco_size, pattern);
+
+    const VolumeConfig cfg(v->get_config());
+    v->scheduleBackendSync();
+    waitForThisBackendWrite(*v);
+
+    destroyVolume(v,
+                  DeleteLocalData::T,
+                  RemoveVolumeCompletely::F);
+
+    v = nullptr;
+    restartVolume(cfg);
+    v = getVolume(cfg.id_);
+    ASSERT_NE(nullptr, v);
+
+    v->set_cluster_cache_behaviour(ClusterCacheBehaviour::NoCache);
+
+    SCOCache& c = *VolManager::get()->getSCOCache();
+    const SCO sco(1);
+
+    // a single cluster: its chunk is fetched into a sparse SCO ...
+    checkVolume(*v, 0, csize, pattern);
+    EXPECT_TRUE(c.findSCO(wrns->ns(), sco) == nullptr);
+
+    // ... which serves the rest of the chunk
+    const uint64_t hits = v->getCacheHits();
+    checkVolume(*v, csize / lba_size, csize, pattern);
+    EXPECT_EQ(hits + 1, v->getCacheHits());
+    EXPECT_TRUE(c.findSCO(wrns->ns(), sco) == nullptr);
+
+    // once most of it was read the whole SCO is fetched
+    for (uint64_t off = 0; off < sco_size; off += chunk_size)
+    {
+        checkVolume(*v, off / lba_size, csize, pattern);
+    }
+
+    EXPECT_TRUE(c.findSCO(wrns->ns(), sco) != nullptr);
+    checkVolume(*v, 0, sco_size, pattern);
+}
+
+TEST_P(SimpleVolumeTest, concurrent_syncs)
+{
+    auto wrns(make_random_namespace());
+    SharedVolumePtr v = newVolume(*wrns);
+
+    const size_t nthreads = 4;
+    const size_t iterations = 64;
+    const uint64_t csize = v->getClusterSize();
+    const uint64_t lbas_per_cluster = csize / v->getLBASize();
+
+    auto pattern([](size_t t, size_t i)
+                 {
+                     return "thread-" + boost::lexical_cast<std::string>(t) +
+                         "-iteration-" + boost::lexical_cast<std::string>(i);
+                 });
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(nthreads);
+
+    for (size_t t = 0; t < nthreads; ++t)
+    {
+        futures.emplace_back(std::async(std::launch::async,
+                                        [&, t]
+                                        {
+                                            for (size_t i = 0; i < iterations; ++i)
+                                            {
+                                                writeToVolume(*v,
+                                                              (t * iterations + i) * lbas_per_cluster,
+                                                              csize,
+                                                              pattern(t, i));
+                                                v->sync();
+                                            }
+                                        }));
+    }
+
+    for (auto& f : futures)
+    {
+        EXPECT_NO_THROW(f.get());
+    }
+
+    for (size_t t = 0; t < nthreads; ++t)
+    {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            checkVolume(*v,
+                        (t * iterations + i) * lbas_per_cluster,
+                        csize,
+                        pattern(t, i));
+        }
+    }
+}
+
+TEST_P(SimpleVolumeTest, discard)
+{
+    test_discard(true,
+                 false);
+}
+
+TEST_P(SimpleVolumeTest, discard_disabled)
+{
+    test_discard(false,
+                 false);
+}
+
+TEST_P(SimpleVolumeTest, discard_with_foc)
+{
+    test_discard(true,
+                 true);
+}
+
+TEST_P(SimpleVolumeTest, zero_cluster_elision)
+{
+    auto wrns(make_random_namespace());
+    SharedVolumePtr v = newVolume(*wrns);
+
+    const uint64_t csize = v->getClusterSize();
+    const uint64_t lbas_per_cluster = csize / v->getLBASize();
+    const std::string pattern("non-zero");
+    const std::string zeroes(1, 0);
+
+    auto set_elision([](bool enable)
+                     {
+                         const PARAMETER_TYPE(elide_zero_clusters) p(enable);
+                         bpt::ptree pt;
+                         api::persistConfiguration(pt, false);
+                         p.persist(pt);
+                         api::updateConfiguration(pt);
+                     });
+
+    writeToVolume(*v, 0, 4 * csize, pattern);
+    EXPECT_EQ(4 * csize, v->getCurrentBackendSize());
+
+    set_elision(true);
+
+    // zero clusters between non-zero ones in a single request
+    std::vector<uint8_t> buf(4 * csize, 0);
+    memset(buf.data(), 'x', csize);
+    memset(buf.data() + 3 * csize, 'x', csize);
+
+    writeToVolume(*v, 0, buf.size(), buf.data());
+    EXPECT_EQ(6 * csize, v->getCurrentBackendSize());
+
+    checkVolume(*v, 0, csize, "x");
+    checkVolume(*v, lbas_per_cluster, 2 * csize, zeroes);
+    checkVolume(*v, 3 * lbas_per_cluster, csize, "x");
+
+    set_elision(false);
+
+    writeToVolume(*v, lbas_per_cluster, csize, zeroes);
+    EXPECT_EQ(7 * csize, v->getCurrentBackendSize());
+    checkVolume(*v, lbas_per_cluster, csize, zeroes);
+}
+
+TEST_P(SimpleVolumeTest, coalesced_snapshots_uploads)
+{
+    {
+        const PARAMETER_TYPE(snapshots_upload_max_tlogs) p(3);
+        bpt::ptree pt;
+        api::persistConfiguration(pt, false);
+        p.persist(pt);
+        api::updateConfiguration(pt);
+    }
+
+    auto wrns(make_random_namespace());
+    SharedVolumePtr v = newVolume(*wrns);
+
+    const uint64_t csize = v->getClusterSize();
+    const uint64_t lbas_per_cluster = csize / v->getLBASize();
+    const size_t num_tlogs = 8;
+
+    auto pattern([](size_t i)
+                 {
+                     return "tlog-" + boost::lexical_cast<std::string>(i);
+                 });
+
+    {
+        // queue up the TLogs so their snapshots.xml uploads get coalesced
+        SCOPED_BLOCK_BACKEND(*v);
+
+        for (size_t i = 0; i < num_tlogs; ++i)
+        {
+            writeToVolume(*v, i * lbas_per_cluster, csize, pattern(i));
+            v->scheduleBackendSync();
+        }
+    }
+
+    waitForThisBackendWrite(*v);
+
+    auto check_all_written([&](const SnapshotPersistor& sp)
+                           {
+                               OrderedTLogIds written;
+                               sp.getTLogsWrittenToBackend(written);
+                               EXPECT_LE(num_tlogs, written.size());
+
+                               OrderedTLogIds not_written;
+                               sp.getTLogsNotWrittenToBackend(not_written);
+                               EXPECT_EQ(1U, not_written.size());
+                           });
+
+    check_all_written(v->getSnapshotManagement().getSnapshotPersistor());
+    check_all_written(*SnapshotManagement::createSnapshotPersistor(v->getBackendInterface()->clone()));
+
+    const VolumeConfig cfg(v->get_config());
+
+    destroyVolume(v,
+                  DeleteLocalData::T,
+                  RemoveVolumeCompletely::F);
+
+    v = nullptr;
+    restartVolume(cfg);
+    v = getVolume(cfg.id_);
+    ASSERT_NE(nullptr, v);
+
+    for (size_t i = 0; i < num_tlogs; ++i)
+    {
+        checkVolume(*v, i * lbas_per_cluster, csize, pattern(i));
+    }
+}
+
 namespace
 {
 
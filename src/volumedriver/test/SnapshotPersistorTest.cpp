@@ -14,6 +14,7 @@
 // but WITHOUT ANY WARRANTY of any kind.
 
 #include "VolumeDriverTestConfig.h"
+#include "../SnapshotJournal.h"
 #include "../SnapshotPersistor.h"
 
 #include <algorithm>
@@ -838,6 +839,68 @@ TEST_F(SnapshotPersistorTest, synced_to_backend)
     EXPECT_TRUE(sp_->isTLogWrittenToBackend(tlog));
 }
 
+TEST_F(SnapshotPersistorTest, journal)
+{
+    const fs::path p(basedir_ / "snapshots.xml");
+    sp_->saveToFile(p, SyncAndRename::T);
+
+    SnapshotJournal journal(p);
+
+    const uint64_t tlog_size = 4096;
+    OrderedTLogIds tlogs;
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        const TLogId prev(sp_->getCurrentTLog());
+        sp_->addCurrentBackendSize(tlog_size);
+        sp_->newTLog();
+
+        TLog t(prev);
+        t.add_to_backend_size(tlog_size);
+        journal.new_tlog(t,
+                         sp_->getCurrentTLog());
+        tlogs.push_back(prev);
+    }
+
+    for (size_t i = 0; i < 2; ++i)
+    {
+        sp_->setTLogWrittenToBackend(tlogs[i]);
+        journal.tlog_written_to_backend(tlogs[i]);
+    }
+
+    EXPECT_EQ(5U, journal.size());
+
+    auto check([&]
+               {
+                   const SnapshotPersistor sp(p);
+                   EXPECT_EQ(sp_->getCurrentTLogs(),
+                             sp.getCurrentTLogs());
+                   EXPECT_EQ(sp_->getTLogsWrittenToBackend(),
+                             sp.getTLogsWrittenToBackend());
+                   EXPECT_EQ(sp_->getCurrentBackendSize(),
+                             sp.getCurrentBackendSize());
+               });
+
+    check();
+
+    {
+        // a torn record at the end is ignored
+        fs::ofstream ofs(SnapshotJournal::path(p),
+                         std::ios::binary | std::ios::app);
+        const std::vector<char> garbage(48, 0x5a);
+        ofs.write(garbage.data(),
+                  garbage.size());
+    }
+
+    check();
+
+    // the journal does not apply to a newer version of the snapshots file
+    sp_->newTLog();
+    sp_->saveToFile(p, SyncAndRename::T);
+
+    check();
+}
+
 }
 
 // Local Variables: **
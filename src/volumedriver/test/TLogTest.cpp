@@ -30,6 +30,7 @@
 #include <youtils/System.h>
 
 #include "../CombinedTLogReader.h"
+#include "../CompressedTLog.h"
 #include "../TLogWriter.h"
 #include "../ClusterLocation.h"
 #include "../TLogReader.h"
@@ -167,6 +168,17 @@ TEST_F(TLogTest, combined)
                 assertTLogReadersEqual(reader1.get(), &reader2);
             }
 
+            {
+                std::shared_ptr<TLogReaderInterface>
+                    reader1(CombinedTLogReader::create(empty,
+                                                       paths,
+                                                       0,
+                                                       CombinedTLogReader::FetchStrategy::Parallel,
+                                                       2));
+                TLogReader reader2(p123);
+                assertTLogReadersEqual(reader1.get(), &reader2);
+            }
+
             {
                 std::shared_ptr<TLogReaderInterface> reader1 = CombinedTLogReader::create_backward_reader(empty, paths, 0);
                 BackwardTLogReader reader2(p123);
@@ -500,6 +512,120 @@ TEST_F(TLogTest, forth_and_back)
     ASSERT_TRUE(r.nextAny() == nullptr);
 }
 
+
+TEST_F(TLogTest, compressed)
+{
+    const fs::path p(directory_ / "tlog");
+    const fs::path z(directory_ / "tlog.compressed");
+    const fs::path x(directory_ / "tlog.expanded");
+
+    const size_t count = 10000;
+    const SCOOffset sco_size = 1024;
+
+    {
+        TLogWriter w(p);
+        for (size_t i = 0; i < count; ++i)
+        {
+            // mostly sequential with the occasional random write
+            const ClusterAddress ca = (i % 97 == 0) ?
+                drand48() * count :
+                i;
+            const ClusterLocation loc(1 + i / sco_size,
+                                      i % sco_size);
+            w.add(ca,
+                  ClusterLocationAndHash(loc,
+                                         VolManagerTestSetup::growWeed()));
+
+            if (i % sco_size == sco_size - 1)
+            {
+                w.add(CheckSum(i));
+            }
+        }
+        w.close();
+    }
+
+    EXPECT_FALSE(CompressedTLog::is_compressed(p));
+
+    const CheckSum cs(CompressedTLog::compress(p,
+                                               z,
+                                               1000));
+
+    EXPECT_TRUE(CompressedTLog::is_compressed(z));
+    EXPECT_EQ(FileUtils::calculate_checksum(z), cs);
+    EXPECT_GT(fs::file_size(p), fs::file_size(z));
+
+    CompressedTLog::decompress(z,
+                               x);
+    EXPECT_EQ(FileUtils::calculate_checksum(p),
+              FileUtils::calculate_checksum(x));
+
+    auto check([](TLogReaderInterface& r1,
+                  TLogReaderInterface& r2)
+               {
+                   const Entry* e1;
+                   while ((e1 = r1.nextAny()))
+                   {
+                       const Entry* e2 = r2.nextAny();
+                       ASSERT_TRUE(e2 != nullptr);
+                       ASSERT_TRUE(*e1 == *e2);
+                   }
+
+                   ASSERT_TRUE(r2.nextAny() == nullptr);
+               });
+
+    {
+        TLogReader r1(p);
+        TLogReader r2(z);
+        check(r1, r2);
+    }
+
+    {
+        BackwardTLogReader r1(p);
+        BackwardTLogReader r2(z);
+        check(r1, r2);
+    }
+
+    // the expanded copies are cleaned up
+    for (fs::directory_iterator it(directory_); it != fs::directory_iterator(); ++it)
+    {
+        EXPECT_TRUE(it->path() == p or
+                    it->path() == z or
+                    it->path() == x) << it->path();
+    }
+}
+
+TEST_F(TLogTest, corrupt_compressed)
+{
+    const fs::path p(directory_ / "tlog");
+    const fs::path z(directory_ / "tlog.compressed");
+
+    {
+        TLogWriter w(p);
+        for (size_t i = 0; i < 1024; ++i)
+        {
+            w.add(i,
+                  ClusterLocationAndHash(ClusterLocation(1, i),
+                                         VolManagerTestSetup::growWeed()));
+        }
+        w.close();
+    }
+
+    CompressedTLog::compress(p,
+                             z);
+
+    {
+        FileDescriptor fd(z,
+                          FDMode::ReadWrite);
+        uint8_t b;
+        const off_t off = fs::file_size(z) - 1;
+        ASSERT_EQ(1U, fd.pread(&b, 1, off));
+        b = ~b;
+        ASSERT_EQ(1U, fd.pwrite(&b, 1, off));
+    }
+
+    EXPECT_THROW(TLogReader r(z),
+                 CompressedTLogException);
+}
 }
 
 // Local Variables: **
@@ -626,6 +626,92 @@ TEST_P(VolumeBackupTest, report_threshold)
     removeVolumeCompletely(v1);
 }
 
+TEST_P(VolumeBackupTest, pipelined_replay)
+{
+    auto ns1_ptr = make_random_namespace();
+    const Namespace& ns1 = ns1_ptr->ns();
+
+    SharedVolumePtr v = newVolume(VolumeId("volume1"),
+                                  ns1);
+
+    const uint64_t csize = v->getClusterSize();
+    const uint64_t lba_size = v->getLBASize();
+    const uint64_t nclusters = 3 * v->getSCOSize() / csize;
+
+    auto pattern([](uint64_t i) -> std::string
+                 {
+                     return (i % 3 == 0) ? "third" : (i % 2 == 0) ? "even" : "odd";
+                 });
+
+    // Interleaved and partially overwritten, so adjacent clusters come from
+    // different SCOs and SCOs are referenced by more than one TLog.
+    for (uint64_t i = 0; i < nclusters; i += 2)
+    {
+        writeToVolume(*v, i * csize / lba_size, csize, "even");
+    }
+
+    v->scheduleBackendSync();
+
+    for (uint64_t i = 1; i < nclusters; i += 2)
+    {
+        writeToVolume(*v, i * csize / lba_size, csize, "odd");
+    }
+
+    v->scheduleBackendSync();
+
+    for (uint64_t i = 0; i < nclusters; i += 3)
+    {
+        writeToVolume(*v, i * csize / lba_size, csize, "third");
+    }
+
+    const SnapshotName snap1("snap1");
+
+    v->createSnapshot(snap1);
+
+    waitForThisBackendWrite(*v);
+
+    be::Namespace ns2;
+
+    create_backup_config(ns2,
+                         ns1,
+                         false,
+                         snap1);
+
+    {
+        const fs::path p(directory_ / "backup_configuration_file");
+        bpt::ptree pt;
+        bpt::json_parser::read_json(p.string(),
+                                    pt);
+        pt.put("sco_read_ahead", 2);
+        pt.put("sco_cache_size", 1);
+        pt.put("max_write_size", "16KiB");
+        bpt::json_parser::write_json(p.string(),
+                                     pt);
+    }
+
+    ensure_target_namespace(ns2);
+
+    ASSERT_TRUE(start_backup_program());
+
+    auto restore_to_ptr = make_random_namespace();
+    const be::Namespace& restore_to = restore_to_ptr->ns();
+
+    create_restore_config(restore_to,
+                          ns2);
+
+    ASSERT_TRUE(start_restore_program());
+
+    SharedVolumePtr v1 = restartVolumeFromBackup(restore_to);
+    ASSERT_TRUE(v1 != nullptr);
+
+    for (uint64_t i = 0; i < nclusters; ++i)
+    {
+        checkVolume(*v1, i * csize / lba_size, csize, pattern(i));
+    }
+
+    removeVolumeCompletely(v1);
+}
+
 TEST_P(VolumeBackupTest, backup_backup)
 {
     auto ns1_ptr = make_random_namespace();
@@ -80,6 +80,12 @@ public:
             ("foc-transport",
              po::value<decltype(vdt::FailOverCacheTestSetup::transport_)>(&vdt::FailOverCacheTestSetup::transport_)->default_value(vdt::FailOverCacheTestSetup::transport_),
              "FailOverCache transport (TCP|RSocket)")
+            ("foc-reactor-threads",
+             po::value<decltype(vdt::FailOverCacheTestSetup::reactor_threads_)>(&vdt::FailOverCacheTestSetup::reactor_threads_)->default_value(vdt::FailOverCacheTestSetup::reactor_threads_),
+             "FailOverCache reactor threads (0: thread per connection)")
+            ("foc-log-segment-size",
+             po::value<decltype(vdt::FailOverCacheTestSetup::log_segment_size_)>(&vdt::FailOverCacheTestSetup::log_segment_size_)->default_value(vdt::FailOverCacheTestSetup::log_segment_size_),
+             "FailOverCache log structured backend segment size (0: file per SCO backend)")
             ("mds-port-base",
              po::value<uint16_t>(&vdt::MDSTestSetup::base_port_)->default_value(vdt::MDSTestSetup::base_port_),
              "start of port range to use for MDS")
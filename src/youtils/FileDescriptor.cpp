@@ -22,6 +22,7 @@
 #include <sys/file.h>
 #include <sys/statvfs.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 
 
 #include <sstream>
@@ -213,6 +214,27 @@ FileDescriptor::pwrite(const void* const buf,
     return s;
 }
 
+size_t
+FileDescriptor::pwritev(const struct iovec* iov,
+                        int iovcnt,
+                        off_t pos)
+{
+    ssize_t s;
+
+    do
+    {
+        s = ::pwritev(fd_, iov, iovcnt, pos);
+    }
+    while (s < 0 and errno == EINTR);
+
+    if (s < 0)
+    {
+        throw FileDescriptorException(errno,
+                                    FileDescriptorException::Exception::WriteException);
+    }
+    return s;
+}
+
 off_t
 FileDescriptor::seek(off_t offset,
                      Whence w)
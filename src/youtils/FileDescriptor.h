@@ -22,6 +22,7 @@
 
 VD_BOOLEAN_ENUM(CreateIfNecessary);
 VD_BOOLEAN_ENUM(SyncOnCloseAndDestructor);
+struct iovec;
 struct statvfs;
 struct stat;
 
@@ -130,6 +131,12 @@ public:
            size_t size,
            off_t pos);
 
+    // Might write less than requested, like pwritev(2).
+    size_t
+    pwritev(const struct iovec* iov,
+            int iovcnt,
+            off_t pos);
+
     off_t
     seek(off_t offset,
          Whence w);
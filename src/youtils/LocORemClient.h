@@ -69,6 +69,51 @@ public:
                              conn_);
     }
 
+    // Asynchronous variants for users that drive the io_service themselves
+    // (cf. io_service()), e.g. from a dedicated thread to have a read pending
+    // while sending. `fun' is invoked without arguments on completion, errors
+    // are thrown out of io_service::run().
+    // Only one read and one write may be in flight at any given time.
+    template<typename BufferSequence,
+             typename Fun>
+    void
+    async_send(const BufferSequence& bufs,
+               Fun&& fun)
+    {
+        AsyncSendVisitor<BufferSequence, Fun> v(bufs,
+                                                fun);
+        boost::apply_visitor(v,
+                             conn_);
+    }
+
+    template<typename BufferSequence,
+             typename Fun>
+    void
+    async_recv(const BufferSequence& bufs,
+               Fun&& fun)
+    {
+        AsyncRecvVisitor<BufferSequence, Fun> v(bufs,
+                                                fun);
+        boost::apply_visitor(v,
+                             conn_);
+    }
+
+    // Closes the connection, to be used along with the async variants above:
+    // the outstanding ones complete with an error.
+    void
+    async_close()
+    {
+        AsyncCloseVisitor v;
+        boost::apply_visitor(v,
+                             conn_);
+    }
+
+    boost::asio::io_service&
+    io_service()
+    {
+        return io_service_;
+    }
+
     bool
     is_local() const;
 
@@ -155,6 +200,73 @@ private:
             // LOG_TRACE("io service is done");
         }
     };
+
+    template<typename BufferSequence,
+             typename Fun>
+    struct AsyncRecvVisitor
+        : public boost::static_visitor<>
+    {
+        const BufferSequence& bufs_;
+        Fun& fun_;
+
+        AsyncRecvVisitor(const BufferSequence& bufs,
+                         Fun& fun)
+            : bufs_(bufs)
+            , fun_(fun)
+        {}
+
+        template<typename C>
+        void
+        operator()(const C& conn)
+        {
+            auto f([fun = std::move(fun_)](const C&) mutable
+                   {
+                       fun();
+                   });
+
+            conn->async_read(bufs_,
+                             std::move(f));
+        }
+    };
+
+    template<typename BufferSequence,
+             typename Fun>
+    struct AsyncSendVisitor
+        : public boost::static_visitor<>
+    {
+        const BufferSequence& bufs_;
+        Fun& fun_;
+
+        AsyncSendVisitor(const BufferSequence& bufs,
+                         Fun& fun)
+            : bufs_(bufs)
+            , fun_(fun)
+        {}
+
+        template<typename C>
+        void
+        operator()(const C& conn)
+        {
+            auto f([fun = std::move(fun_)](const C&) mutable
+                   {
+                       fun();
+                   });
+
+            conn->async_write(bufs_,
+                              std::move(f));
+        }
+    };
+
+    struct AsyncCloseVisitor
+        : public boost::static_visitor<>
+    {
+        template<typename C>
+        void
+        operator()(const C& conn)
+        {
+            conn->async_close();
+        }
+    };
 };
 
 }
@@ -216,6 +216,28 @@ public:
         }
     }
 
+    // Closes the socket from within the strand, pending operations then
+    // complete with an error.
+    void
+    async_close()
+    {
+        auto self(this->shared_from_this());
+
+        strand_.post([self, this]
+                     {
+                         LOG_INFO(this << ": closing socket");
+
+                         boost::system::error_code ec;
+                         sock_.close(ec);
+
+                         if (ec)
+                         {
+                             LOG_ERROR(this << ": failed to close socket: " <<
+                                       ec.message() << " - ignoring");
+                         }
+                     });
+    }
+
 private:
     DECLARE_LOGGER("LocORemConnection");
 
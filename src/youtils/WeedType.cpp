@@ -0,0 +1,229 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+#include "Assert.h"
+#include "StreamUtils.h"
+#include "WeedType.h"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/bimap.hpp>
+
+namespace youtils
+{
+
+namespace
+{
+
+DECLARE_LOGGER("WeedTypeUtils");
+
+inline uint64_t
+rotl64(uint64_t x,
+       int8_t r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+inline uint64_t
+fmix64(uint64_t k)
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+// Austin Appleby's MurmurHash3_x64_128 (public domain). Little endian only,
+// as is the rest of the code base.
+void
+murmur3_x64_128(const uint8_t* data,
+                const size_t len,
+                const uint32_t seed,
+                uint8_t* out)
+{
+    const size_t nblocks = len / 16;
+
+    uint64_t h1 = seed;
+    uint64_t h2 = seed;
+
+    const uint64_t c1 = 0x87c37b91114253d5ULL;
+    const uint64_t c2 = 0x4cf5ad432745937fULL;
+
+    for (size_t i = 0; i < nblocks; ++i)
+    {
+        uint64_t k1;
+        uint64_t k2;
+        memcpy(&k1, data + i * 16, sizeof(k1));
+        memcpy(&k2, data + i * 16 + 8, sizeof(k2));
+
+        k1 *= c1;
+        k1 = rotl64(k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+
+        h1 = rotl64(h1, 27);
+        h1 += h2;
+        h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= c2;
+        k2 = rotl64(k2, 33);
+        k2 *= c1;
+        h2 ^= k2;
+
+        h2 = rotl64(h2, 31);
+        h2 += h1;
+        h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    const uint8_t* tail = data + nblocks * 16;
+
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+
+    switch (len & 15)
+    {
+    case 15: k2 ^= static_cast<uint64_t>(tail[14]) << 48; // fall through
+    case 14: k2 ^= static_cast<uint64_t>(tail[13]) << 40; // fall through
+    case 13: k2 ^= static_cast<uint64_t>(tail[12]) << 32; // fall through
+    case 12: k2 ^= static_cast<uint64_t>(tail[11]) << 24; // fall through
+    case 11: k2 ^= static_cast<uint64_t>(tail[10]) << 16; // fall through
+    case 10: k2 ^= static_cast<uint64_t>(tail[9]) << 8; // fall through
+    case 9:
+        k2 ^= static_cast<uint64_t>(tail[8]);
+        k2 *= c2;
+        k2 = rotl64(k2, 33);
+        k2 *= c1;
+        h2 ^= k2;
+        // fall through
+    case 8: k1 ^= static_cast<uint64_t>(tail[7]) << 56; // fall through
+    case 7: k1 ^= static_cast<uint64_t>(tail[6]) << 48; // fall through
+    case 6: k1 ^= static_cast<uint64_t>(tail[5]) << 40; // fall through
+    case 5: k1 ^= static_cast<uint64_t>(tail[4]) << 32; // fall through
+    case 4: k1 ^= static_cast<uint64_t>(tail[3]) << 24; // fall through
+    case 3: k1 ^= static_cast<uint64_t>(tail[2]) << 16; // fall through
+    case 2: k1 ^= static_cast<uint64_t>(tail[1]) << 8; // fall through
+    case 1:
+        k1 ^= static_cast<uint64_t>(tail[0]);
+        k1 *= c1;
+        k1 = rotl64(k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+    }
+
+    h1 ^= len;
+    h2 ^= len;
+
+    h1 += h2;
+    h2 += h1;
+
+    h1 = fmix64(h1);
+    h2 = fmix64(h2);
+
+    h1 += h2;
+    h2 += h1;
+
+    memcpy(out, &h1, sizeof(h1));
+    memcpy(out + sizeof(h1), &h2, sizeof(h2));
+}
+
+static_assert(sizeof(Weed) == 16, "Weed size assumption does not hold");
+
+void
+reminder(WeedType) __attribute__((unused));
+
+void
+reminder(WeedType t)
+{
+    switch (t)
+    {
+    case WeedType::Md5:
+    case WeedType::Murmur3_128:
+        // If the compiler yells at you that you've forgotten dealing with an enum
+        // value here chances are that it's also missing from the translations map
+        // below. If so add it NOW.
+        break;
+    }
+}
+
+using TranslationsMap = boost::bimap<WeedType, std::string>;
+
+TranslationsMap
+init_translations()
+{
+    const std::vector<TranslationsMap::value_type> initv{
+        { WeedType::Md5, "Md5" },
+        { WeedType::Murmur3_128, "Murmur3_128" },
+    };
+
+    return TranslationsMap(initv.begin(),
+                           initv.end());
+}
+
+}
+
+Weed
+make_weed(const WeedType t,
+          const uint8_t* buf,
+          const size_t size)
+{
+    switch (t)
+    {
+    case WeedType::Md5:
+        return Weed(buf,
+                    size);
+    case WeedType::Murmur3_128:
+        {
+            Weed w;
+            murmur3_x64_128(buf,
+                            size,
+                            0,
+                            w.bytes());
+            return w;
+        }
+    }
+
+    VERIFY(0 == "unknown WeedType");
+}
+
+std::ostream&
+operator<<(std::ostream& os,
+           const WeedType t)
+{
+    static const TranslationsMap translations(init_translations());
+    return StreamUtils::stream_out(translations.left,
+                                   os,
+                                   t);
+}
+
+std::istream&
+operator>>(std::istream& is,
+           WeedType& t)
+{
+    static const TranslationsMap translations(init_translations());
+    return StreamUtils::stream_in(translations.right,
+                                  is,
+                                  t);
+}
+
+}
+
+// Local Variables: **
+// mode: c++ **
+// End: **
@@ -0,0 +1,59 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+#ifndef YT_WEED_TYPE_H_
+#define YT_WEED_TYPE_H_
+
+#include "Md5.h"
+
+#include <iosfwd>
+#include <cstdint>
+
+namespace youtils
+{
+
+// Algorithms to compute content Weeds (e.g. the ContentBased cluster cache
+// keys) with. All of them produce 16 byte digests, so Weeds computed with
+// either fit into the same (serialized) slots - they just won't match each
+// other. The values are persisted and must not be changed.
+enum class WeedType : uint8_t
+{
+    Md5 = 0,
+    // MurmurHash3_x64_128, seed 0: an order of magnitude faster than MD5 but
+    // non-cryptographic. Colliding inputs can be crafted regardless of the
+    // seed, so only use it where all writers sharing the Weeds are trusted.
+    Murmur3_128 = 1,
+};
+
+Weed
+make_weed(const WeedType,
+          const uint8_t* buf,
+          const size_t size);
+
+std::ostream&
+operator<<(std::ostream&,
+           const WeedType);
+
+std::istream&
+operator>>(std::istream&,
+           WeedType&);
+
+}
+
+#endif // !YT_WEED_TYPE_H_
+
+// Local Variables: **
+// mode: c++ **
+// End: **
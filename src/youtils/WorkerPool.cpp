@@ -0,0 +1,199 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+#include "Assert.h"
+#include "Catchers.h"
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+#include <boost/bind.hpp>
+
+namespace youtils
+{
+
+namespace
+{
+
+// Shared with the pool threads, which might only get to it after the caller
+// of for_each_index returned. `fun' must not be touched once `closed' is set.
+struct ForEachIndex
+{
+    ForEachIndex(size_t c,
+                 const std::function<void(size_t)>& f)
+        : count(c)
+        , fun(f)
+        , next(0)
+        , active(0)
+        , closed(false)
+    {}
+
+    const size_t count;
+    const std::function<void(size_t)>& fun;
+    std::atomic<size_t> next;
+
+    boost::mutex lock;
+    boost::condition_variable cond;
+    size_t active;
+    bool closed;
+    std::exception_ptr eptr;
+
+    void
+    work()
+    {
+        try
+        {
+            for (size_t i = next++; i < count; i = next++)
+            {
+                fun(i);
+            }
+        }
+        catch (...)
+        {
+            // make the others bail out early
+            next = count;
+
+            boost::lock_guard<decltype(lock)> g(lock);
+            if (not eptr)
+            {
+                eptr = std::current_exception();
+            }
+        }
+    }
+};
+
+}
+
+WorkerPool::WorkerPool(const std::string& name,
+                       size_t nthreads)
+    : work_(std::make_unique<boost::asio::io_service::work>(io_service_))
+    , name_(name)
+{
+    try
+    {
+        for (size_t i = 0; i < nthreads; ++i)
+        {
+            threads_.create_thread(boost::bind(&WorkerPool::run_,
+                                               this));
+        }
+
+        LOG_INFO(name_ << ": started " << nthreads << " threads");
+    }
+    CATCH_STD_ALL_EWHAT({
+            LOG_ERROR(name_ << ": failed to create worker pool: " << EWHAT);
+            stop_();
+            throw;
+        });
+}
+
+WorkerPool::~WorkerPool()
+{
+    try
+    {
+        stop_();
+    }
+    CATCH_STD_ALL_LOG_IGNORE(name_ << ": failed to stop");
+}
+
+void
+WorkerPool::stop_()
+{
+    LOG_INFO(name_ << ": stopping");
+    work_.reset();
+    io_service_.stop();
+    threads_.join_all();
+}
+
+void
+WorkerPool::run_()
+{
+    while (true)
+    {
+        try
+        {
+            io_service_.run();
+            return;
+        }
+        CATCH_STD_ALL_LOG_IGNORE(name_ << ": caught exception in worker thread");
+    }
+}
+
+void
+WorkerPool::for_each_index(size_t count,
+                           size_t max_workers,
+                           const std::function<void(size_t)>& fun)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    auto state(std::make_shared<ForEachIndex>(count,
+                                              fun));
+
+    const size_t helpers = std::min<size_t>(std::min<size_t>(max_workers,
+                                                             count),
+                                            size() + 1) - 1;
+
+    for (size_t i = 0; i < helpers; ++i)
+    {
+        io_service_.post([state]
+                         {
+                             {
+                                 boost::lock_guard<decltype(state->lock)> g(state->lock);
+                                 if (state->closed)
+                                 {
+                                     return;
+                                 }
+                                 ++state->active;
+                             }
+
+                             state->work();
+
+                             boost::lock_guard<decltype(state->lock)> g(state->lock);
+                             if (--state->active == 0)
+                             {
+                                 state->cond.notify_all();
+                             }
+                         });
+    }
+
+    state->work();
+
+    // The helpers might still be using `fun', so don't let a
+    // boost::thread_interrupted get us out of here early.
+    boost::this_thread::disable_interruption di;
+
+    boost::unique_lock<decltype(state->lock)> u(state->lock);
+    state->closed = true;
+    state->cond.wait(u,
+                     [&]() -> bool
+                     {
+                         return state->active == 0;
+                     });
+
+    if (state->eptr)
+    {
+        std::rethrow_exception(state->eptr);
+    }
+}
+
+}
+
+// Local Variables: **
+// mode: c++ **
+// End: **
@@ -0,0 +1,87 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+
+
+#ifndef YT_WORKER_POOL_H_
+#define YT_WORKER_POOL_H_
+
+#include "Logging.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <boost/asio.hpp>
+#include <boost/thread.hpp>
+
+namespace youtils
+{
+
+// A fixed number of threads to spread independent pieces of work over, so the
+// number of threads stays bounded no matter how many callers want to do
+// things in parallel.
+class WorkerPool
+{
+public:
+    // nthreads == 0 is allowed - all work is then done by the callers.
+    WorkerPool(const std::string& name,
+               size_t nthreads);
+
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+
+    WorkerPool&
+    operator=(const WorkerPool&) = delete;
+
+    size_t
+    size() const
+    {
+        return threads_.size();
+    }
+
+    // Calls fun(i) for every i in [0, count) from the calling thread and up to
+    // max_workers - 1 pool threads, which all pick the indices off a shared
+    // counter. Pool threads only join in if they're available before the
+    // caller ran out of work, so a busy pool does not delay the caller.
+    // The first exception makes the others bail out early and is rethrown
+    // once all workers are done.
+    void
+    for_each_index(size_t count,
+                   size_t max_workers,
+                   const std::function<void(size_t)>& fun);
+
+private:
+    DECLARE_LOGGER("WorkerPool");
+
+    boost::asio::io_service io_service_;
+    std::unique_ptr<boost::asio::io_service::work> work_;
+    boost::thread_group threads_;
+    const std::string name_;
+
+    void
+    run_();
+
+    void
+    stop_();
+};
+
+}
+
+#endif // !YT_WORKER_POOL_H_
+
+// Local Variables: **
+// mode: c++ **
+// End: **
@@ -17,6 +17,7 @@
 #include "../System.h"
 #include <../wall_timer.h>
 #include "../Md5.h"
+#include "../WeedType.h"
 
 #include <fstream>
 #include <sstream>
@@ -257,6 +258,48 @@ TEST_F(WeedTest, from_stream_bigger)
               Weed(ss));
 }
 
+TEST_F(WeedTest, weed_types)
+{
+    const std::string s("The quick brown fox jumps over the lazy dog");
+    const uint8_t* buf = reinterpret_cast<const uint8_t*>(s.data());
+
+    EXPECT_EQ(Weed(buf, s.size()),
+              make_weed(WeedType::Md5, buf, s.size()));
+
+    // reference value of MurmurHash3_x64_128 with seed 0
+    EXPECT_EQ(Weed("6c1b07bc7bbc4be347939ac4a93c437a"),
+              make_weed(WeedType::Murmur3_128, buf, s.size()));
+
+    EXPECT_EQ(Weed::null(),
+              make_weed(WeedType::Murmur3_128, buf, 0));
+
+    // all tail lengths
+    std::vector<uint8_t> v(4096 + 15);
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+        v[i] = i;
+    }
+
+    for (size_t i = 4096; i < v.size(); ++i)
+    {
+        EXPECT_NE(make_weed(WeedType::Murmur3_128, v.data(), i),
+                  make_weed(WeedType::Murmur3_128, v.data(), i + 1));
+    }
+
+    EXPECT_NE(make_weed(WeedType::Md5, v.data(), 4096),
+              make_weed(WeedType::Murmur3_128, v.data(), 4096));
+
+    for (const auto t : { WeedType::Md5,
+                          WeedType::Murmur3_128 })
+    {
+        std::stringstream ss;
+        ss << t;
+        WeedType u;
+        ss >> u;
+        EXPECT_EQ(t, u);
+    }
+}
+
 }
 // Local Variables: **
 // End: **
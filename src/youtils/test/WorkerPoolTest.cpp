@@ -0,0 +1,126 @@
+// Copyright (C) 2016 iNuron NV
+//
+// This file is part of Open vStorage Open Source Edition (OSE),
+// as available from
+//
+//      http://www.openvstorage.org and
+//      http://www.openvstorage.com.
+//
+// This file is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License v3 (GNU AGPLv3)
+// as published by the Free Software Foundation, in version 3 as it comes in
+// the LICENSE.txt file of the Open vStorage OSE distribution.
+// Open vStorage is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY of any kind.
+#include "../Logging.h"
+
+#include "../WorkerPool.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace youtilstest
+{
+
+using namespace youtils;
+
+class WorkerPoolTest
+    : public testing::Test
+{
+protected:
+    DECLARE_LOGGER("WorkerPoolTest");
+
+    const size_t nthreads_ = 4;
+};
+
+TEST_F(WorkerPoolTest, start_n_stop)
+{
+    WorkerPool pool("TestPool",
+                    nthreads_);
+    EXPECT_EQ(nthreads_,
+              pool.size());
+}
+
+TEST_F(WorkerPoolTest, for_each_index)
+{
+    for (size_t n : { size_t(0), nthreads_ })
+    {
+        WorkerPool pool("TestPool",
+                        n);
+
+        const size_t count = 1000;
+        std::vector<std::atomic<size_t>> visits(count);
+        for (auto& v : visits)
+        {
+            v = 0;
+        }
+
+        std::atomic<size_t> active(0);
+        std::atomic<size_t> max_active(0);
+        const size_t max_workers = 3;
+
+        pool.for_each_index(count,
+                            max_workers,
+                            [&](size_t i)
+                            {
+                                const size_t a = ++active;
+                                size_t m = max_active;
+                                while (a > m and
+                                       not max_active.compare_exchange_weak(m, a))
+                                {}
+
+                                ++visits[i];
+                                --active;
+                            });
+
+        for (const auto& v : visits)
+        {
+            EXPECT_EQ(1U, v);
+        }
+
+        EXPECT_LE(max_active, std::min(max_workers, n + 1));
+    }
+}
+
+TEST_F(WorkerPoolTest, errors)
+{
+    WorkerPool pool("TestPool",
+                    nthreads_);
+
+    const size_t count = 100;
+    std::atomic<size_t> calls(0);
+
+    EXPECT_THROW(pool.for_each_index(count,
+                                     nthreads_ + 1,
+                                     [&](size_t i)
+                                     {
+                                         ++calls;
+                                         if (i == 7)
+                                         {
+                                             throw std::runtime_error("nope");
+                                         }
+                                     }),
+                 std::runtime_error);
+
+    EXPECT_GE(calls, 8U);
+
+    // the pool is still usable afterwards
+    calls = 0;
+    pool.for_each_index(count,
+                        nthreads_ + 1,
+                        [&](size_t)
+                        {
+                            ++calls;
+                        });
+
+    EXPECT_EQ(count, calls);
+}
+
+}
+
+// Local Variables: **
+// mode: c++ **
+// End: **